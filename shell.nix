@@ -16,6 +16,7 @@ in pkgs.mkShell.override { stdenv = quickshell.stdenv; } {
 
   nativeBuildInputs = with pkgs; [
     just
+    jq
     clang-tools
     parallel
     makeWrapper
@@ -1,12 +1,19 @@
 #include "bluez.hpp"
+#include <algorithm>
+#include <utility>
 
 #include <qcontainerfwd.h>
 #include <qdbusconnection.h>
 #include <qdbusextratypes.h>
+#include <qhash.h>
+#include <qlist.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
+#include <qproperty.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "../core/logcat.hpp"
 #include "../dbus/dbus_objectmanager_types.hpp"
@@ -25,7 +32,19 @@ Bluez* Bluez::instance() {
 	return instance;
 }
 
-Bluez::Bluez() { this->init(); }
+Bluez::Bluez() {
+	this->discoveryUpdateTimer.setSingleShot(true);
+	this->discoveryUpdateTimer.setInterval(250);
+
+	QObject::connect(
+	    &this->discoveryUpdateTimer,
+	    &QTimer::timeout,
+	    this,
+	    &Bluez::flushDiscoveryUpdates
+	);
+
+	this->init();
+}
 
 void Bluez::updateDefaultAdapter() {
 	const auto& adapters = this->mAdapters.valueList();
@@ -117,16 +136,81 @@ void Bluez::onInterfacesAdded(
 			device->addInterface(interface, properties);
 		}
 
+		this->mDeviceMap.insert(path.path(), device);
+
+		if (this->discoveryUpdateTimer.interval() != 0 && this->isDiscovering()) {
+			this->pendingDevices.append(device);
+			if (!this->discoveryUpdateTimer.isActive()) this->discoveryUpdateTimer.start();
+			return;
+		}
+
+		// Volatile properties from the initial property set are applied before the device is listed.
+		this->volatileDevices.remove(device);
+		device->applyVolatileUpdates();
+
 		if (auto* adapter = device->adapter()) {
 			adapter->devices()->insertObject(device);
 			qCDebug(logBluetooth) << "Added device" << device << "to adapter" << adapter;
 		}
 
-		this->mDeviceMap.insert(path.path(), device);
 		this->mDevices.insertObject(device);
 	}
 }
 
+bool Bluez::isDiscovering() const {
+	return std::ranges::any_of(this->mAdapters.valueList(), [](BluetoothAdapter* adapter) {
+		return adapter->discovering();
+	});
+}
+
+void Bluez::setDiscoveryUpdateInterval(qint32 interval) {
+	interval = std::max(interval, 0);
+	if (interval == this->discoveryUpdateTimer.interval()) return;
+
+	this->discoveryUpdateTimer.setInterval(interval);
+
+	if (interval == 0) {
+		this->discoveryUpdateTimer.stop();
+		this->flushDiscoveryUpdates();
+	}
+
+	emit this->discoveryUpdateIntervalChanged();
+}
+
+void Bluez::queueVolatileUpdate(BluetoothDevice* device) {
+	if (this->discoveryUpdateTimer.interval() == 0) {
+		device->applyVolatileUpdates();
+		return;
+	}
+
+	this->volatileDevices.insert(device);
+	if (!this->discoveryUpdateTimer.isActive()) this->discoveryUpdateTimer.start();
+}
+
+void Bluez::flushDiscoveryUpdates() {
+	auto devices = std::exchange(this->pendingDevices, {});
+	auto volatileDevices = std::exchange(this->volatileDevices, {});
+
+	Qt::beginPropertyUpdateGroup();
+	for (auto* device: volatileDevices) device->applyVolatileUpdates();
+	Qt::endPropertyUpdateGroup();
+
+	if (devices.isEmpty()) return;
+
+	auto adapterDevices = QHash<BluetoothAdapter*, QList<BluetoothDevice*>>();
+
+	for (auto* device: devices) {
+		if (auto* adapter = device->adapter()) adapterDevices[adapter].append(device);
+	}
+
+	for (const auto& [adapter, list]: adapterDevices.asKeyValueRange()) {
+		adapter->devices()->insertObjects(list);
+	}
+
+	this->mDevices.insertObjects(devices);
+	qCDebug(logBluetooth) << "Added" << devices.length() << "discovered devices";
+}
+
 void Bluez::onInterfacesRemoved(const QDBusObjectPath& path, const QStringList& interfaces) {
 	if (auto* adapter = this->mAdapterMap.value(path.path())) {
 		if (interfaces.contains("org.bluez.Adapter1")) {
@@ -147,6 +231,8 @@ void Bluez::onInterfacesRemoved(const QDBusObjectPath& path, const QStringList&
 
 			this->mDeviceMap.remove(path.path());
 			this->mDevices.removeObject(device);
+			this->pendingDevices.removeOne(device);
+			this->volatileDevices.remove(device);
 			delete device;
 		} else {
 			for (const auto& interface: interfaces) {
@@ -163,6 +249,13 @@ BluezQml::BluezQml() {
 	    this,
 	    &BluezQml::defaultAdapterChanged
 	);
+
+	QObject::connect(
+	    Bluez::instance(),
+	    &Bluez::discoveryUpdateIntervalChanged,
+	    this,
+	    &BluezQml::discoveryUpdateIntervalChanged
+	);
 }
 
 } // namespace qs::bluetooth
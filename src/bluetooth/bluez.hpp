@@ -2,10 +2,14 @@
 
 #include <qcontainerfwd.h>
 #include <qhash.h>
+#include <qlist.h>
 #include <qobject.h>
 #include <qproperty.h>
 #include <qqmlintegration.h>
+#include <qset.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "../core/doc.hpp"
 #include "../core/model.hpp"
@@ -30,22 +34,40 @@ public:
 
 	static Bluez* instance();
 
+	[[nodiscard]] qint32 discoveryUpdateInterval() const {
+		return this->discoveryUpdateTimer.interval();
+	}
+
+	void setDiscoveryUpdateInterval(qint32 interval);
+
+	// Applies the device's volatile properties on the next discovery update,
+	// or immediately if updates are not batched.
+	void queueVolatileUpdate(BluetoothDevice* device);
+
 signals:
 	void defaultAdapterChanged();
+	void discoveryUpdateIntervalChanged();
 
 private slots:
 	void
 	onInterfacesAdded(const QDBusObjectPath& path, const DBusObjectManagerInterfaces& interfaces);
 	void onInterfacesRemoved(const QDBusObjectPath& path, const QStringList& interfaces);
 	void updateDefaultAdapter();
+	void flushDiscoveryUpdates();
 
 private:
 	explicit Bluez();
 	void init();
+	[[nodiscard]] bool isDiscovering() const;
 
 	qs::dbus::DBusObjectManager* objectManager = nullptr;
 	QHash<QString, BluetoothAdapter*> mAdapterMap;
 	QHash<QString, BluetoothDevice*> mDeviceMap;
+
+	// Devices found while discovering, added to the device lists on the next update.
+	QList<BluetoothDevice*> pendingDevices;
+	QSet<BluetoothDevice*> volatileDevices;
+	QTimer discoveryUpdateTimer;
 	ObjectModel<BluetoothAdapter> mAdapters {this};
 	ObjectModel<BluetoothDevice> mDevices {this};
 
@@ -74,10 +96,20 @@ class BluezQml: public QObject {
 	/// A list of all connected bluetooth devices across all adapters.
 	/// See @@BluetoothAdapter.devices for the devices connected to a single adapter.
 	Q_PROPERTY(UntypedObjectModel* devices READ devices CONSTANT);
+	/// The minimum time in milliseconds between updates to the device lists and to frequently
+	/// changing device properties such as @@BluetoothDevice.rssi. Defaults to 250.
+	///
+	/// While an adapter is discovering, nearby devices are reported in quick succession.
+	/// Devices found within this interval are added to the device lists together, so lists
+	/// of nearby devices are not re-sorted for every device.
+	///
+	/// Setting this to 0 applies all updates immediately.
+	Q_PROPERTY(qint32 discoveryUpdateInterval READ discoveryUpdateInterval WRITE setDiscoveryUpdateInterval NOTIFY discoveryUpdateIntervalChanged);
 	// clang-format on
 
 signals:
 	void defaultAdapterChanged();
+	void discoveryUpdateIntervalChanged();
 
 public:
 	explicit BluezQml();
@@ -93,6 +125,14 @@ public:
 	[[nodiscard]] static QBindable<BluetoothAdapter*> bindableDefaultAdapter() {
 		return &Bluez::instance()->bDefaultAdapter;
 	}
+
+	[[nodiscard]] static qint32 discoveryUpdateInterval() {
+		return Bluez::instance()->discoveryUpdateInterval();
+	}
+
+	static void setDiscoveryUpdateInterval(qint32 interval) {
+		Bluez::instance()->setDiscoveryUpdateInterval(interval);
+	}
 };
 
 } // namespace qs::bluetooth
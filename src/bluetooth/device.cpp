@@ -275,6 +275,10 @@ void BluetoothDevice::addInterface(const QString& interface, const QVariantMap&
 	}
 }
 
+void BluetoothDevice::onRssiReceived() { Bluez::instance()->queueVolatileUpdate(this); }
+
+void BluetoothDevice::applyVolatileUpdates() { this->bRssi = this->bReceivedRssi.value(); }
+
 void BluetoothDevice::removeInterface(const QString& interface) {
 	if (interface == "org.bluez.Battery1" && this->mBatteryInterface) {
 		this->batteryProperties.setInterface(nullptr);
@@ -99,6 +99,11 @@ class BluetoothDevice: public QObject {
 	Q_PROPERTY(bool batteryAvailable READ batteryAvailable NOTIFY batteryAvailableChanged);
 	/// Battery level of the connected device, from `0.0` to `1.0`. Only valid if @@batteryAvailable is true.
 	Q_PROPERTY(qreal battery READ default NOTIFY batteryChanged BINDABLE bindableBattery);
+	/// Signal strength of the device in dBm as of the last discovery, or 0 if unknown
+	/// or the device is out of range.
+	///
+	/// Updates are combined and applied at most once per @@Bluetooth.discoveryUpdateInterval.
+	Q_PROPERTY(qint16 rssi READ default NOTIFY rssiChanged BINDABLE bindableRssi);
 	/// The Bluetooth adapter this device belongs to.
 	Q_PROPERTY(BluetoothAdapter* adapter READ adapter NOTIFY adapterChanged);
 	/// DBus path of the device under the `org.bluez` system service.
@@ -159,10 +164,14 @@ public:
 	[[nodiscard]] QBindable<QString> bindableIcon() { return &this->bIcon; }
 	[[nodiscard]] QBindable<qreal> bindableBattery() { return &this->bBattery; }
 	[[nodiscard]] QBindable<BluetoothDeviceState::Enum> bindableState() { return &this->bState; }
+	[[nodiscard]] QBindable<qint16> bindableRssi() { return &this->bRssi; }
 
 	void addInterface(const QString& interface, const QVariantMap& properties);
 	void removeInterface(const QString& interface);
 
+	// Applies received values of frequently changing properties. See Bluez::queueVolatileUpdate.
+	void applyVolatileUpdates();
+
 signals:
 	void addressChanged();
 	void deviceNameChanged();
@@ -179,9 +188,11 @@ signals:
 	void batteryAvailableChanged();
 	void batteryChanged();
 	void adapterChanged();
+	void rssiChanged();
 
 private:
 	void onConnectedChanged();
+	void onRssiReceived();
 
 	DBusBluezDeviceInterface* mInterface = nullptr;
 	QDBusInterface* mBatteryInterface = nullptr;
@@ -201,6 +212,8 @@ private:
 	Q_OBJECT_BINDABLE_PROPERTY(BluetoothDevice, qreal, bBattery, &BluetoothDevice::batteryChanged);
 	Q_OBJECT_BINDABLE_PROPERTY(BluetoothDevice, BluetoothDeviceState::Enum, bState, &BluetoothDevice::stateChanged);
 	Q_OBJECT_BINDABLE_PROPERTY(BluetoothDevice, bool, bPairing, &BluetoothDevice::pairingChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(BluetoothDevice, qint16, bRssi, &BluetoothDevice::rssiChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(BluetoothDevice, qint16, bReceivedRssi, &BluetoothDevice::onRssiReceived);
 
 	QS_DBUS_BINDABLE_PROPERTY_GROUP(BluetoothDevice, properties);
 	QS_DBUS_PROPERTY_BINDING(BluetoothDevice, pAddress, bAddress, properties, "Address");
@@ -214,6 +227,7 @@ private:
 	QS_DBUS_PROPERTY_BINDING(BluetoothDevice, pWakeAllowed, bWakeAllowed, properties, "WakeAllowed");
 	QS_DBUS_PROPERTY_BINDING(BluetoothDevice, pIcon, bIcon, properties, "Icon");
 	QS_DBUS_PROPERTY_BINDING(BluetoothDevice, pAdapterPath, bAdapterPath, properties, "Adapter");
+	QS_DBUS_PROPERTY_BINDING(BluetoothDevice, pRssi, bReceivedRssi, properties, "RSSI", false);
 
 	QS_DBUS_BINDABLE_PROPERTY_GROUP(BluetoothDevice, batteryProperties);
 	QS_DBUS_PROPERTY_BINDING(BluetoothDevice, BatteryPercentage, pBattery, bBattery, batteryProperties, "Percentage", true);
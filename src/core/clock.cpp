@@ -1,14 +1,20 @@
 #include "clock.hpp"
+#include <algorithm>
 
 #include <qdatetime.h>
+#include <qmetaobject.h>
+#include <qnamespace.h>
 #include <qobject.h>
 #include <qtimer.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
 SystemClock::SystemClock(QObject* parent): QObject(parent) {
-	QObject::connect(&this->timer, &QTimer::timeout, this, &SystemClock::onTimeout);
-	this->update();
+	this->currentTime = SystemClockDriver::truncate(QDateTime::currentDateTime(), this->mPrecision);
+}
+
+SystemClock::~SystemClock() {
+	if (this->active) SystemClockDriver::instance()->setActive(this, false);
 }
 
 bool SystemClock::enabled() const { return this->mEnabled; }
@@ -29,60 +35,137 @@ void SystemClock::setPrecision(SystemClock::Enum precision) {
 	this->update();
 }
 
-void SystemClock::onTimeout() {
-	this->setTime(this->targetTime);
-	this->schedule(this->targetTime);
+QDateTime SystemClock::date() const {
+	// Nothing is listening for updates, so the time is read on demand instead.
+	if (this->mEnabled && !this->active) {
+		this->currentTime = SystemClockDriver::truncate(QDateTime::currentDateTime(), this->mPrecision);
+	}
+
+	return this->currentTime;
 }
 
-void SystemClock::update() {
-	if (this->mEnabled) {
-		this->setTime(QDateTime::fromMSecsSinceEpoch(0));
-		this->schedule(QDateTime::fromMSecsSinceEpoch(0));
-	} else {
-		this->timer.stop();
+void SystemClock::connectNotify(const QMetaMethod& signal) {
+	if (signal == QMetaMethod::fromSignal(&SystemClock::dateChanged)) {
+		this->dateReceivers++;
+		this->update();
+	}
+}
+
+void SystemClock::disconnectNotify(const QMetaMethod& signal) {
+	if (signal == QMetaMethod::fromSignal(&SystemClock::dateChanged)) {
+		if (this->dateReceivers > 0) this->dateReceivers--;
+		this->update();
 	}
 }
 
-void SystemClock::setTime(const QDateTime& targetTime) {
-	auto currentTime = QDateTime::currentDateTime();
-	auto offset = currentTime.msecsTo(targetTime);
-	this->currentTime = offset > -500 && offset < 500 ? targetTime : currentTime;
+void SystemClock::update() {
+	auto active = this->mEnabled && this->dateReceivers > 0;
 
-	auto time = this->currentTime.time();
-	this->currentTime.setTime(QTime(
-	    this->mPrecision >= SystemClock::Hours ? time.hour() : 0,
-	    this->mPrecision >= SystemClock::Minutes ? time.minute() : 0,
-	    this->mPrecision >= SystemClock::Seconds ? time.second() : 0
-	));
+	// Also reactivated when already active, to pick up precision changes.
+	if (active || this->active) SystemClockDriver::instance()->setActive(this, active);
+	this->active = active;
+}
 
+void SystemClock::setTime(const QDateTime& time) {
+	if (time == this->currentTime) return;
+	this->currentTime = time;
 	emit this->dateChanged();
 }
 
-void SystemClock::schedule(const QDateTime& targetTime) {
-	auto secondPrecision = this->mPrecision >= SystemClock::Seconds;
-	auto minutePrecision = this->mPrecision >= SystemClock::Minutes;
-	auto hourPrecision = this->mPrecision >= SystemClock::Hours;
-
-	auto currentTime = QDateTime::currentDateTime();
+SystemClockDriver::SystemClockDriver() {
+	this->timer.setSingleShot(true);
+	this->timer.setTimerType(Qt::PreciseTimer);
+	QObject::connect(&this->timer, &QTimer::timeout, this, &SystemClockDriver::onTimeout);
+}
 
-	auto offset = currentTime.msecsTo(targetTime);
+SystemClockDriver* SystemClockDriver::instance() {
+	static auto* instance = new SystemClockDriver(); // NOLINT
+	return instance;
+}
 
-	// timer skew
-	auto nextTime = offset > 0 && offset < 500 ? targetTime : currentTime;
+QDateTime SystemClockDriver::truncate(const QDateTime& time, SystemClock::Enum precision) {
+	auto truncated = time;
+	auto t = time.time();
 
-	auto baseTimeT = nextTime.time();
-	nextTime.setTime(QTime(
-	    hourPrecision ? baseTimeT.hour() : 0,
-	    minutePrecision ? baseTimeT.minute() : 0,
-	    secondPrecision ? baseTimeT.second() : 0
+	truncated.setTime(QTime(
+	    precision >= SystemClock::Hours ? t.hour() : 0,
+	    precision >= SystemClock::Minutes ? t.minute() : 0,
+	    precision >= SystemClock::Seconds ? t.second() : 0
 	));
 
-	if (secondPrecision) nextTime = nextTime.addSecs(1);
-	else if (minutePrecision) nextTime = nextTime.addSecs(60);
-	else if (hourPrecision) nextTime = nextTime.addSecs(3600);
+	return truncated;
+}
+
+void SystemClockDriver::setActive(SystemClock* clock, bool active) {
+	if (active) {
+		if (!this->clocks.contains(clock)) {
+			this->clocks.insert(clock);
+
+			QObject::connect(
+			    clock,
+			    &QObject::destroyed,
+			    this,
+			    &SystemClockDriver::onClockDestroyed,
+			    Qt::UniqueConnection
+			);
+		}
+
+		auto now = QDateTime::currentDateTime();
+		clock->setTime(SystemClockDriver::truncate(now, clock->mPrecision));
+		this->schedule(now);
+	} else {
+		if (!this->clocks.remove(clock)) return;
+		QObject::disconnect(clock, nullptr, this, nullptr);
 
-	auto delay = currentTime.msecsTo(nextTime);
+		// A lower precision is picked up on the next wake.
+		if (this->clocks.isEmpty()) this->timer.stop();
+	}
+}
+
+void SystemClockDriver::onTimeout() {
+	auto now = QDateTime::currentDateTime();
+
+	// The timer may fire slightly before the boundary it was scheduled for.
+	auto offset = now.msecsTo(this->targetTime);
+	if (offset > 0 && offset < 500) now = this->targetTime;
+
+	// clocks may deactivate in response to the signal
+	auto clocks = this->clocks;
+
+	for (auto* clock: clocks) {
+		if (!this->clocks.contains(clock)) continue;
+		clock->setTime(SystemClockDriver::truncate(now, clock->mPrecision));
+	}
+
+	this->schedule(now);
+}
+
+void SystemClockDriver::schedule(const QDateTime& now) {
+	if (this->clocks.isEmpty()) {
+		this->timer.stop();
+		return;
+	}
+
+	auto precision = SystemClock::Hours;
+	for (auto* clock: this->clocks) precision = std::max(precision, clock->mPrecision);
+
+	auto next = SystemClockDriver::truncate(now, precision);
+
+	switch (precision) {
+	case SystemClock::Seconds: next = next.addSecs(1); break;
+	case SystemClock::Minutes: next = next.addSecs(60); break;
+	case SystemClock::Hours: next = next.addSecs(3600); break;
+	}
+
+	// now may be snapped forward to the last boundary, so the delay is taken from the real time.
+	auto delay = next.toMSecsSinceEpoch() - QDateTime::currentMSecsSinceEpoch();
+
+	this->timer.start(static_cast<qint32>(std::max(delay, static_cast<qint64>(0))));
+	this->targetTime = next;
+}
 
-	this->timer.start(static_cast<qint32>(delay));
-	this->targetTime = nextTime;
+void SystemClockDriver::onClockDestroyed(QObject* object) {
+	// NOLINTNEXTLINE (the clock is only used as a key)
+	this->clocks.remove(static_cast<SystemClock*>(object));
+	if (this->clocks.isEmpty()) this->timer.stop();
 }
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <qdatetime.h>
+#include <qmetaobject.h>
 #include <qobject.h>
 #include <qqmlintegration.h>
+#include <qset.h>
+#include <qtclasshelpermacros.h>
 #include <qtimer.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
@@ -11,6 +14,9 @@
 /// SystemClock is a view into the system's clock.
 /// It updates at hour, minute, or second intervals depending on @@precision.
 ///
+/// All clocks share a single timer aligned to the system clock, which only runs while
+/// an enabled clock is in use.
+///
 /// # Examples
 /// ```qml
 /// SystemClock {
@@ -58,6 +64,8 @@ public:
 	Q_ENUM(Enum);
 
 	explicit SystemClock(QObject* parent = nullptr);
+	~SystemClock() override;
+	Q_DISABLE_COPY_MOVE(SystemClock);
 
 	[[nodiscard]] bool enabled() const;
 	void setEnabled(bool enabled);
@@ -65,27 +73,59 @@ public:
 	[[nodiscard]] SystemClock::Enum precision() const;
 	void setPrecision(SystemClock::Enum precision);
 
-	[[nodiscard]] QDateTime date() const { return this->currentTime; }
-	[[nodiscard]] quint32 hours() const { return this->currentTime.time().hour(); }
-	[[nodiscard]] quint32 minutes() const { return this->currentTime.time().minute(); }
-	[[nodiscard]] quint32 seconds() const { return this->currentTime.time().second(); }
+	[[nodiscard]] QDateTime date() const;
+	[[nodiscard]] quint32 hours() const { return this->date().time().hour(); }
+	[[nodiscard]] quint32 minutes() const { return this->date().time().minute(); }
+	[[nodiscard]] quint32 seconds() const { return this->date().time().second(); }
 
 signals:
 	void enabledChanged();
 	void precisionChanged();
 	void dateChanged();
 
-private slots:
-	void onTimeout();
+protected:
+	void connectNotify(const QMetaMethod& signal) override;
+	void disconnectNotify(const QMetaMethod& signal) override;
 
 private:
+	void update();
+	void setTime(const QDateTime& time);
+
 	bool mEnabled = true;
+	bool active = false;
+	qsizetype dateReceivers = 0;
 	SystemClock::Enum mPrecision = SystemClock::Seconds;
+	// Refreshed on read while no clock updates are delivered.
+	mutable QDateTime currentTime;
+
+	friend class SystemClockDriver;
+};
+
+// Drives every SystemClock which is enabled and in use from a single timer.
+//
+// The timer wakes once per boundary of the highest precision in use, reads the
+// local time once, and hands it to every clock truncated to its precision.
+class SystemClockDriver: public QObject {
+	Q_OBJECT;
+
+public:
+	static SystemClockDriver* instance();
+
+	// Activating an already active clock refreshes it, for precision changes.
+	void setActive(SystemClock* clock, bool active);
+
+	[[nodiscard]] static QDateTime truncate(const QDateTime& time, SystemClock::Enum precision);
+
+private slots:
+	void onTimeout();
+	void onClockDestroyed(QObject* object);
+
+private:
+	explicit SystemClockDriver();
+
+	void schedule(const QDateTime& now);
+
 	QTimer timer;
-	QDateTime currentTime;
+	QSet<SystemClock*> clocks;
 	QDateTime targetTime;
-
-	void update();
-	void setTime(const QDateTime& targetTime);
-	void schedule(const QDateTime& targetTime);
 };
@@ -2,15 +2,15 @@
 
 #include <qdir.h>
 #include <qfileinfo.h>
-#include <qfilesystemwatcher.h>
 #include <qobject.h>
 #include <qstring.h>
 #include <qtmetamacros.h>
 
 #include "desktopentry.hpp"
+#include "filewatch.hpp"
 
 namespace {
-void addPathAndParents(QFileSystemWatcher& watcher, const QString& path) {
+void addPathAndParents(FileWatch& watcher, const QString& path) {
 	watcher.addPath(path);
 
 	auto p = QFileInfo(path).absolutePath();
@@ -24,18 +24,11 @@ void addPathAndParents(QFileSystemWatcher& watcher, const QString& path) {
 } // namespace
 
 DesktopEntryMonitor::DesktopEntryMonitor(QObject* parent): QObject(parent) {
-	this->debounceTimer.setSingleShot(true);
-	this->debounceTimer.setInterval(100);
+	this->watcher.setDebounceInterval(100);
 
 	QObject::connect(
 	    &this->watcher,
-	    &QFileSystemWatcher::directoryChanged,
-	    this,
-	    &DesktopEntryMonitor::onDirectoryChanged
-	);
-	QObject::connect(
-	    &this->debounceTimer,
-	    &QTimer::timeout,
+	    &FileWatch::changed,
 	    this,
 	    &DesktopEntryMonitor::processChanges
 	);
@@ -61,8 +54,4 @@ void DesktopEntryMonitor::scanAndWatch(const QString& dirPath) {
 	for (const auto& subdir: subdirs) this->watcher.addPath(subdir.absoluteFilePath());
 }
 
-void DesktopEntryMonitor::onDirectoryChanged(const QString& /*path*/) {
-	this->debounceTimer.start();
-}
-
 void DesktopEntryMonitor::processChanges() { emit this->desktopEntriesChanged(); }
\ No newline at end of file
@@ -1,9 +1,9 @@
 #pragma once
 
-#include <qfilesystemwatcher.h>
 #include <qobject.h>
 #include <qstringlist.h>
-#include <qtimer.h>
+
+#include "filewatch.hpp"
 
 class DesktopEntryMonitor: public QObject {
 	Q_OBJECT
@@ -20,13 +20,11 @@ signals:
 	void desktopEntriesChanged();
 
 private slots:
-	void onDirectoryChanged(const QString& path);
 	void processChanges();
 
 private:
 	void startMonitoring();
 	void scanAndWatch(const QString& dirPath);
 
-	QFileSystemWatcher watcher;
-	QTimer debounceTimer;
+	FileWatch watcher;
 };
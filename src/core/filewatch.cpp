@@ -0,0 +1,337 @@
+#include "filewatch.hpp"
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <utility>
+
+#include <qcontainerfwd.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qobject.h>
+#include <qset.h>
+#include <qsocketnotifier.h>
+#include <qstring.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "logcat.hpp"
+
+namespace {
+QS_LOGGING_CATEGORY(logFileWatch, "quickshell.filewatch", QtWarningMsg);
+
+constexpr quint32 SELF_EVENTS = IN_DELETE_SELF | IN_MOVE_SELF;
+constexpr quint32 ENTRY_EVENTS = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+
+constexpr quint32 FILE_MASK = IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | SELF_EVENTS;
+// Directories are not told about writes to their entries, which are frequent for
+// directories holding logs or caches. Watched files have their own watch for those.
+constexpr quint32 DIRECTORY_MASK = ENTRY_EVENTS | SELF_EVENTS;
+} // namespace
+
+FileWatchHub::FileWatchHub() {
+	this->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+	if (this->fd == -1) {
+		qCWarning(logFileWatch) << "Failed to create inotify instance, files will not be watched:"
+		                        << std::strerror(errno);
+		return;
+	}
+
+	this->notifier = new QSocketNotifier(this->fd, QSocketNotifier::Read, this);
+	QObject::connect(this->notifier, &QSocketNotifier::activated, this, &FileWatchHub::onReadable);
+}
+
+FileWatchHub* FileWatchHub::instance() {
+	static auto* instance = new FileWatchHub(); // NOLINT
+	return instance;
+}
+
+void FileWatchHub::subscribe(FileWatch* watch, const QString& path, bool directory) {
+	auto& subscribers = directory ? this->directorySubscribers[path] : this->fileSubscribers[path];
+	subscribers.append(watch);
+	if (subscribers.length() != 1) return;
+
+	if (directory) {
+		this->acquire(path, DIRECTORY_MASK);
+	} else {
+		// The parent directory reports creation, removal and replacement by rename,
+		// and the file itself reports writes through other paths, such as symlinks.
+		this->acquire(QFileInfo(path).absolutePath(), DIRECTORY_MASK);
+		this->acquire(path, FILE_MASK);
+	}
+}
+
+void FileWatchHub::unsubscribe(FileWatch* watch, const QString& path, bool directory) {
+	auto& map = directory ? this->directorySubscribers : this->fileSubscribers;
+	auto subscribers = map.find(path);
+	if (subscribers == map.end()) return;
+
+	subscribers->removeOne(watch);
+	if (!subscribers->isEmpty()) return;
+	map.erase(subscribers);
+
+	if (directory) {
+		this->release(path);
+	} else {
+		this->release(path);
+		this->release(QFileInfo(path).absolutePath());
+	}
+}
+
+void FileWatchHub::acquire(const QString& path, quint32 mask) {
+	auto& watch = this->watches[path];
+	watch.refs++;
+
+	if (watch.refs == 1) {
+		watch.mask = mask;
+		this->addWatch(path, watch);
+	} else if ((watch.mask & mask) != mask) {
+		// Only happens when a path is watched as both a file and a directory.
+		watch.mask |= mask;
+		this->addWatch(path, watch);
+	}
+}
+
+void FileWatchHub::release(const QString& path) {
+	auto watch = this->watches.find(path);
+	if (watch == this->watches.end()) return;
+
+	watch->refs--;
+	if (watch->refs != 0) return;
+
+	this->dropWatch(path, *watch);
+	this->watches.erase(watch);
+}
+
+void FileWatchHub::addWatch(const QString& path, Watch& watch) {
+	if (this->fd == -1) return;
+
+	// inotify shares a single watch between every path that resolves to the same inode,
+	// so masks are added to the existing watch instead of replacing it. Events meant for
+	// other paths are filtered out in dispatch.
+	auto wd = inotify_add_watch(
+	    this->fd,
+	    QFile::encodeName(path).constData(),
+	    watch.mask | IN_MASK_ADD
+	);
+
+	if (wd == -1) {
+		// Expected for files that do not exist yet, which are watched when created.
+		qCDebug(logFileWatch) << "Could not watch" << path << "-" << std::strerror(errno);
+		return;
+	}
+
+	watch.wd = wd;
+
+	auto& paths = this->wdPaths[wd];
+	if (!paths.contains(path)) paths.append(path);
+
+	qCDebug(logFileWatch) << "Watching" << path << "with wd" << wd << "-" << this->watches.size()
+	                      << "paths watched";
+}
+
+void FileWatchHub::dropWatch(const QString& path, Watch& watch) {
+	if (watch.wd == -1) return;
+
+	auto paths = this->wdPaths.find(watch.wd);
+	if (paths != this->wdPaths.end()) {
+		paths->removeOne(path);
+
+		if (paths->isEmpty()) {
+			this->wdPaths.erase(paths);
+			inotify_rm_watch(this->fd, watch.wd);
+		}
+	}
+
+	watch.wd = -1;
+}
+
+void FileWatchHub::rewatch(const QString& path) {
+	auto watch = this->watches.find(path);
+	if (watch == this->watches.end()) return;
+
+	// A file created or renamed into place is a new inode, and needs a new watch.
+	auto oldWd = watch->wd;
+	this->dropWatch(path, *watch);
+	this->addWatch(path, *watch);
+
+	if (watch->wd != oldWd) {
+		qCDebug(logFileWatch) << "Rewatched replaced file" << path;
+	}
+}
+
+void FileWatchHub::onReadable() {
+	// Large enough for several events with maximum length names.
+	alignas(inotify_event) std::array<char, 16 * (sizeof(inotify_event) + NAME_MAX + 1)> buffer {};
+
+	while (true) {
+		auto len = ::read(this->fd, buffer.data(), buffer.size());
+
+		if (len == -1) {
+			if (errno == EINTR) continue;
+			if (errno != EAGAIN) {
+				qCWarning(logFileWatch) << "Failed to read inotify events:" << std::strerror(errno);
+			}
+
+			break;
+		}
+
+		if (len == 0) break;
+
+		for (qsizetype i = 0; i < len;) {
+			const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + i); // NOLINT
+			auto name = event->len == 0 ? QString() : QFile::decodeName(event->name);       // NOLINT
+
+			this->dispatch(event->wd, event->mask, name);
+			i += static_cast<qsizetype>(sizeof(inotify_event) + event->len);
+		}
+	}
+}
+
+void FileWatchHub::dispatch(int wd, quint32 mask, const QString& name) {
+	if (mask & IN_Q_OVERFLOW) {
+		qCWarning(logFileWatch) << "inotify event queue overflowed, reporting all paths as changed.";
+
+		for (const auto& path: this->fileSubscribers.keys()) this->notifyFile(path);
+		for (const auto& path: this->directorySubscribers.keys()) this->notifyDirectory(path);
+		return;
+	}
+
+	// Copied as notifying subscribers may change watches.
+	auto paths = this->wdPaths.value(wd);
+
+	for (const auto& path: paths) {
+		if (name.isEmpty()) {
+			if (mask & IN_IGNORED) continue;
+			if (this->fileSubscribers.contains(path)) this->notifyFile(path);
+
+			if ((mask & SELF_EVENTS) && this->directorySubscribers.contains(path)) {
+				this->notifyDirectory(path);
+			}
+		} else {
+			auto child = path.endsWith('/') ? path + name : path + '/' + name;
+
+			if (this->fileSubscribers.contains(child)) {
+				if (mask & (IN_CREATE | IN_MOVED_TO)) this->rewatch(child);
+				this->notifyFile(child);
+			}
+
+			if ((mask & ENTRY_EVENTS) && this->directorySubscribers.contains(path)) {
+				this->notifyDirectory(path);
+			}
+		}
+	}
+
+	if (mask & IN_IGNORED) {
+		// The watched inode is gone. Files are watched again when recreated.
+		for (const auto& path: paths) {
+			auto watch = this->watches.find(path);
+			if (watch != this->watches.end() && watch->wd == wd) watch->wd = -1;
+		}
+
+		this->wdPaths.remove(wd);
+	}
+}
+
+void FileWatchHub::notifyFile(const QString& path) {
+	for (auto* watch: this->fileSubscribers.value(path)) {
+		watch->queueChange(path, false);
+	}
+}
+
+void FileWatchHub::notifyDirectory(const QString& path) {
+	for (auto* watch: this->directorySubscribers.value(path)) {
+		watch->queueChange(path, true);
+	}
+}
+
+FileWatch::FileWatch(QObject* parent): QObject(parent) {
+	this->debounceTimer.setSingleShot(true);
+	this->debounceTimer.setInterval(0);
+	QObject::connect(&this->debounceTimer, &QTimer::timeout, this, &FileWatch::flush);
+}
+
+FileWatch::~FileWatch() { this->clear(); }
+
+QString FileWatch::normalizePath(const QString& path) {
+	return QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+}
+
+void FileWatch::addPath(const QString& path) {
+	if (path.isEmpty()) return;
+
+	auto normalized = FileWatch::normalizePath(path);
+	if (this->mPaths.contains(normalized)) return;
+
+	auto directory = QFileInfo(normalized).isDir();
+	this->mPaths.insert(normalized, path);
+	this->directories.insert(normalized, directory);
+
+	FileWatchHub::instance()->subscribe(this, normalized, directory);
+}
+
+void FileWatch::removePath(const QString& path) {
+	auto normalized = FileWatch::normalizePath(path);
+	if (!this->mPaths.remove(normalized)) return;
+
+	auto directory = this->directories.take(normalized);
+	FileWatchHub::instance()->unsubscribe(this, normalized, directory);
+}
+
+void FileWatch::setPaths(const QStringList& paths) {
+	auto keep = QSet<QString>();
+
+	// Added first so watches shared between both sets are not torn down.
+	for (const auto& path: paths) {
+		this->addPath(path);
+		keep.insert(FileWatch::normalizePath(path));
+	}
+
+	for (const auto& normalized: this->mPaths.keys()) {
+		if (!keep.contains(normalized)) this->removePath(normalized);
+	}
+}
+
+void FileWatch::clear() {
+	auto* hub = FileWatchHub::instance();
+
+	for (const auto& [normalized, directory]: this->directories.asKeyValueRange()) {
+		hub->unsubscribe(this, normalized, directory);
+	}
+
+	this->mPaths.clear();
+	this->directories.clear();
+	this->pending.clear();
+	this->debounceTimer.stop();
+}
+
+void FileWatch::queueChange(const QString& normalizedPath, bool directory) {
+	auto path = this->mPaths.value(normalizedPath);
+	if (path.isEmpty()) return;
+
+	for (const auto& target: this->pending) {
+		if (target.path == path && target.directory == directory) return;
+	}
+
+	this->pending.append({.path = path, .directory = directory});
+	if (!this->debounceTimer.isActive()) this->debounceTimer.start();
+}
+
+void FileWatch::flush() {
+	auto pending = std::exchange(this->pending, {});
+
+	if (pending.isEmpty()) return;
+
+	for (const auto& target: pending) {
+		if (target.directory) emit this->directoryChanged(target.path);
+		else emit this->fileChanged(target.path);
+	}
+
+	emit this->changed();
+}
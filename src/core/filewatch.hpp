@@ -0,0 +1,118 @@
+#pragma once
+
+#include <qcontainerfwd.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qstring.h>
+#include <qtclasshelpermacros.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+
+class QSocketNotifier;
+class FileWatch;
+
+// Owns the single inotify instance used for all file watching in the process.
+//
+// inotify watches are refcounted by path and shared between all FileWatches
+// watching the same path. Must only be used from the main thread.
+class FileWatchHub: public QObject {
+	Q_OBJECT;
+
+public:
+	static FileWatchHub* instance();
+
+	void subscribe(FileWatch* watch, const QString& path, bool directory);
+	void unsubscribe(FileWatch* watch, const QString& path, bool directory);
+
+	// Number of paths with an active inotify watch.
+	[[nodiscard]] qsizetype watchCount() const { return this->watches.size(); }
+
+private slots:
+	void onReadable();
+
+private:
+	explicit FileWatchHub();
+
+	struct Watch {
+		int wd = -1;
+		qsizetype refs = 0;
+		quint32 mask = 0;
+	};
+
+	void acquire(const QString& path, quint32 mask);
+	void release(const QString& path);
+	void addWatch(const QString& path, Watch& watch);
+	void dropWatch(const QString& path, Watch& watch);
+	void rewatch(const QString& path);
+	void dispatch(int wd, quint32 mask, const QString& name);
+	void notifyFile(const QString& path);
+	void notifyDirectory(const QString& path);
+
+	int fd = -1;
+	QSocketNotifier* notifier = nullptr;
+	QHash<QString, Watch> watches;
+	QHash<int, QStringList> wdPaths;
+	QHash<QString, QList<FileWatch*>> fileSubscribers;
+	QHash<QString, QList<FileWatch*>> directorySubscribers;
+};
+
+// A set of watched files and directories, backed by FileWatchHub.
+//
+// Files are watched both directly and through their parent directory, so a change
+// is reported when a file is modified, created, removed, or replaced by renaming
+// another file over it, as editors and atomic writes do. Watching continues across
+// removal and recreation of the file.
+//
+// Directories report entries being created, removed or renamed, and the directory
+// itself being removed or moved. Writes to existing entries are not reported.
+//
+// Changes are debounced per FileWatch, and each changed path is reported once
+// per debounce interval.
+class FileWatch: public QObject {
+	Q_OBJECT;
+
+public:
+	explicit FileWatch(QObject* parent = nullptr);
+	~FileWatch() override;
+	Q_DISABLE_COPY_MOVE(FileWatch);
+
+	void addPath(const QString& path);
+	void removePath(const QString& path);
+	// Replaces the watched paths, keeping existing watches on paths in both sets.
+	void setPaths(const QStringList& paths);
+	void clear();
+
+	[[nodiscard]] QStringList paths() const { return this->mPaths.values(); }
+
+	// Defaults to 0, which reports changes once per event loop iteration.
+	[[nodiscard]] int debounceInterval() const { return this->debounceTimer.interval(); }
+	void setDebounceInterval(int interval) { this->debounceTimer.setInterval(interval); }
+
+signals:
+	void fileChanged(const QString& path);
+	void directoryChanged(const QString& path);
+	// Emitted once after each batch of fileChanged and directoryChanged signals.
+	void changed();
+
+private slots:
+	void flush();
+
+private:
+	struct Target {
+		QString path;
+		bool directory = false;
+	};
+
+	static QString normalizePath(const QString& path);
+	void queueChange(const QString& normalizedPath, bool directory);
+
+	// Keyed by normalized path, with the path as given.
+	QHash<QString, QString> mPaths;
+	QHash<QString, bool> directories;
+	QList<Target> pending;
+	QTimer debounceTimer;
+
+	friend class FileWatchHub;
+};
@@ -6,7 +6,6 @@
 #include <qdebug.h>
 #include <qdir.h>
 #include <qfileinfo.h>
-#include <qfilesystemwatcher.h>
 #include <qhash.h>
 #include <qlist.h>
 #include <qlogging.h>
@@ -18,12 +17,15 @@
 #include <qqmlincubator.h>
 #include <qquickwindow.h>
 #include <qtmetamacros.h>
+#include <qwindow.h>
 
+#include "filewatch.hpp"
 #include "iconimageprovider.hpp"
 #include "imageprovider.hpp"
 #include "incubator.hpp"
 #include "logcat.hpp"
 #include "plugin.hpp"
+#include "qmlglobal.hpp"
 #include "qsintercept.hpp"
 #include "reload.hpp"
 #include "scan.hpp"
@@ -49,7 +51,18 @@ EngineGeneration::EngineGeneration(const QDir& rootPath, QmlScanner scanner)
 	this->engine->addImportPath("qs:@/");
 
 	this->engine->setNetworkAccessManagerFactory(&this->interceptNetFactory);
-	this->engine->setIncubationController(&this->delayedIncubationController);
+	// Held until the reload completes, so lazy loaders don't start blocking before onReload reuses windows.
+	this->incubationController.setTimeSlice(QuickshellSettings::instance()->incubationTimeSlice());
+	this->engine->setIncubationController(&this->incubationController);
+
+	QObject::connect(
+	    QuickshellSettings::instance(),
+	    &QuickshellSettings::incubationTimeSliceChanged,
+	    this,
+	    [this]() {
+		    this->incubationController.setTimeSlice(QuickshellSettings::instance()->incubationTimeSlice());
+	    }
+	);
 
 	this->engine->addImageProvider("icon", new IconImageProvider());
 	this->engine->addImageProvider("qsimage", new QsImageProvider());
@@ -146,6 +159,7 @@ void EngineGeneration::onReload(EngineGeneration* old) {
 
 	this->singletonRegistry.onReload(old == nullptr ? nullptr : &old->singletonRegistry);
 	this->reloadComplete = true;
+	this->assignIncubationController();
 	emit this->reloadFinished();
 
 	if (old != nullptr) {
@@ -169,31 +183,15 @@ void EngineGeneration::postReload() {
 void EngineGeneration::setWatchingFiles(bool watching) {
 	if (watching) {
 		if (this->watcher == nullptr) {
-			this->watcher = new QFileSystemWatcher();
-
-			for (auto& file: this->scanner.scannedFiles) {
-				this->watcher->addPath(file);
-				this->watcher->addPath(QFileInfo(file).dir().absolutePath());
-			}
-
-			for (auto& file: this->extraWatchedFiles) {
-				this->watcher->addPath(file);
-				this->watcher->addPath(QFileInfo(file).dir().absolutePath());
-			}
+			this->watcher = new FileWatch();
+			this->watcher->setPaths(this->scanner.scannedFiles + this->extraWatchedFiles);
 
 			QObject::connect(
 			    this->watcher,
-			    &QFileSystemWatcher::fileChanged,
+			    &FileWatch::fileChanged,
 			    this,
 			    &EngineGeneration::onFileChanged
 			);
-
-			QObject::connect(
-			    this->watcher,
-			    &QFileSystemWatcher::directoryChanged,
-			    this,
-			    &EngineGeneration::onDirectoryChanged
-			);
 		}
 	} else {
 		if (this->watcher != nullptr) {
@@ -212,34 +210,22 @@ bool EngineGeneration::setExtraWatchedFiles(const QVector<QString>& files) {
 	}
 
 	if (this->watcher) {
-		this->setWatchingFiles(false);
-		this->setWatchingFiles(true);
+		this->watcher->setPaths(this->scanner.scannedFiles + this->extraWatchedFiles);
 	}
 
 	return !this->extraWatchedFiles.isEmpty();
 }
 
 void EngineGeneration::onFileChanged(const QString& name) {
-	if (!this->watcher->files().contains(name)) {
-		this->deletedWatchedFiles.push_back(name);
-	} else {
-		// some editors (e.g vscode) perform file saving in two steps: truncate + write
-		// ignore the first event (truncate) with size 0 to prevent incorrect live reloading
-		auto fileInfo = QFileInfo(name);
-		if (fileInfo.isFile() && fileInfo.size() == 0) return;
+	// Removed files stay watched, and are reported again once replaced.
+	auto fileInfo = QFileInfo(name);
+	if (!fileInfo.exists()) return;
 
-		emit this->filesChanged();
-	}
-}
+	// some editors (e.g vscode) perform file saving in two steps: truncate + write
+	// ignore the first event (truncate) with size 0 to prevent incorrect live reloading
+	if (fileInfo.isFile() && fileInfo.size() == 0) return;
 
-void EngineGeneration::onDirectoryChanged() {
-	// try to find any files that were just deleted from a replace operation
-	for (auto& file: this->deletedWatchedFiles) {
-		if (QFileInfo(file).exists()) {
-			emit this->filesChanged();
-			break;
-		}
-	}
+	emit this->filesChanged();
 }
 
 void EngineGeneration::onEngineWarnings(const QList<QQmlError>& warnings) {
@@ -287,6 +273,9 @@ void EngineGeneration::trackWindowIncubationController(QQuickWindow* window) {
 	if (this->trackedWindows.contains(window)) return;
 
 	QObject::connect(window, &QObject::destroyed, this, &EngineGeneration::onTrackedWindowDestroyed);
+	// clang-format off
+	QObject::connect(window, &QWindow::visibleChanged, this, &EngineGeneration::assignIncubationController);
+	// clang-format on
 	this->trackedWindows.append(window);
 	this->assignIncubationController();
 }
@@ -297,20 +286,22 @@ void EngineGeneration::onTrackedWindowDestroyed(QObject* object) {
 }
 
 void EngineGeneration::assignIncubationController() {
-	QQmlIncubationController* controller = &this->delayedIncubationController;
+	QQuickWindow* frameSource = nullptr;
 
-	for (auto* window: this->trackedWindows) {
-		if (auto* wctl = window->incubationController()) {
-			controller = wctl;
-			break;
+	if (!this->incubationControllersLocked) {
+		for (auto* window: this->trackedWindows) {
+			if (window->isVisible()) {
+				frameSource = window;
+				break;
+			}
 		}
 	}
 
-	qCDebug(logIncubator) << "Assigning incubation controller" << controller << "to generation"
-	                      << this
-	                      << "fallback:" << (controller == &this->delayedIncubationController);
+	qCDebug(logIncubator) << "Assigning incubation frame source" << frameSource << "to generation"
+	                      << this << "locked:" << this->incubationControllersLocked;
 
-	this->engine->setIncubationController(controller);
+	this->incubationController.setFrameSource(frameSource);
+	this->incubationController.setHeld(!this->reloadComplete || this->incubationControllersLocked);
 }
 
 EngineGeneration* EngineGeneration::currentGeneration() {
@@ -2,7 +2,6 @@
 
 #include <qcontainerfwd.h>
 #include <qdir.h>
-#include <qfilesystemwatcher.h>
 #include <qhash.h>
 #include <qlist.h>
 #include <qobject.h>
@@ -12,6 +11,7 @@
 #include <qquickwindow.h>
 #include <qtclasshelpermacros.h>
 
+#include "filewatch.hpp"
 #include "incubator.hpp"
 #include "qsintercept.hpp"
 #include "scan.hpp"
@@ -62,10 +62,9 @@ public:
 	QQmlEngine* engine = nullptr;
 	QObject* root = nullptr;
 	SingletonRegistry singletonRegistry;
-	QFileSystemWatcher* watcher = nullptr;
-	QVector<QString> deletedWatchedFiles;
+	FileWatch* watcher = nullptr;
 	QVector<QString> extraWatchedFiles;
-	DelayedQmlIncubationController delayedIncubationController;
+	QsIncubationController incubationController;
 	bool reloadComplete = false;
 	QuickshellGlobal* qsgInstance = nullptr;
 
@@ -83,13 +82,12 @@ public slots:
 
 private slots:
 	void onFileChanged(const QString& name);
-	void onDirectoryChanged();
 	void onTrackedWindowDestroyed(QObject* object);
+	void assignIncubationController();
 	static void onEngineWarnings(const QList<QQmlError>& warnings);
 
 private:
 	void postReload();
-	void assignIncubationController();
 	QVector<QQuickWindow*> trackedWindows;
 	bool incubationControllersLocked = false;
 	QHash<const void*, EngineGenerationExt*> extensions;
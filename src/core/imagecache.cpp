@@ -0,0 +1,152 @@
+#include "imagecache.hpp"
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include <qbytearray.h>
+#include <qcontainerfwd.h>
+#include <qhashfunctions.h>
+#include <qimage.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qmutex.h>
+#include <qtypes.h>
+
+#include "logcat.hpp"
+
+namespace {
+QS_LOGGING_CATEGORY(logImageCache, "quickshell.imagecache", QtWarningMsg);
+
+// Arbitrary, only needs to differ from the primary hash seed.
+constexpr size_t CHECK_HASH_SEED = 0x9e3779b97f4a7c15;
+} // namespace
+
+size_t qHash(const SharedImageKey& key, size_t seed) {
+	return qHashMulti(seed, key.hash, key.size, key.params);
+}
+
+SharedImageCache::SharedImageCache(qsizetype retainedByteLimit)
+    : mRetainedByteLimit(retainedByteLimit) {}
+
+SharedImageCache* SharedImageCache::instance() {
+	static auto* instance = new SharedImageCache(); // NOLINT
+	return instance;
+}
+
+SharedImageKey SharedImageCache::contentKey(const QByteArray& data, quint64 params) {
+	return SharedImageKey {
+	    .hash = qHashBits(data.constData(), data.size(), 0),
+	    .checkHash = qHashBits(data.constData(), data.size(), CHECK_HASH_SEED),
+	    .size = data.size(),
+	    .params = params,
+	};
+}
+
+QImage SharedImageCache::image(
+    const QByteArray& data,
+    quint64 params,
+    const std::function<QImage()>& decode
+) {
+	auto key = SharedImageCache::contentKey(data, params);
+
+	{
+		auto locker = QMutexLocker(&this->mutex);
+		auto entry = this->entries.find(key);
+
+		if (entry != this->entries.end()) {
+			entry->lastUse = ++this->useCounter;
+			return entry->image;
+		}
+	}
+
+	// Decoded without holding the lock. If another thread decodes the same
+	// content concurrently, the first inserted result wins.
+	auto image = decode();
+	if (image.isNull()) return image;
+
+	auto locker = QMutexLocker(&this->mutex);
+	auto entry = this->entries.find(key);
+
+	if (entry != this->entries.end()) {
+		entry->lastUse = ++this->useCounter;
+		return entry->image;
+	}
+
+	this->entries.insert(key, Entry {.image = image, .lastUse = ++this->useCounter});
+	this->mTotalBytes += image.sizeInBytes();
+
+	qCDebug(logImageCache) << "Cached" << image.size() << "image," << this->entries.size()
+	                       << "images totalling" << this->mTotalBytes << "bytes";
+
+	this->trim();
+	return image;
+}
+
+qsizetype SharedImageCache::retainedByteLimit() const {
+	auto locker = QMutexLocker(&this->mutex);
+	return this->mRetainedByteLimit;
+}
+
+void SharedImageCache::setRetainedByteLimit(qsizetype limit) {
+	auto locker = QMutexLocker(&this->mutex);
+	this->mRetainedByteLimit = limit;
+	this->trim();
+}
+
+qsizetype SharedImageCache::totalBytes() const {
+	auto locker = QMutexLocker(&this->mutex);
+	return this->mTotalBytes;
+}
+
+qsizetype SharedImageCache::retainedBytes() const {
+	auto locker = QMutexLocker(&this->mutex);
+	return this->retainedBytesLocked();
+}
+
+qsizetype SharedImageCache::count() const {
+	auto locker = QMutexLocker(&this->mutex);
+	return this->entries.size();
+}
+
+void SharedImageCache::clear() {
+	auto locker = QMutexLocker(&this->mutex);
+	this->entries.clear();
+	this->mTotalBytes = 0;
+}
+
+qsizetype SharedImageCache::retainedBytesLocked() const {
+	qsizetype bytes = 0;
+
+	for (const auto& entry: this->entries) {
+		// Only the cache's copy references the pixel data.
+		if (entry.image.isDetached()) bytes += entry.image.sizeInBytes();
+	}
+
+	return bytes;
+}
+
+// Must be called with the mutex held.
+void SharedImageCache::trim() {
+	auto retained = this->retainedBytesLocked();
+	if (retained <= this->mRetainedByteLimit) return;
+
+	auto unused = QList<std::pair<quint64, SharedImageKey>>();
+	for (const auto& [key, entry]: this->entries.asKeyValueRange()) {
+		if (entry.image.isDetached()) unused.append({entry.lastUse, key});
+	}
+
+	std::ranges::sort(unused, {}, &std::pair<quint64, SharedImageKey>::first);
+
+	for (const auto& [lastUse, key]: unused) {
+		if (retained <= this->mRetainedByteLimit) break;
+
+		auto entry = this->entries.find(key);
+		auto bytes = entry->image.sizeInBytes();
+		this->entries.erase(entry);
+		this->mTotalBytes -= bytes;
+		retained -= bytes;
+	}
+
+	qCDebug(logImageCache) << "Trimmed cache to" << this->entries.size() << "images totalling"
+	                       << this->mTotalBytes << "bytes," << retained << "bytes unused";
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <functional>
+
+#include <qbytearray.h>
+#include <qhash.h>
+#include <qimage.h>
+#include <qmutex.h>
+#include <qtypes.h>
+
+struct SharedImageKey {
+	size_t hash = 0;
+	size_t checkHash = 0;
+	qsizetype size = 0;
+	quint64 params = 0;
+
+	[[nodiscard]] bool operator==(const SharedImageKey& other) const = default;
+};
+
+size_t qHash(const SharedImageKey& key, size_t seed = 0);
+
+// Deduplicates images decoded from raw pixel data, such as notification images
+// and tray icon pixmaps, which are often resent unchanged.
+//
+// Images are keyed by the content they were decoded from. Returned images share
+// their pixel data with the cache, so an image is considered in use as long as any
+// copy outside the cache exists. Images no longer in use are retained for reuse
+// up to retainedByteLimit() bytes, after which the least recently used are dropped
+// when the next image is added.
+//
+// Safe to use from any thread.
+class SharedImageCache {
+public:
+	explicit SharedImageCache(qsizetype retainedByteLimit = 16 * 1024 * 1024);
+
+	static SharedImageCache* instance();
+
+	// Returns the cached image decoded from data, or decodes it with decode() if not cached.
+	// params must include anything besides data that changes the result of decode().
+	// Images returned by decode() must own their pixel data.
+	QImage image(const QByteArray& data, quint64 params, const std::function<QImage()>& decode);
+
+	[[nodiscard]] static SharedImageKey contentKey(const QByteArray& data, quint64 params);
+
+	[[nodiscard]] qsizetype retainedByteLimit() const;
+	void setRetainedByteLimit(qsizetype limit);
+
+	// Total bytes of all cached images, including those in use.
+	[[nodiscard]] qsizetype totalBytes() const;
+	// Bytes of cached images which are held only by the cache.
+	[[nodiscard]] qsizetype retainedBytes() const;
+	[[nodiscard]] qsizetype count() const;
+
+	void clear();
+
+private:
+	struct Entry {
+		QImage image;
+		quint64 lastUse = 0;
+	};
+
+	void trim();
+	[[nodiscard]] qsizetype retainedBytesLocked() const;
+
+	mutable QMutex mutex;
+	QHash<SharedImageKey, Entry> entries;
+	qsizetype mRetainedByteLimit;
+	qsizetype mTotalBytes = 0;
+	quint64 useCounter = 0;
+};
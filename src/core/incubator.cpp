@@ -1,8 +1,16 @@
 #include "incubator.hpp"
 
+#include <algorithm>
+
+#include <qelapsedtimer.h>
 #include <qlogging.h>
+#include <qnamespace.h>
+#include <qobject.h>
 #include <qqmlincubator.h>
+#include <qquickwindow.h>
+#include <qscreen.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "logcat.hpp"
 
@@ -15,3 +23,120 @@ void QsQmlIncubator::statusChanged(QQmlIncubator::Status status) {
 	default: break;
 	}
 }
+
+void QsQmlIncubator::setInitialState(QObject* object) { emit this->initialState(object); }
+
+QsIncubationController::QsIncubationController(QObject* parent): QObject(parent) {
+	QObject::connect(&this->timer, &QTimer::timeout, this, &QsIncubationController::onTimeout);
+}
+
+void QsIncubationController::setHeld(bool held) {
+	if (held == this->held) return;
+	this->held = held;
+
+	qCDebug(logIncubator) << "Incubation controller" << this << (held ? "held" : "released")
+	                      << "with" << this->incubatingObjectCount() << "objects pending";
+
+	this->schedule();
+}
+
+void QsIncubationController::setFrameSource(QQuickWindow* window) {
+	if (window == this->frameSource) return;
+
+	if (this->frameSource != nullptr) {
+		QObject::disconnect(this->frameSource, nullptr, this, nullptr);
+	}
+
+	this->frameSource = window;
+
+	if (window != nullptr) {
+		// frameSwapped is emitted from the render thread when using the threaded render loop.
+		QObject::connect(
+		    window,
+		    &QQuickWindow::frameSwapped,
+		    this,
+		    &QsIncubationController::onFrameSwapped,
+		    Qt::QueuedConnection
+		);
+
+		QObject::connect(
+		    window,
+		    &QObject::destroyed,
+		    this,
+		    &QsIncubationController::onFrameSourceDestroyed
+		);
+	}
+
+	qCDebug(logIncubator) << "Incubation controller" << this << "using frame source" << window;
+
+	this->timer.stop();
+	this->schedule();
+}
+
+void QsIncubationController::onFrameSourceDestroyed() {
+	this->frameSource = nullptr;
+	this->timer.stop();
+	this->schedule();
+}
+
+void QsIncubationController::setTimeSlice(int timeSlice) {
+	this->mTimeSlice = std::max(timeSlice, 1);
+}
+
+void QsIncubationController::incubatingObjectCountChanged(int /*count*/) {
+	emit this->queueDepthChanged();
+	this->schedule();
+}
+
+int QsIncubationController::frameInterval() const {
+	auto* screen = this->frameSource->screen();
+	auto rate = screen == nullptr ? 0.0 : screen->refreshRate();
+	if (rate <= 0) rate = 60;
+
+	return std::max(static_cast<int>(1000 / rate), 1);
+}
+
+void QsIncubationController::schedule() {
+	if (this->held || this->incubatingObjectCount() == 0) {
+		this->timer.stop();
+		return;
+	}
+
+	if (this->timer.isActive()) return;
+
+	// Without a window there are no frames to align to, so incubation runs once per
+	// event loop iteration, letting other events through between slices.
+	this->timer.setInterval(this->frameSource == nullptr ? 0 : this->frameInterval());
+	this->timer.start();
+}
+
+void QsIncubationController::onFrameSwapped() {
+	// Swaps queued before the frame source was removed may still arrive.
+	if (this->frameSource == nullptr) return;
+	if (this->held || this->incubatingObjectCount() == 0) return;
+
+	this->incubate(std::min(this->mTimeSlice, std::max(this->frameInterval() / 3, 1)));
+
+	// Restarted so the fallback tick only runs when frames stop.
+	if (this->timer.isActive()) this->timer.start();
+}
+
+void QsIncubationController::onTimeout() {
+	if (this->frameSource == nullptr) {
+		this->incubate(this->mTimeSlice);
+	} else {
+		this->incubate(std::min(this->mTimeSlice, std::max(this->frameInterval() / 3, 1)));
+	}
+}
+
+void QsIncubationController::incubate(int msecs) {
+	auto elapsed = QElapsedTimer();
+	elapsed.start();
+
+	this->incubateFor(msecs);
+
+	this->mTimeSpent += static_cast<qreal>(elapsed.nsecsElapsed()) / 1000000.0;
+	emit this->timeSpentChanged();
+
+	this->schedule();
+}
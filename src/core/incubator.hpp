@@ -2,7 +2,10 @@
 
 #include <qobject.h>
 #include <qqmlincubator.h>
+#include <qquickwindow.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "logcat.hpp"
 
@@ -19,13 +22,62 @@ public:
 	    , QQmlIncubator(mode) {}
 
 	void statusChanged(QQmlIncubator::Status status) override;
+	void setInitialState(QObject* object) override;
 
 signals:
 	void completed();
 	void failed();
+	// Emitted after the object is created, before its bindings are evaluated and it is completed.
+	void initialState(QObject* object);
 };
 
-class DelayedQmlIncubationController: public QQmlIncubationController {
-	// Do nothing.
-	// This ensures lazy loaders don't start blocking before onReload creates windows.
+// Incubates asynchronously created objects in time slices from the event loop.
+//
+// While a frame source window is set, slices run after each frame is swapped and are limited
+// to a third of the frame time, with a fallback tick at the frame rate for when nothing is
+// being rendered. Otherwise slices run on every event loop iteration while objects are pending.
+//
+// Starts held, and does not incubate anything until released.
+class QsIncubationController
+    : public QObject
+    , public QQmlIncubationController {
+	Q_OBJECT;
+
+public:
+	explicit QsIncubationController(QObject* parent = nullptr);
+
+	[[nodiscard]] bool isHeld() const { return this->held; }
+	void setHeld(bool held);
+
+	void setFrameSource(QQuickWindow* window);
+
+	// The longest time slice used when not aligned to frames, in milliseconds.
+	[[nodiscard]] int timeSlice() const { return this->mTimeSlice; }
+	void setTimeSlice(int timeSlice);
+
+	// Total time spent incubating objects, in milliseconds.
+	[[nodiscard]] qreal timeSpent() const { return this->mTimeSpent; }
+
+signals:
+	void queueDepthChanged();
+	void timeSpentChanged();
+
+protected:
+	void incubatingObjectCountChanged(int count) override;
+
+private slots:
+	void onFrameSwapped();
+	void onTimeout();
+	void onFrameSourceDestroyed();
+
+private:
+	void schedule();
+	void incubate(int msecs);
+	[[nodiscard]] int frameInterval() const;
+
+	bool held = true;
+	QQuickWindow* frameSource = nullptr;
+	int mTimeSlice = 5;
+	qreal mTimeSpent = 0;
+	QTimer timer;
 };
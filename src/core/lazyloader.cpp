@@ -1,17 +1,42 @@
 #include "lazyloader.hpp"
 #include <utility>
 
+#include <private/qqmlabstractbinding_p.h>
+#include <private/qqmlproperty_p.h>
 #include <qlogging.h>
+#include <qloggingcategory.h>
 #include <qobject.h>
+#include <qpointer.h>
+#include <qqml.h>
 #include <qqmlcomponent.h>
 #include <qqmlcontext.h>
 #include <qqmlengine.h>
 #include <qqmlincubator.h>
+#include <qqmlproperty.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
+#include <qvariant.h>
 
 #include "incubator.hpp"
+#include "logcat.hpp"
 #include "reload.hpp"
 
+namespace {
+QS_LOGGING_CATEGORY(logLazyLoader, "quickshell.lazyloader", QtWarningMsg);
+
+// How often the prewarm queue checks if the engine is idle.
+constexpr int PREWARM_INTERVAL = 250;
+
+// The `visible` property of an item hidden by the loader, held in a QVariant so the
+// binding type stays out of the header.
+struct HiddenVisibility {
+	QVariant value;
+	// Removed from the item while it is hidden, so it cannot show the item again.
+	QQmlAbstractBinding::Ptr binding;
+};
+} // namespace
+
 void LazyLoader::onReload(QObject* oldInstance) {
 	auto* old = qobject_cast<LazyLoader*>(oldInstance);
 
@@ -28,6 +53,9 @@ void LazyLoader::onReload(QObject* oldInstance) {
 			Reloadable::reloadRecursive(this->mItem, old);
 		}
 	}
+
+	// reloadComplete is set after this returns, and prewarming is only started later.
+	this->updatePrewarm(true);
 }
 
 QObject* LazyLoader::item() {
@@ -39,7 +67,11 @@ void LazyLoader::setItem(QObject* item) {
 	if (item == this->mItem) return;
 
 	if (this->mItem != nullptr) {
-		this->mItem->deleteLater();
+		if (this->mKeepWarm && item == nullptr) {
+			this->pool(this->mItem, LazyLoader::hide(this->mItem));
+		} else {
+			this->mItem->deleteLater();
+		}
 	}
 
 	this->mItem = item;
@@ -52,9 +84,12 @@ void LazyLoader::setItem(QObject* item) {
 
 	emit this->itemChanged();
 	emit this->activeChanged();
+
+	if (item == nullptr) this->updatePrewarm();
 }
 
-bool LazyLoader::isLoading() const { return this->incubator != nullptr; }
+// Prewarming is not exposed as loading.
+bool LazyLoader::isLoading() const { return this->incubator != nullptr && !this->prewarming; }
 
 void LazyLoader::setLoading(bool loading) {
 	if (loading == this->targetLoading || this->isActive()) return;
@@ -68,6 +103,7 @@ void LazyLoader::setLoading(bool loading) {
 	} else if (this->incubator != nullptr) {
 		delete this->incubator;
 		this->incubator = nullptr;
+		this->updatePrewarm();
 	}
 }
 
@@ -118,7 +154,13 @@ void LazyLoader::setComponent(QQmlComponent* component) {
 		);
 	}
 
+	// Pooled items are instances of the old component.
+	this->cancelPrewarm();
+	this->clearWarmItem();
+	this->prewarmFailed = false;
+
 	emit this->componentChanged();
+	this->updatePrewarm();
 }
 
 void LazyLoader::onComponentDestroyed() {
@@ -133,6 +175,10 @@ void LazyLoader::setSource(QString source) {
 	if (source == this->mSource) return;
 	this->cleanupComponent = true;
 
+	this->cancelPrewarm();
+	this->clearWarmItem();
+	this->prewarmFailed = false;
+
 	this->mSource = std::move(source);
 	delete this->mComponent;
 
@@ -153,48 +199,302 @@ void LazyLoader::setSource(QString source) {
 	}
 
 	emit this->sourceChanged();
+	this->updatePrewarm();
+}
+
+bool LazyLoader::keepWarm() const { return this->mKeepWarm; }
+
+void LazyLoader::setKeepWarm(bool keepWarm) {
+	if (keepWarm == this->mKeepWarm) return;
+	this->mKeepWarm = keepWarm;
+	if (!keepWarm && !this->mPrewarm) this->clearWarmItem();
+	emit this->keepWarmChanged();
 }
 
+bool LazyLoader::prewarm() const { return this->mPrewarm; }
+
+void LazyLoader::setPrewarm(bool prewarm) {
+	if (prewarm == this->mPrewarm) return;
+	this->mPrewarm = prewarm;
+
+	if (prewarm) {
+		this->updatePrewarm();
+	} else {
+		this->cancelPrewarm();
+		if (!this->mKeepWarm) this->clearWarmItem();
+	}
+
+	emit this->prewarmChanged();
+}
+
+bool LazyLoader::isWarm() const { return this->warmItem != nullptr; }
+
+qreal LazyLoader::creationTime() const { return this->mCreationTime; }
+
 void LazyLoader::incubateIfReady(bool overrideReloadCheck) {
-	if (!(this->reloadComplete || overrideReloadCheck) || !(this->targetLoading || this->targetActive)
-	    || this->mComponent == nullptr || this->incubator != nullptr)
+	if (!(this->reloadComplete || overrideReloadCheck) || !(this->targetLoading || this->targetActive))
 	{
 		return;
 	}
 
-	this->incubator = new QsQmlIncubator(
-	    this->targetActive ? QQmlIncubator::Synchronous : QQmlIncubator::Asynchronous,
-	    this
+	if (this->warmItem != nullptr) {
+		this->targetLoading = false;
+		this->setItem(this->takeWarmItem());
+		return;
+	}
+
+	if (this->incubator != nullptr) {
+		// An in progress prewarm is taken over as a normal load.
+		if (this->prewarming) {
+			this->prewarming = false;
+			LazyLoaderPrewarmer::instance()->finished(this);
+			emit this->loadingChanged();
+
+			if (this->targetActive) this->incubator->forceCompletion();
+		}
+
+		return;
+	}
+
+	if (this->mComponent == nullptr) return;
+
+	emit this->loadingChanged();
+
+	this->startIncubation(
+	    this->targetActive ? QQmlIncubator::Synchronous : QQmlIncubator::Asynchronous
 	);
+}
+
+void LazyLoader::startIncubation(QQmlIncubator::IncubationMode mode) {
+	this->incubator = new QsQmlIncubator(mode, this);
+	this->prewarmVisible = QVariant();
 
 	// clang-format off
 	QObject::connect(this->incubator, &QsQmlIncubator::completed, this, &LazyLoader::onIncubationCompleted);
 	QObject::connect(this->incubator, &QsQmlIncubator::failed, this, &LazyLoader::onIncubationFailed);
-	// clang-format on
 
-	emit this->loadingChanged();
+	if (this->prewarming) {
+		QObject::connect(this->incubator, &QsQmlIncubator::initialState, this, &LazyLoader::onPrewarmInitialState);
+	}
+	// clang-format on
 
+	this->creationTimer.start();
 	this->mComponent->create(*this->incubator, QQmlEngine::contextForObject(this->mComponent));
 }
 
+void LazyLoader::onPrewarmInitialState(QObject* object) {
+	// Hidden before completion so prewarmed windows are never shown.
+	this->prewarmVisible = LazyLoader::hide(object);
+}
+
 void LazyLoader::onIncubationCompleted() {
-	this->setItem(this->incubator->object());
+	auto* object = this->incubator->object();
+	auto prewarmed = this->prewarming;
+
+	this->mCreationTime = static_cast<qreal>(this->creationTimer.nsecsElapsed()) / 1000000.0;
+
+	qCInfo(logLazyLoader).nospace() << "Created component for " << this << " in "
+	                                << this->mCreationTime << "ms" << (prewarmed ? " (prewarm)" : "");
+
+	emit this->creationTimeChanged();
+
 	// The incubator is not necessarily inert at the time of this callback,
 	// so deleteLater is required.
 	this->incubator->deleteLater();
 	this->incubator = nullptr;
+
+	if (prewarmed) {
+		this->prewarming = false;
+		this->pool(object, std::exchange(this->prewarmVisible, QVariant()));
+		LazyLoaderPrewarmer::instance()->finished(this);
+		return;
+	}
+
+	// Prewarms taken over by a normal load were hidden when created.
+	LazyLoader::show(object, std::exchange(this->prewarmVisible, QVariant()));
+
+	this->setItem(object);
 	this->targetLoading = false;
 	emit this->loadingChanged();
 }
 
 void LazyLoader::onIncubationFailed() {
-	qWarning() << "Failed to create LazyLoader component";
+	qCWarning(logLazyLoader) << "Failed to create LazyLoader component";
 
 	for (auto& error: this->incubator->errors()) {
-		qWarning() << error;
+		qCWarning(logLazyLoader) << error;
+	}
+
+	this->incubator->deleteLater();
+	this->incubator = nullptr;
+
+	if (this->prewarming) {
+		// Not retried until the component changes.
+		this->prewarming = false;
+		this->prewarmFailed = true;
+		LazyLoaderPrewarmer::instance()->finished(this);
+		return;
 	}
 
-	delete this->incubator;
 	this->targetLoading = false;
 	emit this->loadingChanged();
 }
+
+void LazyLoader::updatePrewarm(bool overrideReloadCheck) {
+	if (!this->mPrewarm || this->prewarmFailed || !(this->reloadComplete || overrideReloadCheck)
+	    || this->mComponent == nullptr || this->mItem != nullptr || this->warmItem != nullptr
+	    || this->incubator != nullptr)
+	{
+		return;
+	}
+
+	LazyLoaderPrewarmer::instance()->enqueue(this);
+}
+
+bool LazyLoader::startPrewarm() {
+	if (!this->mPrewarm || !this->reloadComplete || this->targetLoading || this->targetActive
+	    || this->mComponent == nullptr || this->mItem != nullptr || this->warmItem != nullptr
+	    || this->incubator != nullptr)
+	{
+		return false;
+	}
+
+	qCDebug(logLazyLoader) << "Prewarming" << this;
+
+	this->prewarming = true;
+	this->startIncubation(QQmlIncubator::Asynchronous);
+
+	// Simple components may finish immediately.
+	return this->prewarming;
+}
+
+void LazyLoader::cancelPrewarm() {
+	LazyLoaderPrewarmer::instance()->remove(this);
+	if (!this->prewarming) return;
+
+	this->prewarming = false;
+	LazyLoaderPrewarmer::instance()->finished(this);
+
+	delete this->incubator;
+	this->incubator = nullptr;
+}
+
+QVariant LazyLoader::hide(QObject* item) {
+	auto property = QQmlProperty(item, "visible");
+	if (!property.isValid()) return QVariant();
+
+	// Items hidden while incubating have not evaluated their bindings yet, and a binding
+	// left in place would show them once it is. `visible` is not a bindable property on
+	// items or windows, so its binding is always a QQmlAbstractBinding.
+	auto hidden = HiddenVisibility {
+	    .value = property.read(),
+	    .binding = QQmlAbstractBinding::Ptr(QQmlPropertyPrivate::binding(property)),
+	};
+
+	QQmlPropertyPrivate::removeBinding(property);
+	property.write(false);
+
+	return QVariant::fromValue(hidden);
+}
+
+void LazyLoader::show(QObject* item, const QVariant& visible) {
+	if (!visible.isValid()) return;
+
+	auto hidden = visible.value<HiddenVisibility>();
+
+	if (hidden.binding) {
+		// Evaluated when set, picking up anything that changed while the item was hidden.
+		QQmlPropertyPrivate::setBinding(hidden.binding.data());
+	} else {
+		QQmlProperty::write(item, "visible", hidden.value);
+	}
+}
+
+void LazyLoader::pool(QObject* item, QVariant visible) {
+	if (this->warmItem != nullptr) this->warmItem->deleteLater();
+
+	item->setParent(this);
+	this->warmItem = item;
+	this->warmVisible = std::move(visible);
+
+	qCDebug(logLazyLoader) << "Pooled item" << item << "of" << this;
+	emit this->warmChanged();
+}
+
+QObject* LazyLoader::takeWarmItem() {
+	auto* item = std::exchange(this->warmItem, nullptr);
+	LazyLoader::show(item, std::exchange(this->warmVisible, QVariant()));
+
+	qCDebug(logLazyLoader) << "Reusing pooled item" << item << "of" << this;
+	emit this->warmChanged();
+	return item;
+}
+
+void LazyLoader::clearWarmItem() {
+	if (this->warmItem == nullptr) return;
+
+	this->warmItem->deleteLater();
+	this->warmItem = nullptr;
+	this->warmVisible = QVariant();
+	emit this->warmChanged();
+}
+
+LazyLoaderPrewarmer::LazyLoaderPrewarmer() {
+	this->timer.setInterval(PREWARM_INTERVAL);
+	QObject::connect(&this->timer, &QTimer::timeout, this, &LazyLoaderPrewarmer::onTimeout);
+}
+
+LazyLoaderPrewarmer* LazyLoaderPrewarmer::instance() {
+	static auto* instance = new LazyLoaderPrewarmer(); // NOLINT
+	return instance;
+}
+
+void LazyLoaderPrewarmer::enqueue(LazyLoader* loader) {
+	if (this->queue.contains(loader)) return;
+	this->queue.append(loader);
+	if (!this->timer.isActive()) this->timer.start();
+}
+
+void LazyLoaderPrewarmer::remove(LazyLoader* loader) { this->queue.removeAll(loader); }
+
+void LazyLoaderPrewarmer::finished(LazyLoader* loader) {
+	if (this->current == loader) this->current = nullptr;
+}
+
+bool LazyLoaderPrewarmer::isIdle(LazyLoader* loader) {
+	auto* engine = qmlEngine(loader);
+	if (engine == nullptr) return false;
+
+	auto* controller = engine->incubationController();
+	if (controller == nullptr) return false;
+
+	// Held controllers belong to generations that are still loading or being replaced.
+	auto* qsController = dynamic_cast<QsIncubationController*>(controller);
+	if (qsController != nullptr && qsController->isHeld()) return false;
+
+	return controller->incubatingObjectCount() == 0;
+}
+
+void LazyLoaderPrewarmer::onTimeout() {
+	if (this->current != nullptr) return;
+
+	while (!this->queue.isEmpty()) {
+		auto loader = this->queue.first();
+
+		if (loader == nullptr) {
+			this->queue.removeFirst();
+			continue;
+		}
+
+		if (!LazyLoaderPrewarmer::isIdle(loader)) return;
+
+		this->queue.removeFirst();
+
+		if (loader->startPrewarm()) {
+			this->current = loader;
+			return;
+		}
+	}
+
+	this->timer.stop();
+}
@@ -1,10 +1,16 @@
 #pragma once
 
 #include <QtQml/qqmlcomponent.h>
+#include <qelapsedtimer.h>
+#include <qlist.h>
 #include <qobject.h>
+#include <qpointer.h>
 #include <qqmlincubator.h>
 #include <qqmlintegration.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
+#include <qvariant.h>
 
 #include "incubator.hpp"
 #include "reload.hpp"
@@ -79,12 +85,32 @@
 /// > [!WARNING] Components that internally load other components must explicitly
 /// > support asynchronous loading to avoid blocking.
 /// >
-/// > Notably, @@Variants does not corrently support asynchronous
-/// > loading, meaning using it inside a LazyLoader will block similarly to not
-/// > having a loader to start with.
+/// > Notably, @@Variants always creates its initial instances synchronously,
+/// > even if @@Variants.asynchronous is set, meaning using it inside a LazyLoader
+/// > will block similarly to not having a loader to start with.
 ///
-/// > [!WARNING] LazyLoaders do not start loading before the first window is created,
-/// > meaning if you create all windows inside of lazy loaders, none of them will ever load.
+/// > [!INFO] Asynchronous loading is limited to @@Quickshell.incubationTimeSlice per
+/// > event loop iteration, or a third of the frame time while a window is visible.
+///
+/// #### Keeping popups ready
+/// Popups which are opened often, such as launchers or OSDs, can avoid paying the cost of
+/// creating their component every time they are shown with @@keepWarm and @@prewarm.
+///
+/// ```qml
+/// LazyLoader {
+///   // created in the background once the shell is idle
+///   prewarm: true
+///   // hidden instead of destroyed when closed
+///   keepWarm: true
+///   active: launcherOpen
+///
+///   PanelWindow {
+///     // ...
+///   }
+/// }
+/// ```
+///
+/// @@creationTime can be used to find out which loaders benefit from this.
 class LazyLoader: public Reloadable {
 	Q_OBJECT;
 	/// The fully loaded item if the loader is @@loading or @@active, or `null`
@@ -93,6 +119,8 @@ class LazyLoader: public Reloadable {
 	/// Note that the item is owned by the LazyLoader, and destroying the LazyLoader
 	/// will destroy the item.
 	///
+	/// Items kept in the warm pool by @@keepWarm or @@prewarm are not exposed here.
+	///
 	/// > [!WARNING] If you access the `item` of a loader that is currently loading,
 	/// > it will block as if you had set `active` to true immediately beforehand.
 	/// >
@@ -111,7 +139,7 @@ class LazyLoader: public Reloadable {
 	///
 	/// Setting this property to `true` will force the component to load to completion,
 	/// blocking the UI, and setting it to `false` will destroy the component, requiring
-	/// it to be loaded again.
+	/// it to be loaded again, unless @@keepWarm is set.
 	///
 	/// See also: @@activeAsync.
 	Q_PROPERTY(bool active READ isActive WRITE setActive NOTIFY activeChanged);
@@ -125,6 +153,37 @@ class LazyLoader: public Reloadable {
 	Q_PROPERTY(QQmlComponent* component READ component WRITE setComponent NOTIFY componentChanged);
 	/// The URI to load the component from. Mutually exclusive to @@component.
 	Q_PROPERTY(QString source READ source WRITE setSource NOTIFY sourceChanged);
+	/// If the item should be kept in a warm pool when the loader is deactivated,
+	/// instead of being destroyed. Defaults to false.
+	///
+	/// Activating the loader again reuses the pooled item immediately, without creating
+	/// the component again. The item keeps all of its state while pooled.
+	///
+	/// Pooled items are hidden by setting their `visible` property to false, and it is restored
+	/// when the item is reused. A binding on `visible` is suspended while the item is pooled,
+	/// and is evaluated again when the item is reused.
+	Q_PROPERTY(bool keepWarm READ keepWarm WRITE setKeepWarm NOTIFY keepWarmChanged);
+	/// If the component should be created in the background while the shell is idle,
+	/// and placed in the warm pool until the loader is activated. Defaults to false.
+	///
+	/// Loaders are prewarmed one at a time, only while nothing else is being loaded asynchronously,
+	/// within the same time budget as @@loading. Prewarming does not change @@loading
+	/// or @@active, and activating the loader while it is prewarming finishes the prewarm.
+	/// Prewarmed items are hidden from creation in the same way as pooled items.
+	///
+	/// If @@keepWarm is not set, a new item is prewarmed after the last one is destroyed.
+	Q_PROPERTY(bool prewarm READ prewarm WRITE setPrewarm NOTIFY prewarmChanged);
+	/// If an item is waiting in the warm pool.
+	Q_PROPERTY(bool warm READ isWarm NOTIFY warmChanged);
+	/// The time in milliseconds it took to create the component the last time it was created,
+	/// or -1 if it has not been created yet.
+	///
+	/// For asynchronous loads this includes time spent waiting between frames.
+	/// Reusing a pooled item does not change this value.
+	///
+	/// Creation times are also logged by the `quickshell.lazyloader` logging category
+	/// at the info level.
+	Q_PROPERTY(qreal creationTime READ creationTime NOTIFY creationTimeChanged);
 	Q_CLASSINFO("DefaultProperty", "component");
 	QML_ELEMENT;
 
@@ -147,22 +206,49 @@ public:
 	[[nodiscard]] QString source() const;
 	void setSource(QString source);
 
+	[[nodiscard]] bool keepWarm() const;
+	void setKeepWarm(bool keepWarm);
+
+	[[nodiscard]] bool prewarm() const;
+	void setPrewarm(bool prewarm);
+
+	[[nodiscard]] bool isWarm() const;
+	[[nodiscard]] qreal creationTime() const;
+
 signals:
 	void activeChanged();
 	void loadingChanged();
 	void itemChanged();
 	void sourceChanged();
 	void componentChanged();
+	void keepWarmChanged();
+	void prewarmChanged();
+	void warmChanged();
+	void creationTimeChanged();
 
 private slots:
 	void onIncubationCompleted();
 	void onIncubationFailed();
 	void onComponentDestroyed();
+	void onPrewarmInitialState(QObject* object);
 
 private:
 	void incubateIfReady(bool overrideReloadCheck = false);
+	void startIncubation(QQmlIncubator::IncubationMode mode);
 	void waitForObjectCreation();
 
+	void updatePrewarm(bool overrideReloadCheck = false);
+	// Called by LazyLoaderPrewarmer. Returns true if prewarming is still in progress.
+	bool startPrewarm();
+	void cancelPrewarm();
+
+	void pool(QObject* item, QVariant visible);
+	QObject* takeWarmItem();
+	void clearWarmItem();
+	// The returned value restores the item's visibility when passed to show().
+	static QVariant hide(QObject* item);
+	static void show(QObject* item, const QVariant& visible);
+
 	bool targetLoading = false;
 	bool targetActive = false;
 	QObject* mItem = nullptr;
@@ -170,4 +256,42 @@ private:
 	QQmlComponent* mComponent = nullptr;
 	QsQmlIncubator* incubator = nullptr;
 	bool cleanupComponent = false;
+
+	bool mKeepWarm = false;
+	bool mPrewarm = false;
+	bool prewarming = false;
+	bool prewarmFailed = false;
+	// Visibility of the item being prewarmed before it was hidden.
+	QVariant prewarmVisible;
+	QObject* warmItem = nullptr;
+	QVariant warmVisible;
+	QElapsedTimer creationTimer;
+	qreal mCreationTime = -1;
+
+	friend class LazyLoaderPrewarmer;
+};
+
+// Prewarms LazyLoaders one at a time, while the engine is not incubating anything else.
+class LazyLoaderPrewarmer: public QObject {
+	Q_OBJECT;
+
+public:
+	static LazyLoaderPrewarmer* instance();
+
+	void enqueue(LazyLoader* loader);
+	void remove(LazyLoader* loader);
+	// Called by a loader when its prewarm is finished, failed or taken over by a normal load.
+	void finished(LazyLoader* loader);
+
+private slots:
+	void onTimeout();
+
+private:
+	explicit LazyLoaderPrewarmer();
+
+	static bool isIdle(LazyLoader* loader);
+
+	QList<QPointer<LazyLoader>> queue;
+	QPointer<LazyLoader> current;
+	QTimer timer;
 };
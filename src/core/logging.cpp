@@ -8,7 +8,6 @@
 #include <qcoreapplication.h>
 #include <qdatetime.h>
 #include <qendian.h>
-#include <qfilesystemwatcher.h>
 #include <qhash.h>
 #include <qhashfunctions.h>
 #include <qlist.h>
@@ -911,7 +910,7 @@ bool LogFollower::follow() {
 
 	QObject::connect(
 	    &this->fileWatcher,
-	    &QFileSystemWatcher::fileChanged,
+	    &FileWatch::fileChanged,
 	    this,
 	    &LogFollower::onFileChanged
 	);
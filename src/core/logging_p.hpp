@@ -4,13 +4,13 @@
 #include <qbytearrayview.h>
 #include <qcontainerfwd.h>
 #include <qfile.h>
-#include <qfilesystemwatcher.h>
 #include <qlogging.h>
 #include <qobject.h>
 #include <qthread.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
+#include "filewatch.hpp"
 #include "logging.hpp"
 #include "logging_qtprivate.hpp"
 #include "ringbuf.hpp"
@@ -171,7 +171,7 @@ private slots:
 private:
 	LogReader* reader;
 	QString path;
-	QFileSystemWatcher fileWatcher;
+	FileWatch fileWatcher;
 
 	class FcntlWaitThread: public QThread {
 	public:
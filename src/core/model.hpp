@@ -94,6 +94,30 @@ public:
 		emit this->objectInsertedPost(object, iindex);
 	}
 
+	// Appends all objects as a single row insertion.
+	void insertObjects(const QList<T*>& objects) {
+		if (objects.isEmpty()) return;
+
+		auto first = this->mValuesList.length();
+		for (qsizetype i = 0; i != objects.length(); i++) {
+			emit this->objectInsertedPre(objects.at(i), first + i);
+		}
+
+		this->beginInsertRows(
+		    QModelIndex(),
+		    static_cast<qint32>(first),
+		    static_cast<qint32>(first + objects.length() - 1)
+		);
+		this->mValuesList.append(objects);
+		this->endInsertRows();
+
+		emit this->valuesChanged();
+
+		for (qsizetype i = 0; i != objects.length(); i++) {
+			emit this->objectInsertedPost(objects.at(i), first + i);
+		}
+	}
+
 	void insertObjectSorted(T* object, const std::function<bool(T*, T*)>& compare) {
 		auto& list = this->valueList();
 		auto iter = list.begin();
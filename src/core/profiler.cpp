@@ -0,0 +1,329 @@
+#include "profiler.hpp"
+#include <algorithm>
+#include <utility>
+
+#include <private/qv4engine_p.h>
+#include <private/qv4profiling_p.h>
+#include <qanystringview.h>
+#include <qcontainerfwd.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qlatin1stringview.h>
+#include <qlist.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qmutex.h>
+#include <qobject.h>
+#include <qqmlengine.h>
+#include <qstring.h>
+#include <qtextstream.h>
+#include <qtypes.h>
+#include <qurl.h>
+
+#include "generation.hpp"
+#include "logcat.hpp"
+#include "paths.hpp"
+
+namespace {
+QS_LOGGING_CATEGORY(logProfiler, "quickshell.profiler", QtWarningMsg);
+
+// Marks V4 profilers created by QsProfiler, as an engine's profiler cannot be replaced
+// and may instead belong to the QML debug service.
+constexpr auto PROFILER_NAME = QLatin1StringView("quickshell-profiler");
+
+// V4 profiler data is collected at this interval to bound its memory use.
+constexpr int FLUSH_INTERVAL = 1000;
+
+QString formatMs(qint64 ns) { return QString::number(static_cast<double>(ns) / 1e6, 'f', 3); }
+} // namespace
+
+QsProfiler::QsProfiler() {
+	this->flushTimer.setInterval(FLUSH_INTERVAL);
+	QObject::connect(&this->flushTimer, &QTimer::timeout, this, &QsProfiler::onFlushTimeout);
+}
+
+QsProfiler* QsProfiler::instance() {
+	static auto* instance = new QsProfiler(); // NOLINT
+	return instance;
+}
+
+bool QsProfiler::start(QString* message) {
+	if (this->isRunning()) {
+		*message = "The profiler is already running.";
+		return false;
+	}
+
+	this->frames.clear();
+	this->stacks.clear();
+	this->locationStats.clear();
+
+	{
+		auto locker = QMutexLocker(&this->eventMutex);
+		this->events.clear();
+	}
+
+	this->clock.start();
+	if (!this->attach(message)) return false;
+
+	this->running.storeRelaxed(true);
+	this->flushTimer.start();
+
+	qCInfo(logProfiler) << "Started profiling.";
+	return true;
+}
+
+bool QsProfiler::stop(QString* message) {
+	if (!this->isRunning()) {
+		*message = "The profiler is not running.";
+		return false;
+	}
+
+	this->flushTimer.stop();
+	this->detach();
+	this->running.storeRelaxed(false);
+
+	qCInfo(logProfiler) << "Stopped profiling after" << this->clock.elapsed() << "ms.";
+	return this->write(message);
+}
+
+void QsProfiler::recordEvent(QLatin1StringView subsystem, QAnyStringView name) {
+	auto key = QString(subsystem);
+	key += ';';
+	key += name.toString();
+
+	auto locker = QMutexLocker(&this->eventMutex);
+	this->events[key]++;
+}
+
+bool QsProfiler::attach(QString* error) {
+	auto* generation = EngineGeneration::currentGeneration();
+
+	if (!generation || !generation->engine) {
+		*error = "No configuration is currently loaded.";
+		return false;
+	}
+
+	auto* engine = generation->engine;
+
+#if QT_CONFIG(qml_debug)
+	auto* v4 = engine->handle();
+	auto* profiler = v4->profiler();
+
+	if (!profiler) {
+		profiler = new QV4::Profiling::Profiler(v4);
+		profiler->setObjectName(PROFILER_NAME);
+		// Owned by the engine from here on.
+		v4->setProfiler(profiler);
+	} else if (profiler->objectName() != PROFILER_NAME) {
+		*error = "The QML engine is already being profiled by the QML debugger.";
+		return false;
+	}
+
+	profiler->setTimer(this->clock);
+
+	QObject::connect(
+	    profiler,
+	    &QV4::Profiling::Profiler::dataReady,
+	    this,
+	    [this](
+	        const QV4::Profiling::FunctionLocationHash& locations,
+	        const QVector<QV4::Profiling::FunctionCallProperties>& calls,
+	        const QVector<QV4::Profiling::MemoryAllocationProperties>& /*allocations*/
+	    ) {
+		    for (const auto& [id, location]: locations.asKeyValueRange()) {
+			    this->addFrame(id, location.name, location.file, location.line);
+		    }
+
+		    auto list = QList<Call>();
+		    list.reserve(calls.length());
+
+		    for (const auto& call: calls) {
+			    list.append({.start = call.start, .end = call.end, .id = call.id});
+		    }
+
+		    this->addCalls(std::move(list));
+	    },
+	    Qt::DirectConnection
+	);
+
+	profiler->startProfiling(1 << QV4::Profiling::FeatureFunctionCall);
+	this->engineProfiler = profiler;
+#else
+	qCWarning(logProfiler) << "Qt was built without QML debugging support. Only events will be "
+	                          "profiled.";
+#endif
+
+	this->engine = engine;
+	return true;
+}
+
+void QsProfiler::detach() {
+#if QT_CONFIG(qml_debug)
+	if (auto* profiler = qobject_cast<QV4::Profiling::Profiler*>(this->engineProfiler)) {
+		// Reports all remaining calls through dataReady.
+		profiler->stopProfiling();
+		QObject::disconnect(profiler, nullptr, this, nullptr);
+	}
+#endif
+
+	this->engine = nullptr;
+	this->engineProfiler = nullptr;
+}
+
+void QsProfiler::onFlushTimeout() {
+	auto* generation = EngineGeneration::currentGeneration();
+	auto* engine = generation ? generation->engine : nullptr;
+
+	if (engine != this->engine.data()) {
+		// The configuration was reloaded. Calls made by the old engine since the last
+		// flush are lost if it has already been destroyed.
+		this->detach();
+
+		auto error = QString();
+		if (engine && !this->attach(&error)) {
+			qCWarning(logProfiler) << "Could not profile the reloaded configuration:" << error;
+		}
+
+		return;
+	}
+
+#if QT_CONFIG(qml_debug)
+	if (auto* profiler = qobject_cast<QV4::Profiling::Profiler*>(this->engineProfiler)) {
+		profiler->reportData();
+	}
+#endif
+}
+
+void QsProfiler::addFrame(quintptr id, const QString& name, const QString& file, int line) {
+	auto url = QUrl(file);
+	auto path = url.isLocalFile() ? url.toLocalFile() : file;
+
+	auto frame = QString("%1 (%2:%3)")
+	                 .arg(name.isEmpty() ? QStringLiteral("<anonymous>") : name, path)
+	                 .arg(line);
+
+	// separates frames in the folded format
+	frame.replace(';', ':');
+
+	this->frames.insert(id, frame);
+}
+
+void QsProfiler::addCalls(QList<Call> calls) {
+	// Calls are reported as they return, so callees are listed before their callers.
+	// Each batch is reported from the event loop, with no javascript on the stack,
+	// so every call's callees are in the same batch.
+	std::ranges::sort(calls, [](const Call& a, const Call& b) {
+		return a.start != b.start ? a.start < b.start : a.end > b.end;
+	});
+
+	struct Frame {
+		qint64 end = 0;
+		QString stack;
+		QString frame;
+	};
+
+	auto callStack = QList<Frame>();
+
+	for (const auto& call: calls) {
+		while (!callStack.isEmpty() && callStack.last().end <= call.start) {
+			callStack.removeLast();
+		}
+
+		auto frame = this->frames.value(call.id, QStringLiteral("<unknown>"));
+		auto stack = callStack.isEmpty() ? frame : callStack.last().stack + ';' + frame;
+		auto duration = call.end - call.start;
+
+		this->stacks[stack] += duration;
+
+		auto& stats = this->locationStats[frame];
+		stats.calls++;
+		stats.totalNs += duration;
+		stats.selfNs += duration;
+
+		if (!callStack.isEmpty()) {
+			const auto& caller = callStack.last();
+			this->stacks[caller.stack] -= duration;
+			this->locationStats[caller.frame].selfNs -= duration;
+		}
+
+		callStack.append({.end = call.end, .stack = stack, .frame = frame});
+	}
+}
+
+bool QsProfiler::write(QString* message) {
+	auto* runDir = QsPaths::instance()->instanceRunDir();
+
+	if (!runDir) {
+		*message = "The profile could not be written as the runtime directory could not be created.";
+		return false;
+	}
+
+	auto foldedPath = runDir->filePath("profile.folded");
+	auto summaryPath = runDir->filePath("profile.txt");
+
+	auto foldedFile = QFile(foldedPath);
+	auto summaryFile = QFile(summaryPath);
+
+	if (!foldedFile.open(QFile::WriteOnly | QFile::Truncate)
+	    || !summaryFile.open(QFile::WriteOnly | QFile::Truncate))
+	{
+		*message = "The profile could not be written to " + runDir->path();
+		return false;
+	}
+
+	{
+		// flamegraph tools expect integer sample counts, so weights are in microseconds.
+		auto stream = QTextStream(&foldedFile);
+
+		for (const auto& [stack, ns]: this->stacks.asKeyValueRange()) {
+			auto us = ns / 1000;
+			if (us > 0) stream << stack << ' ' << us << '\n';
+		}
+	}
+
+	{
+		auto stream = QTextStream(&summaryFile);
+		stream << "Profiled for " << this->clock.elapsed() << "ms.\n\n";
+
+		auto stats = QList<std::pair<QString, LocationStats>>();
+		stats.reserve(this->locationStats.size());
+
+		for (const auto& [frame, stat]: this->locationStats.asKeyValueRange()) {
+			stats.append({frame, stat});
+		}
+
+		std::ranges::sort(stats, [](const auto& a, const auto& b) {
+			return a.second.selfNs > b.second.selfNs;
+		});
+
+		stream << "Javascript functions and bindings by self time:\n";
+		stream << "  calls\ttotal ms\tself ms\tfunction (file:line)\n";
+
+		for (const auto& [frame, stat]: stats) {
+			stream << "  " << stat.calls << '\t' << formatMs(stat.totalNs) << '\t'
+			       << formatMs(stat.selfNs) << '\t' << frame << '\n';
+		}
+
+		auto events = QList<std::pair<QString, quint64>>();
+
+		{
+			auto locker = QMutexLocker(&this->eventMutex);
+
+			for (const auto& [name, count]: this->events.asKeyValueRange()) {
+				events.append({name, count});
+			}
+		}
+
+		std::ranges::sort(events, [](const auto& a, const auto& b) { return a.second > b.second; });
+
+		stream << "\nEvents by count:\n";
+
+		for (const auto& [name, count]: events) {
+			stream << "  " << count << '\t' << name << '\n';
+		}
+	}
+
+	qCInfo(logProfiler) << "Saved profile to" << foldedPath << "and" << summaryPath;
+	*message = foldedPath;
+	return true;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <qanystringview.h>
+#include <qatomic.h>
+#include <qcontainerfwd.h>
+#include <qelapsedtimer.h>
+#include <qhash.h>
+#include <qlatin1stringview.h>
+#include <qmutex.h>
+#include <qobject.h>
+#include <qpointer.h>
+#include <qstring.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+
+// Built-in profiler, started and stopped at runtime with `qs profile`.
+//
+// While running, javascript function calls made by the current generation's engine are
+// recorded through the V4 engine profiler, which includes binding evaluations and signal
+// handlers, and subsystems report the events they handle through countEvent.
+//
+// Stopping the profiler writes `profile.folded`, in the folded stack format read by
+// flamegraph tools, and a `profile.txt` summary of time per file:line and event counts
+// into the instance run dir.
+class QsProfiler: public QObject {
+	Q_OBJECT;
+
+public:
+	static QsProfiler* instance();
+
+	// Both return false and set message to an error on failure.
+	// On success stop sets message to the path of the written folded stack file.
+	bool start(QString* message);
+	bool stop(QString* message);
+
+	[[nodiscard]] bool isRunning() const { return this->running.loadRelaxed(); }
+
+	// Counts an event handled by a subsystem, such as a Hyprland event or a D-Bus signal.
+	// Does nothing unless the profiler is running. Safe to call from any thread.
+	static void countEvent(QLatin1StringView subsystem, QAnyStringView name) {
+		auto* profiler = QsProfiler::instance();
+		if (profiler->running.loadRelaxed()) profiler->recordEvent(subsystem, name);
+	}
+
+private slots:
+	void onFlushTimeout();
+
+private:
+	explicit QsProfiler();
+
+	struct LocationStats {
+		quint64 calls = 0;
+		qint64 totalNs = 0;
+		qint64 selfNs = 0;
+	};
+
+	struct Call {
+		qint64 start = 0;
+		qint64 end = 0;
+		quintptr id = 0;
+	};
+
+	void recordEvent(QLatin1StringView subsystem, QAnyStringView name);
+
+	bool attach(QString* error);
+	void detach();
+	void addFrame(quintptr id, const QString& name, const QString& file, int line);
+	void addCalls(QList<Call> calls);
+	bool write(QString* message);
+
+	QAtomicInteger<bool> running = false;
+	QElapsedTimer clock;
+	QTimer flushTimer;
+
+	// Held as QObjects as this header is used by modules without QtQml.
+	QPointer<QObject> engine;
+	QPointer<QObject> engineProfiler;
+
+	// Frame names keyed by V4 function id.
+	QHash<quintptr, QString> frames;
+	// Self time in nanoseconds keyed by folded stack.
+	QHash<QString, qint64> stacks;
+	QHash<QString, LocationStats> locationStats;
+
+	QMutex eventMutex;
+	QHash<QString, quint64> events;
+};
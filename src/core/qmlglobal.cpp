@@ -11,7 +11,6 @@
 #include <qlist.h>
 #include <qlogging.h>
 #include <qobject.h>
-#include <qprocess.h>
 #include <qqmlcontext.h>
 #include <qqmlengine.h>
 #include <qqmllist.h>
@@ -26,6 +25,7 @@
 #include "../io/processcore.hpp"
 #include "generation.hpp"
 #include "iconimageprovider.hpp"
+#include "incubator.hpp"
 #include "paths.hpp"
 #include "qmlscreen.hpp"
 #include "rootwrapper.hpp"
@@ -48,7 +48,11 @@ QuickshellSettings* QuickshellSettings::instance() {
 	return instance;
 }
 
-void QuickshellSettings::reset() { QuickshellSettings::instance()->mWatchFiles = true; }
+void QuickshellSettings::reset() {
+	auto* settings = QuickshellSettings::instance();
+	settings->mWatchFiles = true;
+	settings->setIncubationTimeSlice(5);
+}
 
 QString QuickshellSettings::workingDirectory() const { // NOLINT
 	return QDir::current().absolutePath();
@@ -67,6 +71,15 @@ void QuickshellSettings::setWatchFiles(bool watchFiles) {
 	emit this->watchFilesChanged();
 }
 
+qint32 QuickshellSettings::incubationTimeSlice() const { return this->mIncubationTimeSlice; }
+
+void QuickshellSettings::setIncubationTimeSlice(qint32 incubationTimeSlice) {
+	if (incubationTimeSlice < 1) incubationTimeSlice = 1;
+	if (incubationTimeSlice == this->mIncubationTimeSlice) return;
+	this->mIncubationTimeSlice = incubationTimeSlice;
+	emit this->incubationTimeSliceChanged();
+}
+
 QuickshellTracked::QuickshellTracked() {
 	auto* app = QCoreApplication::instance();
 	auto* guiApp = qobject_cast<QGuiApplication*>(app);
@@ -133,6 +146,7 @@ QuickshellGlobal::QuickshellGlobal(QObject* parent): QObject(parent) {
 	// clang-format off
 	QObject::connect(QuickshellSettings::instance(), &QuickshellSettings::workingDirectoryChanged, this, &QuickshellGlobal::workingDirectoryChanged);
 	QObject::connect(QuickshellSettings::instance(), &QuickshellSettings::watchFilesChanged, this, &QuickshellGlobal::watchFilesChanged);
+	QObject::connect(QuickshellSettings::instance(), &QuickshellSettings::incubationTimeSliceChanged, this, &QuickshellGlobal::incubationTimeSliceChanged);
 	QObject::connect(QuickshellSettings::instance(), &QuickshellSettings::lastWindowClosed, this, &QuickshellGlobal::lastWindowClosed);
 
 	QObject::connect(QuickshellTracked::instance(), &QuickshellTracked::screensChanged, this, &QuickshellGlobal::screensChanged);
@@ -196,6 +210,23 @@ void QuickshellGlobal::setWatchFiles(bool watchFiles) { // NOLINT
 	QuickshellSettings::instance()->setWatchFiles(watchFiles);
 }
 
+qint32 QuickshellGlobal::incubationTimeSlice() const { // NOLINT
+	return QuickshellSettings::instance()->incubationTimeSlice();
+}
+
+void QuickshellGlobal::setIncubationTimeSlice(qint32 incubationTimeSlice) { // NOLINT
+	QuickshellSettings::instance()->setIncubationTimeSlice(incubationTimeSlice);
+}
+
+qint32 QuickshellGlobal::incubatingObjects() const {
+	return this->incubationController == nullptr ? 0
+	                                             : this->incubationController->incubatingObjectCount();
+}
+
+qreal QuickshellGlobal::incubationTime() const {
+	return this->incubationController == nullptr ? 0 : this->incubationController->timeSpent();
+}
+
 QString QuickshellGlobal::clipboardText() {
 	return static_cast<QGuiApplication*>(QGuiApplication::instance())->clipboard()->text(); // NOLINT
 }
@@ -277,27 +308,24 @@ void QuickshellGlobal::execDetached(const qs::io::process::ProcessContext& conte
 		return;
 	}
 
-	const auto& cmd = context.command.first();
-	auto args = context.command.sliced(1);
-
-	QProcess process;
-	qs::io::process::setupProcessEnvironment(&process, context.clearEnvironment, context.environment);
-
-	if (!context.workingDirectory.isEmpty()) {
-		process.setWorkingDirectory(context.workingDirectory);
-	}
-
-	process.setProgram(cmd);
-	process.setArguments(args);
-
-	process.setStandardInputFile(QProcess::nullDevice());
-
-	if (context.unbindStdout) {
-		process.setStandardOutputFile(QProcess::nullDevice());
-		process.setStandardErrorFile(QProcess::nullDevice());
+	using qs::io::process::StdioMode;
+	auto outputMode = context.unbindStdout ? StdioMode::Null : StdioMode::Inherit;
+
+	auto options = qs::io::process::SpawnOptions {
+	    .program = context.command.first(),
+	    .arguments = context.command.sliced(1),
+	    .workingDirectory = context.workingDirectory,
+	    .environment =
+	        qs::io::process::processEnvironment(context.clearEnvironment, context.environment),
+	    .stdoutMode = outputMode,
+	    .stderrMode = outputMode,
+	    .newSession = true,
+	};
+
+	auto error = QString();
+	if (!qs::io::process::ChildProcess::startDetached(options, &error)) {
+		qWarning() << "Failed to start detached process:" << error;
 	}
-
-	process.startDetached();
 }
 
 QString QuickshellGlobal::iconPath(const QString& icon) {
@@ -321,5 +349,13 @@ QuickshellGlobal* QuickshellGlobal::create(QQmlEngine* engine, QJSEngine* /*unus
 		generation->qsgInstance = qsg;
 	}
 
+	auto* controller = &generation->incubationController;
+	qsg->incubationController = controller;
+
+	// clang-format off
+	QObject::connect(controller, &QsIncubationController::queueDepthChanged, qsg, &QuickshellGlobal::incubatingObjectsChanged);
+	QObject::connect(controller, &QsIncubationController::timeSpentChanged, qsg, &QuickshellGlobal::incubationTimeChanged);
+	// clang-format on
+
 	return qsg;
 }
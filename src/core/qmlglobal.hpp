@@ -17,6 +17,7 @@
 
 #include "../io/processcore.hpp"
 #include "doc.hpp"
+#include "incubator.hpp"
 #include "qmlscreen.hpp"
 
 ///! Accessor for some options under the Quickshell type.
@@ -28,6 +29,8 @@ class QuickshellSettings: public QObject {
 	/// If true then the configuration will be reloaded whenever any files change.
 	/// Defaults to true.
 	Q_PROPERTY(bool watchFiles READ watchFiles WRITE setWatchFiles NOTIFY watchFilesChanged);
+	/// See @@Quickshell.incubationTimeSlice.
+	Q_PROPERTY(qint32 incubationTimeSlice READ incubationTimeSlice WRITE setIncubationTimeSlice NOTIFY incubationTimeSliceChanged);
 	// clang-format on
 	QML_ELEMENT;
 	QML_UNCREATABLE("singleton");
@@ -41,6 +44,9 @@ public:
 	[[nodiscard]] bool watchFiles() const;
 	void setWatchFiles(bool watchFiles);
 
+	[[nodiscard]] qint32 incubationTimeSlice() const;
+	void setIncubationTimeSlice(qint32 incubationTimeSlice);
+
 	[[nodiscard]] bool quitOnLastClosed() const;
 	void setQuitOnLastClosed(bool exitOnLastClosed);
 
@@ -55,9 +61,11 @@ signals:
 
 	void workingDirectoryChanged();
 	void watchFilesChanged();
+	void incubationTimeSliceChanged();
 
 private:
 	bool mWatchFiles = true;
+	qint32 mIncubationTimeSlice = 5;
 };
 
 class QuickshellTracked: public QObject {
@@ -118,6 +126,17 @@ class QuickshellGlobal: public QObject {
 	/// If true then the configuration will be reloaded whenever any files change.
 	/// Defaults to true.
 	Q_PROPERTY(bool watchFiles READ watchFiles WRITE setWatchFiles NOTIFY watchFilesChanged);
+	/// The longest time in milliseconds spent creating asynchronously loaded objects, such as
+	/// those of @@LazyLoader or @@Variants, per event loop iteration. Defaults to 5.
+	///
+	/// While a window is visible, objects are created after its frames are rendered instead,
+	/// using at most a third of the frame time.
+	Q_PROPERTY(qint32 incubationTimeSlice READ incubationTimeSlice WRITE setIncubationTimeSlice NOTIFY incubationTimeSliceChanged);
+	/// The number of asynchronously loaded objects waiting to be created.
+	Q_PROPERTY(qint32 incubatingObjects READ incubatingObjects NOTIFY incubatingObjectsChanged);
+	/// The total time in milliseconds spent creating asynchronously loaded objects
+	/// since the last reload.
+	Q_PROPERTY(qreal incubationTime READ incubationTime NOTIFY incubationTimeChanged);
 	/// The system clipboard.
 	///
 	/// > [!WARNING] Under wayland the clipboard will be empty unless a quickshell window is focused.
@@ -231,6 +250,12 @@ public:
 	[[nodiscard]] bool watchFiles() const;
 	void setWatchFiles(bool watchFiles);
 
+	[[nodiscard]] qint32 incubationTimeSlice() const;
+	void setIncubationTimeSlice(qint32 incubationTimeSlice);
+
+	[[nodiscard]] qint32 incubatingObjects() const;
+	[[nodiscard]] qreal incubationTime() const;
+
 	[[nodiscard]] static QString clipboardText();
 	static void setClipboardText(const QString& text);
 
@@ -253,6 +278,9 @@ signals:
 	void screensChanged();
 	void workingDirectoryChanged();
 	void watchFilesChanged();
+	void incubationTimeSliceChanged();
+	void incubatingObjectsChanged();
+	void incubationTimeChanged();
 	void clipboardTextChanged();
 
 private slots:
@@ -262,6 +290,7 @@ private:
 	QuickshellGlobal(QObject* parent = nullptr);
 
 	bool mInhibitReloadPopup = false;
+	QsIncubationController* incubationController = nullptr;
 
 	static qsizetype screensCount(QQmlListProperty<QuickshellScreenInfo>* prop);
 	static QuickshellScreenInfo* screenAt(QQmlListProperty<QuickshellScreenInfo>* prop, qsizetype i);
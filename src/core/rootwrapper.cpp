@@ -4,7 +4,6 @@
 
 #include <qdir.h>
 #include <qfileinfo.h>
-#include <qfilesystemwatcher.h>
 #include <qlogging.h>
 #include <qobject.h>
 #include <qqmlcomponent.h>
@@ -15,10 +14,12 @@
 
 #include "../ui/reload_popup.hpp"
 #include "../window/floatingwindow.hpp"
+#include "filewatch.hpp"
 #include "generation.hpp"
 #include "instanceinfo.hpp"
 #include "qmlglobal.hpp"
 #include "scan.hpp"
+#include "startuptrace.hpp"
 #include "toolsupport.hpp"
 
 RootWrapper::RootWrapper(QString rootPath, QString shellId)
@@ -35,7 +36,7 @@ RootWrapper::RootWrapper(QString rootPath, QString shellId)
 
 	QObject::connect(
 	    &this->configDirWatcher,
-	    &QFileSystemWatcher::directoryChanged,
+	    &FileWatch::directoryChanged,
 	    this,
 	    &RootWrapper::updateTooling
 	);
@@ -55,16 +56,20 @@ RootWrapper::~RootWrapper() {
 }
 
 void RootWrapper::reloadGraph(bool hard) {
+	StartupTrace::loadStarted();
+
 	auto rootFile = QFileInfo(this->rootPath);
 	auto rootPath = rootFile.dir();
 	auto scanner = QmlScanner(rootPath);
 	scanner.scanQmlRoot(this->rootPath);
+	StartupTrace::mark("scan");
 
 	qs::core::QmlToolingSupport::updateTooling(rootPath, scanner);
 	this->configDirWatcher.addPath(rootPath.path());
 
 	auto* generation = new EngineGeneration(rootPath, std::move(scanner));
 	generation->wrapper = this;
+	StartupTrace::mark("engine");
 
 	// todo: move into EngineGeneration
 	if (this->generation != nullptr) {
@@ -96,6 +101,7 @@ void RootWrapper::reloadGraph(bool hard) {
 
 		auto newFiles = generation->scanner.scannedFiles;
 		generation->destroy();
+		StartupTrace::loadFailed();
 
 		if (this->generation != nullptr) {
 			if (this->generation->setExtraWatchedFiles(newFiles)) {
@@ -120,6 +126,7 @@ void RootWrapper::reloadGraph(bool hard) {
 		return;
 	}
 
+	StartupTrace::mark("compile");
 	auto* newRoot = component.beginCreate(generation->engine->rootContext());
 
 	if (auto* item = qobject_cast<QQuickItem*>(newRoot)) {
@@ -134,6 +141,7 @@ void RootWrapper::reloadGraph(bool hard) {
 	generation->root = newRoot;
 
 	component.completeCreate();
+	StartupTrace::mark("instantiate");
 
 	if (this->generation) {
 		QObject::disconnect(this->generation, nullptr, this, nullptr);
@@ -149,6 +157,7 @@ void RootWrapper::reloadGraph(bool hard) {
 	this->generation = generation;
 
 	qInfo() << "Configuration Loaded";
+	StartupTrace::configLoaded(&this->generation->incubationController);
 
 	QObject::connect(this->generation, &QObject::destroyed, this, &RootWrapper::generationDestroyed);
 	QObject::connect(
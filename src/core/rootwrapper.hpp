@@ -1,12 +1,12 @@
 #pragma once
 
-#include <qfilesystemwatcher.h>
 #include <qobject.h>
 #include <qqmlengine.h>
 #include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
 #include <qurl.h>
 
+#include "filewatch.hpp"
 #include "generation.hpp"
 
 class RootWrapper: public QObject {
@@ -30,5 +30,5 @@ private:
 	QString shellId;
 	EngineGeneration* generation = nullptr;
 	QString originalWorkingDirectory;
-	QFileSystemWatcher configDirWatcher;
+	FileWatch configDirWatcher;
 };
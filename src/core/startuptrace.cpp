@@ -0,0 +1,213 @@
+#include "startuptrace.hpp"
+#include <algorithm>
+
+#include <qcoreapplication.h>
+#include <qdir.h>
+#include <qelapsedtimer.h>
+#include <qfile.h>
+#include <qjsonarray.h>
+#include <qjsondocument.h>
+#include <qjsonobject.h>
+#include <qjsonvalue.h>
+#include <qlist.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qpointer.h>
+#include <qquickwindow.h>
+#include <qsavefile.h>
+#include <qstring.h>
+#include <qtimer.h>
+#include <qtypes.h>
+
+#include "incubator.hpp"
+#include "instanceinfo.hpp"
+#include "logcat.hpp"
+#include "paths.hpp"
+
+namespace {
+QS_LOGGING_CATEGORY(logStartup, "quickshell.startup", QtWarningMsg);
+
+// Windows that have not drawn this long after the configuration loaded are left undrawn.
+constexpr int WINDOW_TIMEOUT = 10000;
+
+struct TracePhase {
+	QString name;
+	qint64 time = 0;
+};
+
+struct TraceWindow {
+	// Only used to avoid tracking a window twice.
+	QQuickWindow* window = nullptr;
+	QString name;
+	qint64 firstFrame = -1;
+};
+
+struct TraceState {
+	TraceState() { this->clock.start(); }
+
+	QElapsedTimer clock;
+	QList<TracePhase> phases;
+	QList<TraceWindow> windows;
+	// Number of phases recorded before the current load attempt.
+	qsizetype loadStart = 0;
+	// Windows created by incubation may still be shown while it is pending.
+	QPointer<QsIncubationController> incubation;
+	bool loaded = false;
+	bool updateQueued = false;
+	bool complete = false;
+};
+
+// Constructed during static initialization so the clock starts as early as possible.
+TraceState STATE; // NOLINT
+
+double toMs(qint64 ns) { return static_cast<double>(ns) / 1e6; }
+
+void writeTrace() {
+	auto* runDir = QsPaths::instance()->instanceRunDir();
+	if (!runDir) return;
+
+	auto phases = QJsonArray();
+	auto total = STATE.phases.isEmpty() ? 0 : STATE.phases.last().time;
+
+	for (const auto& phase: STATE.phases) {
+		phases.append(QJsonObject {{"name", phase.name}, {"time", toMs(phase.time)}});
+	}
+
+	auto windows = QJsonArray();
+
+	for (const auto& window: STATE.windows) {
+		auto firstFrame = window.firstFrame == -1 ? QJsonValue() : QJsonValue(toMs(window.firstFrame));
+		windows.append(QJsonObject {{"name", window.name}, {"firstFrame", firstFrame}});
+		total = std::max(total, window.firstFrame);
+	}
+
+	auto json = QJsonObject {
+	    {"instanceId", InstanceInfo::CURRENT.instanceId},
+	    {"complete", STATE.complete},
+	    {"phases", phases},
+	    {"windows", windows},
+	    {"total", toMs(total)},
+	};
+
+	// Written atomically as `qs startup` may read the trace while it is being updated.
+	auto path = runDir->filePath("startup.json");
+	auto file = QSaveFile(path);
+
+	if (!file.open(QFile::WriteOnly)) {
+		qCWarning(logStartup) << "Could not open startup trace" << path << "for writing.";
+		return;
+	}
+
+	file.write(QJsonDocument(json).toJson());
+
+	if (!file.commit()) {
+		qCWarning(logStartup) << "Could not write startup trace" << path;
+	}
+}
+
+void update() {
+	STATE.updateQueued = false;
+	if (!STATE.loaded || STATE.complete) return;
+
+	auto drawn = std::ranges::all_of(STATE.windows, [](const TraceWindow& window) {
+		return window.firstFrame != -1;
+	});
+
+	// Checked even if no windows have been shown yet, as incubated objects may show them.
+	auto incubating = STATE.incubation && STATE.incubation->incubatingObjectCount() != 0;
+
+	STATE.complete = drawn && !incubating;
+
+	if (STATE.complete) qCInfo(logStartup) << "Startup trace completed.";
+
+	writeTrace();
+}
+
+// Deferred to the event loop so windows shown by the same change are tracked first.
+void queueUpdate() {
+	if (STATE.updateQueued) return;
+	STATE.updateQueued = true;
+	QMetaObject::invokeMethod(QCoreApplication::instance(), &update, Qt::QueuedConnection);
+}
+
+void onFirstFrame(qsizetype index, qint64 time) {
+	if (STATE.complete) return;
+	STATE.windows[index].firstFrame = time;
+	queueUpdate();
+}
+
+} // namespace
+
+void StartupTrace::mark(const QString& phase) {
+	if (STATE.loaded) return;
+	STATE.phases.append({.name = phase, .time = STATE.clock.nsecsElapsed()});
+}
+
+bool StartupTrace::isTracing() { return !STATE.complete; }
+
+void StartupTrace::trackWindow(QQuickWindow* window, const QString& name) {
+	if (STATE.complete) return;
+
+	auto tracked = std::ranges::any_of(STATE.windows, [window](const TraceWindow& traced) {
+		return traced.window == window;
+	});
+
+	if (tracked) return;
+
+	auto index = STATE.windows.length();
+	STATE.windows.append({.window = window, .name = name});
+
+	// frameSwapped is emitted from the render thread by the threaded render loop,
+	// so the time is taken there before returning to the main thread.
+	QObject::connect(
+	    window,
+	    &QQuickWindow::frameSwapped,
+	    window,
+	    [index]() {
+		    auto time = STATE.clock.nsecsElapsed();
+
+		    QMetaObject::invokeMethod(
+		        QCoreApplication::instance(),
+		        [index, time]() { onFirstFrame(index, time); },
+		        Qt::QueuedConnection
+		    );
+	    },
+	    static_cast<Qt::ConnectionType>(Qt::DirectConnection | Qt::SingleShotConnection)
+	);
+}
+
+void StartupTrace::loadStarted() {
+	if (STATE.loaded) return;
+	STATE.loadStart = STATE.phases.length();
+}
+
+void StartupTrace::loadFailed() {
+	if (STATE.loaded) return;
+	// Phases of the next attempt replace those of the failed one.
+	STATE.phases.resize(STATE.loadStart);
+}
+
+void StartupTrace::configLoaded(QsIncubationController* incubation) {
+	if (STATE.loaded) return;
+
+	StartupTrace::mark("config loaded");
+	STATE.loaded = true;
+	STATE.incubation = incubation;
+
+	if (incubation) {
+		QObject::connect(incubation, &QsIncubationController::queueDepthChanged, &queueUpdate);
+	}
+
+	QTimer::singleShot(WINDOW_TIMEOUT, []() {
+		if (STATE.complete) return;
+		qCInfo(logStartup) << "Completing startup trace with windows that have not drawn.";
+		STATE.complete = true;
+		writeTrace();
+	});
+
+	// Written immediately so the trace can be read as soon as the configuration has loaded.
+	writeTrace();
+	queueUpdate();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <qstring.h>
+
+class QQuickWindow;
+class QsIncubationController;
+
+// Records when each phase of startup completes and when each window shown during startup
+// draws its first frame.
+//
+// Times are measured from a monotonic clock started during static initialization, which
+// is as close to process start as can be measured from inside the process.
+//
+// Once the initial configuration has loaded, the trace is written to `startup.json` in the
+// instance run dir, and rewritten as windows draw. It can be printed with `qs startup`.
+// The trace is complete once no objects are left incubating and every tracked window has
+// drawn, or after a timeout. Only the initial load is traced, later reloads are ignored.
+//
+// Must only be used from the main thread.
+class StartupTrace {
+public:
+	// Records the time a startup phase completed at.
+	static void mark(const QString& phase);
+
+	// True until the trace completes, after which windows are no longer tracked.
+	[[nodiscard]] static bool isTracing();
+
+	// Records the time the window first draws, if shown before the trace completes.
+	static void trackWindow(QQuickWindow* window, const QString& name);
+
+	// Called before each attempt to load the configuration, and after it if it fails,
+	// which discards the phases marked during the attempt.
+	static void loadStarted();
+	static void loadFailed();
+
+	// Marks the initial configuration as loaded, after which the trace is written.
+	// Windows created by the incubation controller are waited for while it has objects queued.
+	static void configLoaded(QsIncubationController* incubation);
+};
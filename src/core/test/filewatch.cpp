@@ -0,0 +1,171 @@
+#include "filewatch.hpp"
+#include <cstdio>
+
+#include <qfile.h>
+#include <qsignalspy.h>
+#include <qstring.h>
+#include <qtemporarydir.h>
+#include <qtest.h>
+#include <qtestcase.h>
+
+#include "../filewatch.hpp"
+
+namespace {
+
+void writeFile(const QString& path, const QByteArray& data) {
+	auto file = QFile(path);
+	QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+	file.write(data);
+}
+
+} // namespace
+
+void TestFileWatch::modify() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("file");
+	writeFile(path, "a");
+
+	auto watch = FileWatch();
+	watch.addPath(path);
+	auto spy = QSignalSpy(&watch, &FileWatch::fileChanged);
+
+	writeFile(path, "b");
+	QVERIFY(spy.wait());
+	QCOMPARE(spy.takeFirst().first().toString(), path);
+}
+
+void TestFileWatch::atomicReplace() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("file");
+	auto tmpPath = dir.filePath("file.tmp");
+	writeFile(path, "a");
+
+	auto watch = FileWatch();
+	watch.addPath(path);
+	auto spy = QSignalSpy(&watch, &FileWatch::fileChanged);
+
+	// Replaced twice to check the new inode is watched after the first rename.
+	for (auto i = 0; i != 2; i++) {
+		writeFile(tmpPath, "b");
+		spy.clear();
+		QCOMPARE(std::rename(QFile::encodeName(tmpPath).constData(), QFile::encodeName(path).constData()), 0);
+		QVERIFY(spy.wait());
+		QCOMPARE(spy.first().first().toString(), path);
+	}
+
+	// Changes to the replacement are seen through its own watch as well.
+	spy.clear();
+	writeFile(path, "c");
+	QVERIFY(spy.wait());
+}
+
+void TestFileWatch::recreate() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("file");
+
+	// Files are watched before they exist.
+	auto watch = FileWatch();
+	watch.addPath(path);
+	auto spy = QSignalSpy(&watch, &FileWatch::fileChanged);
+
+	writeFile(path, "a");
+	QVERIFY(spy.wait());
+
+	spy.clear();
+	QVERIFY(QFile::remove(path));
+	QVERIFY(spy.wait());
+
+	spy.clear();
+	writeFile(path, "b");
+	QVERIFY(spy.wait());
+}
+
+void TestFileWatch::directory() {
+	auto dir = QTemporaryDir();
+
+	auto watch = FileWatch();
+	watch.addPath(dir.path());
+	auto spy = QSignalSpy(&watch, &FileWatch::directoryChanged);
+
+	writeFile(dir.filePath("file"), "a");
+	QVERIFY(spy.wait());
+	QCOMPARE(spy.first().first().toString(), dir.path());
+}
+
+void TestFileWatch::directoryIgnoresWrites() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("file");
+	writeFile(path, "a");
+
+	auto watch = FileWatch();
+	watch.addPath(dir.path());
+	auto spy = QSignalSpy(&watch, &FileWatch::directoryChanged);
+
+	writeFile(path, "b");
+	QVERIFY(!spy.wait(100));
+
+	// Watching a file in the directory does not make writes to it visible to the directory.
+	auto fileWatch = FileWatch();
+	fileWatch.addPath(path);
+	auto fileSpy = QSignalSpy(&fileWatch, &FileWatch::fileChanged);
+
+	writeFile(path, "c");
+	QVERIFY(fileSpy.wait());
+	QCOMPARE(spy.count(), 0);
+
+	QVERIFY(QFile::remove(path));
+	QVERIFY(spy.wait());
+}
+
+void TestFileWatch::sharedWatches() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("file");
+	writeFile(path, "a");
+
+	auto* hub = FileWatchHub::instance();
+	auto baseCount = hub->watchCount();
+
+	auto watch1 = FileWatch();
+	auto watch2 = FileWatch();
+	watch1.addPath(path);
+	watch2.addPath(path);
+
+	// One watch for the file and one for its directory, shared by both.
+	QCOMPARE(hub->watchCount(), baseCount + 2);
+
+	auto spy1 = QSignalSpy(&watch1, &FileWatch::fileChanged);
+	auto spy2 = QSignalSpy(&watch2, &FileWatch::fileChanged);
+
+	watch1.clear();
+	QCOMPARE(hub->watchCount(), baseCount + 2);
+
+	writeFile(path, "b");
+	QVERIFY(spy2.wait());
+	QCOMPARE(spy1.count(), 0);
+
+	watch2.clear();
+	QCOMPARE(hub->watchCount(), baseCount);
+}
+
+void TestFileWatch::debounce() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("file");
+	writeFile(path, "a");
+
+	auto watch = FileWatch();
+	watch.setDebounceInterval(100);
+	watch.addPath(path);
+	auto spy = QSignalSpy(&watch, &FileWatch::fileChanged);
+	auto batchSpy = QSignalSpy(&watch, &FileWatch::changed);
+
+	for (auto i = 0; i != 5; i++) {
+		writeFile(path, QByteArray::number(i));
+		QTest::qWait(10);
+	}
+
+	QVERIFY(batchSpy.wait());
+	QCOMPARE(spy.count(), 1);
+	QCOMPARE(batchSpy.count(), 1);
+}
+
+QTEST_MAIN(TestFileWatch);
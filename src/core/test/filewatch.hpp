@@ -0,0 +1,17 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestFileWatch: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void modify();
+	static void atomicReplace();
+	static void recreate();
+	static void directory();
+	static void directoryIgnoresWrites();
+	static void sharedWatches();
+	static void debounce();
+};
@@ -0,0 +1,111 @@
+#include "imagecache.hpp"
+
+#include <qbytearray.h>
+#include <qimage.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtypes.h>
+
+#include "../imagecache.hpp"
+
+namespace {
+
+QByteArray pixelData(char fill, qsizetype size) { return QByteArray(size, fill); }
+
+QImage decodeImage(const QByteArray& data, int* decodeCount) {
+	(*decodeCount)++;
+	auto image = QImage(16, 16, QImage::Format_ARGB32);
+	image.fill(static_cast<uint>(data.at(0)));
+	return image;
+}
+
+} // namespace
+
+void TestSharedImageCache::deduplicate() {
+	auto cache = SharedImageCache();
+	auto decodeCount = 0;
+
+	auto data = pixelData('a', 1024);
+	auto copy = pixelData('a', 1024);
+
+	auto image1 = cache.image(data, 0, [&]() { return decodeImage(data, &decodeCount); });
+	auto image2 = cache.image(copy, 0, [&]() { return decodeImage(copy, &decodeCount); });
+
+	QCOMPARE(decodeCount, 1);
+	QCOMPARE(image1.cacheKey(), image2.cacheKey());
+	QCOMPARE(cache.count(), 1);
+	QCOMPARE(cache.totalBytes(), image1.sizeInBytes());
+	QCOMPARE(cache.retainedBytes(), 0);
+}
+
+void TestSharedImageCache::distinctParams() {
+	auto cache = SharedImageCache();
+	auto decodeCount = 0;
+
+	auto data = pixelData('a', 1024);
+
+	auto image1 = cache.image(data, 0, [&]() { return decodeImage(data, &decodeCount); });
+	auto image2 = cache.image(data, 1, [&]() { return decodeImage(data, &decodeCount); });
+
+	QCOMPARE(decodeCount, 2);
+	QVERIFY(image1.cacheKey() != image2.cacheKey());
+	QCOMPARE(cache.count(), 2);
+}
+
+void TestSharedImageCache::retainUnused() {
+	auto cache = SharedImageCache();
+	auto decodeCount = 0;
+
+	auto data = pixelData('a', 1024);
+
+	{
+		auto image = cache.image(data, 0, [&]() { return decodeImage(data, &decodeCount); });
+		QCOMPARE(cache.retainedBytes(), 0);
+	}
+
+	QCOMPARE(cache.retainedBytes(), cache.totalBytes());
+
+	cache.image(data, 0, [&]() { return decodeImage(data, &decodeCount); });
+	QCOMPARE(decodeCount, 1);
+}
+
+void TestSharedImageCache::evictUnused() {
+	auto imageBytes = QImage(16, 16, QImage::Format_ARGB32).sizeInBytes();
+	auto cache = SharedImageCache(imageBytes * 2);
+	auto decodeCount = 0;
+
+	auto dataA = pixelData('a', 1024);
+	auto dataB = pixelData('b', 1024);
+	auto dataC = pixelData('c', 1024);
+	auto dataD = pixelData('d', 1024);
+
+	auto dataE = pixelData('e', 1024);
+
+	auto held = cache.image(dataA, 0, [&]() { return decodeImage(dataA, &decodeCount); });
+	cache.image(dataB, 0, [&]() { return decodeImage(dataB, &decodeCount); });
+	cache.image(dataC, 0, [&]() { return decodeImage(dataC, &decodeCount); });
+	cache.image(dataD, 0, [&]() { return decodeImage(dataD, &decodeCount); });
+	QCOMPARE(cache.count(), 4);
+
+	// B is the least recently used unreferenced image.
+	cache.image(dataE, 0, [&]() { return decodeImage(dataE, &decodeCount); });
+	QCOMPARE(cache.count(), 4);
+
+	cache.image(dataA, 0, [&]() { return decodeImage(dataA, &decodeCount); });
+	cache.image(dataC, 0, [&]() { return decodeImage(dataC, &decodeCount); });
+	QCOMPARE(decodeCount, 5);
+
+	// D is now the least recently used unreferenced image.
+	cache.image(dataB, 0, [&]() { return decodeImage(dataB, &decodeCount); });
+	QCOMPARE(decodeCount, 6);
+	QCOMPARE(cache.count(), 4);
+
+	cache.image(dataD, 0, [&]() { return decodeImage(dataD, &decodeCount); });
+	QCOMPARE(decodeCount, 7);
+
+	cache.setRetainedByteLimit(0);
+	QCOMPARE(cache.count(), 1);
+	QCOMPARE(cache.retainedBytes(), 0);
+}
+
+QTEST_MAIN(TestSharedImageCache);
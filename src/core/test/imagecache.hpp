@@ -0,0 +1,14 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestSharedImageCache: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void deduplicate();
+	static void distinctParams();
+	static void retainUnused();
+	static void evictUnused();
+};
@@ -0,0 +1,108 @@
+#include "incubator.hpp"
+
+#include <qlist.h>
+#include <qobject.h>
+#include <qqmlcomponent.h>
+#include <qqmlengine.h>
+#include <qqmlincubator.h>
+#include <qquickwindow.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qurl.h>
+
+#include "../incubator.hpp"
+
+namespace {
+
+void loadComponent(QQmlComponent& component) {
+	component.setData(
+	    "import QtQml\nQtObject { property list<QtObject> children: [QtObject {}, QtObject {}] }",
+	    QUrl()
+	);
+
+	QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+}
+
+} // namespace
+
+void TestIncubator::held() {
+	auto engine = QQmlEngine();
+	auto controller = QsIncubationController();
+	engine.setIncubationController(&controller);
+	QVERIFY(controller.isHeld());
+
+	auto component = QQmlComponent(&engine);
+	loadComponent(component);
+
+	auto incubator = QQmlIncubator(QQmlIncubator::Asynchronous);
+	component.create(incubator);
+	QCOMPARE(controller.incubatingObjectCount(), 1);
+
+	QTest::qWait(50);
+	QVERIFY(incubator.isLoading());
+	QCOMPARE(controller.timeSpent(), 0.0);
+
+	controller.setHeld(false);
+	QTRY_VERIFY(incubator.isReady());
+	QCOMPARE(controller.incubatingObjectCount(), 0);
+	QVERIFY(controller.timeSpent() > 0);
+
+	delete incubator.object();
+}
+
+void TestIncubator::eventLoopSlices() {
+	auto engine = QQmlEngine();
+	auto controller = QsIncubationController();
+	controller.setHeld(false);
+	controller.setTimeSlice(1);
+	engine.setIncubationController(&controller);
+
+	auto component = QQmlComponent(&engine);
+	loadComponent(component);
+
+	// Incubation progresses without any window or frame source.
+	auto incubators = QList<QQmlIncubator*>();
+	for (auto i = 0; i != 20; i++) {
+		auto* incubator = new QQmlIncubator(QQmlIncubator::Asynchronous);
+		component.create(*incubator);
+		incubators.append(incubator);
+	}
+
+	QCOMPARE(controller.incubatingObjectCount(), 20);
+
+	QTRY_COMPARE(controller.incubatingObjectCount(), 0);
+
+	for (auto* incubator: incubators) {
+		QVERIFY(incubator->isReady());
+		delete incubator->object();
+		delete incubator;
+	}
+}
+
+void TestIncubator::frameSourceHidden() {
+	auto engine = QQmlEngine();
+	auto controller = QsIncubationController();
+	controller.setHeld(false);
+	engine.setIncubationController(&controller);
+
+	auto window = QQuickWindow();
+	window.show();
+	controller.setFrameSource(&window);
+
+	auto component = QQmlComponent(&engine);
+	loadComponent(component);
+
+	auto incubator = QQmlIncubator(QQmlIncubator::Asynchronous);
+	component.create(incubator);
+
+	// A swap queued before the window is hidden is delivered after the frame source
+	// has been removed, as happens when hiding it during incubation.
+	emit window.frameSwapped();
+	window.hide();
+	controller.setFrameSource(nullptr);
+
+	QTRY_VERIFY(incubator.isReady());
+	delete incubator.object();
+}
+
+QTEST_MAIN(TestIncubator);
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestIncubator: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void held();
+	static void eventLoopSlices();
+	static void frameSourceHidden();
+};
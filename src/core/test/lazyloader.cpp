@@ -0,0 +1,170 @@
+#include "lazyloader.hpp"
+
+#include <qbytearray.h>
+#include <qobject.h>
+#include <qpointer.h>
+#include <qqmlcomponent.h>
+#include <qqmlcontext.h>
+#include <qqmlengine.h>
+#include <qqmlincubator.h>
+#include <qsignalspy.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qurl.h>
+
+#include "../lazyloader.hpp"
+
+namespace {
+
+void loadComponent(
+    QQmlComponent& component,
+    const QByteArray& data = "import QtQml\nQtObject { property bool visible: true }"
+) {
+	component.setData(data, QUrl());
+	QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+}
+
+void waitForPrewarm(LazyLoader& loader, QQmlIncubationController& controller) {
+	for (auto i = 0; i != 100 && !loader.isWarm(); i++) {
+		QTest::qWait(50);
+		controller.incubateFor(10);
+	}
+
+	QVERIFY(loader.isWarm());
+}
+
+} // namespace
+
+void TestLazyLoader::destroyOnDeactivate() {
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	loadComponent(component);
+
+	auto loader = LazyLoader();
+	loader.setComponent(&component);
+	loader.reload();
+	QCOMPARE(loader.creationTime(), -1.0);
+
+	loader.setActive(true);
+	QVERIFY(loader.isActive());
+	QVERIFY(loader.creationTime() >= 0);
+
+	auto item = QPointer(loader.item());
+	loader.setActive(false);
+	QVERIFY(!loader.isWarm());
+	QTRY_VERIFY(item == nullptr);
+}
+
+void TestLazyLoader::keepWarm() {
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	loadComponent(component);
+
+	auto loader = LazyLoader();
+	loader.setComponent(&component);
+	loader.setKeepWarm(true);
+	loader.reload();
+
+	loader.setActive(true);
+	auto* item = loader.item();
+	auto creationTime = loader.creationTime();
+
+	loader.setActive(false);
+	QVERIFY(!loader.isActive());
+	QVERIFY(loader.isWarm());
+	QVERIFY(loader.item() == nullptr);
+	QVERIFY(!item->property("visible").toBool());
+
+	// Reused without being created again.
+	loader.setActive(true);
+	QCOMPARE(loader.item(), item);
+	QVERIFY(!loader.isWarm());
+	QVERIFY(item->property("visible").toBool());
+	QCOMPARE(loader.creationTime(), creationTime);
+
+	loader.setActive(false);
+	loader.setKeepWarm(false);
+	QVERIFY(!loader.isWarm());
+}
+
+void TestLazyLoader::prewarm() {
+	auto engine = QQmlEngine();
+	auto controller = QQmlIncubationController();
+	engine.setIncubationController(&controller);
+
+	auto component = QQmlComponent(&engine);
+	loadComponent(component);
+
+	// Prewarming uses the engine of the loader's context.
+	auto loader = LazyLoader();
+	QQmlEngine::setContextForObject(&loader, engine.rootContext());
+	auto loadingSpy = QSignalSpy(&loader, &LazyLoader::loadingChanged);
+	loader.setComponent(&component);
+	loader.setPrewarm(true);
+	loader.reload();
+
+	waitForPrewarm(loader, controller);
+	QVERIFY(!loader.isActive());
+	QVERIFY(loader.creationTime() >= 0);
+	QCOMPARE(loadingSpy.count(), 0);
+
+	loader.setActive(true);
+	QVERIFY(!loader.isWarm());
+	QVERIFY(loader.item()->property("visible").toBool());
+}
+
+void TestLazyLoader::boundVisibility() {
+	auto engine = QQmlEngine();
+	auto controller = QQmlIncubationController();
+	engine.setIncubationController(&controller);
+
+	auto component = QQmlComponent(&engine);
+	loadComponent(
+	    component,
+	    "import QtQml\nQtObject { property bool shown: true; property bool visible: shown }"
+	);
+
+	auto loader = LazyLoader();
+	QQmlEngine::setContextForObject(&loader, engine.rootContext());
+	loader.setComponent(&component);
+	loader.setKeepWarm(true);
+	loader.setPrewarm(true);
+	loader.reload();
+
+	waitForPrewarm(loader, controller);
+
+	QObject* item = nullptr;
+	for (auto* child: loader.children()) {
+		if (child->property("shown").isValid()) item = child;
+	}
+
+	// The binding is not evaluated while prewarming, or when its dependencies change.
+	QVERIFY(item != nullptr);
+	QVERIFY(!item->property("visible").toBool());
+	item->setProperty("shown", false);
+	item->setProperty("shown", true);
+	QVERIFY(!item->property("visible").toBool());
+
+	loader.setActive(true);
+	QCOMPARE(loader.item(), item);
+	QVERIFY(item->property("visible").toBool());
+
+	// The binding is restored once the item is used.
+	item->setProperty("shown", false);
+	QVERIFY(!item->property("visible").toBool());
+	item->setProperty("shown", true);
+	QVERIFY(item->property("visible").toBool());
+
+	// And suspended again while pooled.
+	loader.setActive(false);
+	QVERIFY(loader.isWarm());
+	QVERIFY(!item->property("visible").toBool());
+	item->setProperty("shown", false);
+	item->setProperty("shown", true);
+	QVERIFY(!item->property("visible").toBool());
+
+	loader.setActive(true);
+	QVERIFY(item->property("visible").toBool());
+}
+
+QTEST_MAIN(TestLazyLoader);
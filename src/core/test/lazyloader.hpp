@@ -0,0 +1,14 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestLazyLoader: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void destroyOnDeactivate();
+	static void keepWarm();
+	static void prewarm();
+	static void boundVisibility();
+};
@@ -3,6 +3,7 @@
 #include <qlist.h>
 #include <qquickitem.h>
 #include <qquickwindow.h>
+#include <qsignalspy.h>
 #include <qtest.h>
 #include <qtestcase.h>
 
@@ -102,4 +103,40 @@ void TestTransformWatcher::multiWindow() { // NOLINT
 	QCOMPARE(watcher.childWindow, &bW);
 }
 
+void TestTransformWatcher::coalesceChanges() { // NOLINT
+	auto p = QQuickItem();
+	auto a = QQuickItem();
+	auto b = QQuickItem();
+	a.setParentItem(&p);
+	b.setParentItem(&p);
+
+	auto watcher = TransformWatcher();
+	watcher.setA(&a);
+	watcher.setB(&b);
+
+	auto spy = QSignalSpy(&watcher, &TransformWatcher::transformChanged);
+	QTRY_COMPARE(spy.count(), 1);
+
+	// Many changes within one event loop iteration are reported once.
+	for (auto i = 1; i <= 10; i++) {
+		b.setX(i);
+		p.setWidth(i);
+	}
+
+	QCOMPARE(spy.count(), 1);
+	QTRY_COMPARE(spy.count(), 2);
+
+	// Changes which do not affect the transform between a and b are not reported.
+	p.setX(100);
+	p.setWidth(200);
+	b.setX(20);
+	b.setX(10);
+
+	QTest::qWait(50);
+	QCOMPARE(spy.count(), 2);
+
+	a.setX(5);
+	QTRY_COMPARE(spy.count(), 3);
+}
+
 QTEST_MAIN(TestTransformWatcher);
@@ -11,4 +11,5 @@ private slots:
 	void bParentOfA();
 	void aParentChainB();
 	void multiWindow();
+	void coalesceChanges();
 };
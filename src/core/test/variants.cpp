@@ -0,0 +1,143 @@
+#include "variants.hpp"
+#include <algorithm>
+
+#include <qcontainerfwd.h>
+#include <qcoreapplication.h>
+#include <qcoreevent.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qqmlcomponent.h>
+#include <qqmlengine.h>
+#include <qqmllist.h>
+#include <qregularexpression.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtypes.h>
+#include <qurl.h>
+#include <qvariant.h>
+
+#include "../variants.hpp"
+
+namespace {
+
+void loadDelegate(QQmlComponent& component) {
+	component.setData("import QtQml\nQtObject { property var modelData }", QUrl());
+	QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+}
+
+QList<QObject*> instanceList(Variants& variants) {
+	auto prop = variants.instances();
+	auto list = QList<QObject*>();
+
+	for (auto i = 0; i < prop.count(&prop); i++) {
+		list.append(prop.at(&prop, i));
+	}
+
+	return list;
+}
+
+QVariantList rangeModel(qsizetype start, qsizetype end) {
+	auto model = QVariantList();
+	model.reserve(end - start);
+
+	for (auto i = start; i < end; i++) {
+		model.append(QVariant::fromValue(i));
+	}
+
+	return model;
+}
+
+void sizeData() {
+	QTest::addColumn<qsizetype>("size");
+	QTest::addRow("10") << qsizetype(10);
+	QTest::addRow("100") << qsizetype(100);
+	QTest::addRow("1000") << qsizetype(1000);
+}
+
+} // namespace
+
+void TestVariants::diffInstances() {
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	loadDelegate(component);
+
+	auto variants = Variants();
+	variants.setProperty("delegate", QVariant::fromValue(&component));
+
+	variants.setModel(QVariantList {1, 2, 3});
+	auto initial = instanceList(variants);
+	QCOMPARE(initial.length(), 3);
+
+	// 2.0 compares equal to 2 and should not recreate the instance.
+	variants.setModel(QVariantList {2.0, 3, 4});
+	auto updated = instanceList(variants);
+	QCOMPARE(updated.length(), 3);
+	QCOMPARE(updated.at(0), initial.at(1));
+	QCOMPARE(updated.at(1), initial.at(2));
+	QVERIFY(!initial.contains(updated.at(2)));
+	QCOMPARE(updated.at(2)->property("modelData"), QVariant(4));
+}
+
+void TestVariants::ignoreDuplicates() {
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	loadDelegate(component);
+
+	auto variants = Variants();
+	variants.setProperty("delegate", QVariant::fromValue(&component));
+
+	QTest::ignoreMessage(QtWarningMsg, QRegularExpression("same value specified twice"));
+	variants.setModel(QVariantList {1, 2, 1});
+	QCOMPARE(instanceList(variants).length(), 2);
+}
+
+void TestVariants::benchChurn_data() { sizeData(); }
+
+// Alternates between two models sharing half their values.
+void TestVariants::benchChurn() {
+	QFETCH(qsizetype, size);
+
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	loadDelegate(component);
+
+	auto variants = Variants();
+	variants.setProperty("delegate", QVariant::fromValue(&component));
+
+	auto modelA = rangeModel(0, size);
+	auto modelB = rangeModel(size / 2, size + size / 2);
+	auto flip = false;
+
+	QBENCHMARK {
+		variants.setModel(flip ? modelA : modelB);
+		flip = !flip;
+		QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+	}
+}
+
+void TestVariants::benchReorder_data() { sizeData(); }
+
+// Reorders the same set of values, which should not create or destroy instances.
+void TestVariants::benchReorder() {
+	QFETCH(qsizetype, size);
+
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	loadDelegate(component);
+
+	auto variants = Variants();
+	variants.setProperty("delegate", QVariant::fromValue(&component));
+
+	auto model = rangeModel(0, size);
+	variants.setModel(model);
+	auto instances = instanceList(variants);
+
+	QBENCHMARK {
+		std::ranges::reverse(model);
+		variants.setModel(model);
+	}
+
+	QCOMPARE(instanceList(variants), instances);
+}
+
+QTEST_MAIN(TestVariants);
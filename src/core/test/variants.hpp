@@ -0,0 +1,17 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestVariants: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void diffInstances();
+	static void ignoreDuplicates();
+
+	static void benchChurn_data();
+	static void benchChurn();
+	static void benchReorder_data();
+	static void benchReorder();
+};
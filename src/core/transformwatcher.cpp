@@ -5,10 +5,22 @@
 #include <qlist.h>
 #include <qlogging.h>
 #include <qobject.h>
+#include <qpoint.h>
+#include <qpolygon.h>
 #include <qquickitem.h>
 #include <qquickwindow.h>
 #include <qtmetamacros.h>
 
+namespace {
+// Longer than a frame at any common refresh rate.
+constexpr int FRAME_FALLBACK_INTERVAL = 50;
+} // namespace
+
+TransformWatcher::TransformWatcher(QObject* parent): QObject(parent) {
+	this->flushTimer.setSingleShot(true);
+	QObject::connect(&this->flushTimer, &QTimer::timeout, this, &TransformWatcher::flush);
+}
+
 void TransformWatcher::resolveChains(QQuickItem* a, QQuickItem* b, QQuickItem* commonParent) {
 	if (a == nullptr || b == nullptr) return;
 
@@ -74,12 +86,12 @@ void TransformWatcher::resolveChains() {
 }
 
 void TransformWatcher::linkItem(QQuickItem* item) const {
-	QObject::connect(item, &QQuickItem::xChanged, this, &TransformWatcher::transformChanged);
-	QObject::connect(item, &QQuickItem::yChanged, this, &TransformWatcher::transformChanged);
-	QObject::connect(item, &QQuickItem::widthChanged, this, &TransformWatcher::transformChanged);
-	QObject::connect(item, &QQuickItem::heightChanged, this, &TransformWatcher::transformChanged);
-	QObject::connect(item, &QQuickItem::scaleChanged, this, &TransformWatcher::transformChanged);
-	QObject::connect(item, &QQuickItem::rotationChanged, this, &TransformWatcher::transformChanged);
+	QObject::connect(item, &QQuickItem::xChanged, this, &TransformWatcher::onGeometryChanged);
+	QObject::connect(item, &QQuickItem::yChanged, this, &TransformWatcher::onGeometryChanged);
+	QObject::connect(item, &QQuickItem::widthChanged, this, &TransformWatcher::onGeometryChanged);
+	QObject::connect(item, &QQuickItem::heightChanged, this, &TransformWatcher::onGeometryChanged);
+	QObject::connect(item, &QQuickItem::scaleChanged, this, &TransformWatcher::onGeometryChanged);
+	QObject::connect(item, &QQuickItem::rotationChanged, this, &TransformWatcher::onGeometryChanged);
 
 	QObject::connect(item, &QQuickItem::parentChanged, this, &TransformWatcher::recalcChains);
 	QObject::connect(item, &QQuickItem::windowChanged, this, &TransformWatcher::recalcChains);
@@ -125,6 +137,82 @@ void TransformWatcher::recalcChains() {
 	this->unlinkChains();
 	this->resolveChains();
 	this->linkChains();
+
+	// The new path may have a different transform.
+	this->scheduleFlush(this->mB == nullptr ? nullptr : this->mB->window());
+}
+
+void TransformWatcher::onGeometryChanged() {
+	auto* item = qobject_cast<QQuickItem*>(this->sender());
+	this->scheduleFlush(item == nullptr ? nullptr : item->window());
+}
+
+void TransformWatcher::scheduleFlush(QQuickWindow* window) {
+	if (this->dirty) return;
+	this->dirty = true;
+
+	if (window != nullptr && window->isExposed()) {
+		// Geometry changes in an exposed window schedule a frame. afterAnimating runs on the
+		// gui thread after animations advance and before items are polished, so the new
+		// transform is reported once per frame, in time to be used by that frame.
+		this->frameWindow = window;
+		QObject::connect(window, &QQuickWindow::afterAnimating, this, &TransformWatcher::flush);
+
+		// In case the window stops rendering before the frame.
+		this->flushTimer.start(FRAME_FALLBACK_INTERVAL);
+	} else {
+		this->flushTimer.start(0);
+	}
+}
+
+void TransformWatcher::flush() {
+	if (this->frameWindow != nullptr) {
+		QObject::disconnect(
+		    this->frameWindow,
+		    &QQuickWindow::afterAnimating,
+		    this,
+		    &TransformWatcher::flush
+		);
+
+		this->frameWindow = nullptr;
+	}
+
+	this->flushTimer.stop();
+
+	if (!this->dirty) return;
+	this->dirty = false;
+
+	auto transform = this->mapTransform();
+	if (transform == this->lastTransform) return;
+
+	this->lastTransform = transform;
+	emit this->transformChanged();
+}
+
+TransformWatcher::MappedTransform TransformWatcher::mapTransform() const {
+	if (this->mA == nullptr || this->mB == nullptr) return MappedTransform();
+
+	auto corners = QPolygonF({
+	    QPointF(0, 0),
+	    QPointF(this->mB->width(), 0),
+	    QPointF(0, this->mB->height()),
+	});
+
+	auto mapped = QPolygonF();
+	mapped.reserve(corners.size());
+
+	for (const auto& corner: corners) {
+		if (this->parentWindow != nullptr) {
+			mapped.append(this->mA->mapFromGlobal(this->mB->mapToGlobal(corner)));
+		} else {
+			mapped.append(this->mA->mapFromItem(this->mB, corner));
+		}
+	}
+
+	return MappedTransform {
+	    .b = mapped,
+	    .aSize = this->mA->size(),
+	};
 }
 
 void TransformWatcher::itemDestroyed() {
@@ -2,9 +2,13 @@
 
 #include <qlist.h>
 #include <qobject.h>
+#include <qpointer.h>
+#include <qpolygon.h>
 #include <qqmlintegration.h>
 #include <qquickitem.h>
 #include <qquickwindow.h>
+#include <qsize.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 
 #ifdef QS_TEST
@@ -33,12 +37,16 @@ class TransformWatcher: public QObject {
 	/// This property is updated whenever the geometry of any item in the path from `a` to `b` changes.
 	///
 	/// Its value is undefined, and is intended to trigger an expression update.
+	///
+	/// Changes are combined and reported at most once per frame, before the frame is rendered,
+	/// and only if the position, size, scale or rotation of `b` relative to `a`, or the size of `a`
+	/// actually changed.
 	Q_PROPERTY(QObject* transform READ transform NOTIFY transformChanged);
 	// clang-format on
 	QML_ELEMENT;
 
 public:
-	explicit TransformWatcher(QObject* parent = nullptr): QObject(parent) {}
+	explicit TransformWatcher(QObject* parent = nullptr);
 
 	[[nodiscard]] QQuickItem* a() const;
 	void setA(QQuickItem* a);
@@ -63,13 +71,25 @@ private slots:
 	void itemDestroyed();
 	void aDestroyed();
 	void bDestroyed();
+	void onGeometryChanged();
+	void flush();
 
 private:
+	// The corners of b mapped into a, and the size of a.
+	struct MappedTransform {
+		QPolygonF b;
+		QSizeF aSize;
+
+		[[nodiscard]] bool operator==(const MappedTransform& other) const = default;
+	};
+
 	void resolveChains(QQuickItem* a, QQuickItem* b, QQuickItem* commonParent);
 	void resolveChains();
 	void linkItem(QQuickItem* item) const;
 	void linkChains();
 	void unlinkChains();
+	void scheduleFlush(QQuickWindow* window);
+	[[nodiscard]] MappedTransform mapTransform() const;
 
 	QQuickItem* mA = nullptr;
 	QQuickItem* mB = nullptr;
@@ -81,6 +101,12 @@ private:
 	QQuickWindow* parentWindow = nullptr;
 	QQuickWindow* childWindow = nullptr;
 
+	bool dirty = false;
+	MappedTransform lastTransform;
+	QPointer<QQuickWindow> frameWindow;
+	// Used when the changed item is not in an exposed window, which will not render a frame.
+	QTimer flushTimer;
+
 #ifdef QS_TEST
 	friend class TestTransformWatcher;
 #endif
@@ -1,16 +1,22 @@
 #include "variants.hpp"
-#include <algorithm>
 #include <utility>
 
 #include <qcontainerfwd.h>
+#include <qhash.h>
+#include <qhashfunctions.h>
 #include <qlogging.h>
+#include <qmetatype.h>
 #include <qobject.h>
 #include <qqmlengine.h>
+#include <qqmlincubator.h>
 #include <qqmllist.h>
+#include <qset.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
+#include <qurl.h>
 #include <qvariant.h>
 
+#include "incubator.hpp"
 #include "reload.hpp"
 
 void Variants::onReload(QObject* oldInstance) {
@@ -19,15 +25,12 @@ void Variants::onReload(QObject* oldInstance) {
 	for (auto& [variant, instanceObj]: this->mInstances.values) {
 		QObject* oldInstance = nullptr;
 		if (old != nullptr) {
-			auto& values = old->mInstances.values;
-
 			if (variant.canConvert<QVariantMap>()) {
 				auto variantMap = variant.value<QVariantMap>();
 
 				int matchcount = 0;
-				int matchi = 0;
-				int i = 0;
-				for (auto& [value, _]: values) {
+				QVariant matchKey;
+				for (auto& [value, _]: old->mInstances.values) {
 					if (!value.canConvert<QVariantMap>()) continue;
 					auto valueSet = value.value<QVariantMap>();
 
@@ -40,25 +43,15 @@ void Variants::onReload(QObject* oldInstance) {
 
 					if (count > matchcount) {
 						matchcount = count;
-						matchi = i;
+						matchKey = value;
 					}
-
-					i++;
 				}
 
 				if (matchcount > 0) {
-					oldInstance = values.takeAt(matchi).second;
+					oldInstance = old->mInstances.take(matchKey);
 				}
 			} else {
-				int i = 0;
-				for (auto& [value, _]: values) {
-					if (variant == value) {
-						oldInstance = values.takeAt(i).second;
-						break;
-					}
-
-					i++;
-				}
+				oldInstance = old->mInstances.take(variant);
 			}
 		}
 
@@ -104,6 +97,20 @@ QQmlListProperty<QObject> Variants::instances() {
 	return QQmlListProperty<QObject>(this, nullptr, &Variants::instanceCount, &Variants::instanceAt);
 }
 
+void Variants::setAsynchronous(bool asynchronous) {
+	if (asynchronous == this->mAsynchronous) return;
+	this->mAsynchronous = asynchronous;
+
+	if (!asynchronous) {
+		// Completion removes the incubator from the table.
+		for (auto* incubator: this->mIncubators.values()) {
+			incubator->forceCompletion();
+		}
+	}
+
+	emit this->asynchronousChanged();
+}
+
 qsizetype Variants::instanceCount(QQmlListProperty<QObject>* prop) {
 	return static_cast<Variants*>(prop->object)->mInstances.values.length(); // NOLINT
 }
@@ -123,92 +130,227 @@ void Variants::updateVariants() {
 		return;
 	}
 
+	auto wasLoading = this->isLoading();
+
+	auto modelKeys = QSet<VariantKey>();
+	modelKeys.reserve(this->mModel.length());
+	auto newValues = QVariantList();
+
+	for (const auto& variant: this->mModel) {
+		auto key = VariantKey {variant};
+
+		if (modelKeys.contains(key)) {
+			qWarning() << "same value specified twice in Variants, duplicates will be ignored:"
+			           << variant;
+			continue;
+		}
+
+		modelKeys.insert(key);
+
+		if (!this->mInstances.contains(variant) && !this->mIncubators.contains(key)) {
+			newValues.append(variant);
+		}
+	}
+
 	// clean up removed entries
-	for (auto iter = this->mInstances.values.begin(); iter < this->mInstances.values.end();) {
-		if (this->mModel.contains(iter->first)) {
-			iter++;
+	for (auto* instance: this->mInstances.retain(modelKeys)) {
+		instance->deleteLater();
+	}
+
+	for (auto iter = this->mIncubators.begin(); iter != this->mIncubators.end();) {
+		if (modelKeys.contains(iter.key())) {
+			++iter;
 		} else {
-			iter->second->deleteLater();
-			iter = this->mInstances.values.erase(iter);
+			delete iter.value();
+			iter = this->mIncubators.erase(iter);
 		}
 	}
 
-	for (auto iter = this->mModel.begin(); iter < this->mModel.end(); iter++) {
-		auto& variant = *iter;
-		for (auto iter2 = this->mModel.begin(); iter2 < iter; iter2++) {
-			if (*iter2 == variant) {
-				qWarning() << "same value specified twice in Variants, duplicates will be ignored:"
-				           << variant;
-				goto outer;
-			}
-		}
+	// Windows are usually created by the first Variants loaded, and the incubation
+	// controller is not available until a window exists, so the initial load is synchronous.
+	auto async = this->mAsynchronous && this->loaded;
 
-		{
-			if (this->mInstances.contains(variant)) {
-				continue; // we dont need to recreate this one
-			}
+	for (const auto& variant: newValues) {
+		if (async) this->incubateInstance(variant);
+		else this->createInstance(variant);
+	}
+
+	if (this->isLoading() != wasLoading) emit this->loadingChanged();
+}
 
-			auto variantMap = QVariantMap();
-			variantMap.insert("modelData", variant);
+void Variants::createInstance(const QVariant& variant) {
+	auto variantMap = QVariantMap();
+	variantMap.insert("modelData", variant);
 
-			auto* instance = this->mDelegate->createWithInitialProperties(
-			    variantMap,
-			    QQmlEngine::contextForObject(this->mDelegate)
-			);
+	auto* instance = this->mDelegate->createWithInitialProperties(
+	    variantMap,
+	    QQmlEngine::contextForObject(this->mDelegate)
+	);
 
-			if (instance == nullptr) {
-				qWarning() << this->mDelegate->errorString().toStdString().c_str();
-				qWarning() << "failed to create variant with object" << variant;
-				continue;
-			}
+	if (instance == nullptr) {
+		qWarning() << this->mDelegate->errorString().toStdString().c_str();
+		qWarning() << "failed to create variant with object" << variant;
+		return;
+	}
 
-			QQmlEngine::setObjectOwnership(instance, QQmlEngine::CppOwnership);
+	this->addInstance(variant, instance);
+}
 
-			instance->setParent(this);
-			this->mInstances.insert(variant, instance);
+void Variants::incubateInstance(const QVariant& variant) {
+	auto* incubator = new QsQmlIncubator(QQmlIncubator::Asynchronous, this);
 
-			if (this->loaded) {
-				if (auto* reloadable = qobject_cast<Reloadable*>(instance)) reloadable->reload(nullptr);
-				else Reloadable::reloadChildrenRecursive(instance, nullptr);
-			}
-		}
+	auto variantMap = QVariantMap();
+	variantMap.insert("modelData", variant);
+	incubator->setInitialProperties(variantMap);
+
+	// clang-format off
+	QObject::connect(incubator, &QsQmlIncubator::completed, this, [this, variant, incubator]() { this->onIncubationCompleted(variant, incubator); });
+	QObject::connect(incubator, &QsQmlIncubator::failed, this, [this, variant, incubator]() { this->onIncubationFailed(variant, incubator); });
+	// clang-format on
+
+	// Inserted first as incubation may complete immediately.
+	this->mIncubators.insert(VariantKey {variant}, incubator);
+	this->mDelegate->create(*incubator, QQmlEngine::contextForObject(this->mDelegate));
+}
+
+void Variants::addInstance(const QVariant& variant, QObject* instance) {
+	QQmlEngine::setObjectOwnership(instance, QQmlEngine::CppOwnership);
+
+	instance->setParent(this);
+	this->mInstances.insert(variant, instance);
 
-	outer:;
+	if (this->loaded) {
+		if (auto* reloadable = qobject_cast<Reloadable*>(instance)) reloadable->reload(nullptr);
+		else Reloadable::reloadChildrenRecursive(instance, nullptr);
 	}
 }
 
-template <typename K, typename V>
-bool AwfulMap<K, V>::contains(const K& key) const {
-	return std::ranges::any_of(this->values, [&](const QPair<K, V>& pair) {
-		return pair.first == key;
-	});
+void Variants::onIncubationCompleted(const QVariant& variant, QsQmlIncubator* incubator) {
+	this->mIncubators.remove(VariantKey {variant});
+	this->addInstance(variant, incubator->object());
+
+	// The incubator is not necessarily inert at the time of this callback,
+	// so deleteLater is required.
+	incubator->deleteLater();
+
+	emit this->instancesChanged();
+	if (!this->isLoading()) emit this->loadingChanged();
 }
 
-template <typename K, typename V>
-V* AwfulMap<K, V>::get(const K& key) {
-	for (auto& [k, v]: this->values) {
-		if (key == k) {
-			return &v;
-		}
+void Variants::onIncubationFailed(const QVariant& variant, QsQmlIncubator* incubator) {
+	for (auto& error: incubator->errors()) {
+		qWarning() << error;
 	}
 
-	return nullptr;
+	qWarning() << "failed to create variant with object" << variant;
+
+	this->mIncubators.remove(VariantKey {variant});
+	incubator->deleteLater();
+
+	if (!this->isLoading()) emit this->loadingChanged();
 }
 
-template <typename K, typename V>
-void AwfulMap<K, V>::insert(const K& key, V value) {
-	this->values.push_back(QPair<K, V>(key, value));
+namespace {
+
+bool isNumericType(const QMetaType& type) {
+	if (type.flags().testFlag(QMetaType::IsEnumeration)) return true;
+
+	switch (type.id()) {
+	case QMetaType::Bool:
+	case QMetaType::Char:
+	case QMetaType::SChar:
+	case QMetaType::UChar:
+	case QMetaType::Char16:
+	case QMetaType::Char32:
+	case QMetaType::Short:
+	case QMetaType::UShort:
+	case QMetaType::Int:
+	case QMetaType::UInt:
+	case QMetaType::Long:
+	case QMetaType::ULong:
+	case QMetaType::LongLong:
+	case QMetaType::ULongLong:
+	case QMetaType::Float16:
+	case QMetaType::Float:
+	case QMetaType::Double: return true;
+	default: return false;
+	}
 }
 
-template <typename K, typename V>
-bool AwfulMap<K, V>::remove(const K& key) {
-	for (auto iter = this->values.begin(); iter < this->values.end(); iter++) {
-		if (iter->first == key) {
-			this->values.erase(iter);
+} // namespace
+
+size_t qHash(const VariantKey& key, size_t seed) {
+	const auto& value = key.value;
+	auto type = value.metaType();
 
-			return true;
+	if (!type.isValid()) return seed;
+
+	// QVariant only considers values of differing types equal if they are both numeric
+	// or both QObject pointers, so those are hashed independently of their exact type.
+	// Everything else must match types to compare equal.
+	if (type.flags().testFlag(QMetaType::PointerToQObject)) {
+		return qHash(value.value<QObject*>(), seed);
+	} else if (isNumericType(type)) {
+		return qHash(value.toDouble(), seed);
+	}
+
+	switch (type.id()) {
+	case QMetaType::QString: return qHash(value.toString(), seed);
+	case QMetaType::QUrl: return qHash(value.toUrl(), seed);
+	case QMetaType::QVariantList: {
+		for (const auto& item: value.value<QVariantList>()) {
+			seed = qHash(VariantKey {item}, seed);
+		}
+
+		return seed;
+	}
+	case QMetaType::QVariantMap: {
+		auto map = value.value<QVariantMap>();
+		for (const auto [k, v]: map.asKeyValueRange()) {
+			seed = qHashMulti(seed, k, VariantKey {v});
 		}
+
+		return seed;
+	}
+	default: return qHash(type.id(), seed);
 	}
+}
+
+bool VariantInstanceTable::contains(const QVariant& key) const {
+	return this->index.contains(VariantKey {key});
+}
+
+QObject* VariantInstanceTable::get(const QVariant& key) const {
+	return this->index.value(VariantKey {key});
+}
+
+void VariantInstanceTable::insert(const QVariant& key, QObject* instance) {
+	this->values.push_back(QPair<QVariant, QObject*>(key, instance));
+	this->index.insert(VariantKey {key}, instance);
+}
+
+QObject* VariantInstanceTable::take(const QVariant& key) {
+	auto* instance = this->index.take(VariantKey {key});
+	if (instance == nullptr) return nullptr;
+
+	this->values.removeIf([instance](const QPair<QVariant, QObject*>& pair) {
+		return pair.second == instance;
+	});
+
+	return instance;
+}
+
+QList<QObject*> VariantInstanceTable::retain(const QSet<VariantKey>& keys) {
+	auto removed = QList<QObject*>();
+
+	this->values.removeIf([&](const QPair<QVariant, QObject*>& pair) {
+		auto key = VariantKey {pair.first};
+		if (keys.contains(key)) return false;
+
+		this->index.remove(key);
+		removed.append(pair.second);
+		return true;
+	});
 
-	return false;
+	return removed;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <qcontainerfwd.h>
+#include <qhash.h>
 #include <qlist.h>
 #include <qlogging.h>
 #include <qmap.h>
@@ -8,21 +9,39 @@
 #include <qqmlcomponent.h>
 #include <qqmllist.h>
 #include <qqmlparserstatus.h>
+#include <qset.h>
 #include <qtmetamacros.h>
 #include <qvariant.h>
 
 #include "doc.hpp"
+#include "incubator.hpp"
 #include "reload.hpp"
 
-// extremely inefficient map
-template <typename K, typename V>
-class AwfulMap {
+// Hash key for model values, consistent with QVariant equality.
+struct VariantKey {
+	QVariant value;
+
+	[[nodiscard]] bool operator==(const VariantKey& other) const { return this->value == other.value; }
+};
+
+size_t qHash(const VariantKey& key, size_t seed = 0);
+
+// Instances in creation order, indexed by the model value they were created for.
+class VariantInstanceTable {
 public:
-	[[nodiscard]] bool contains(const K& key) const;
-	[[nodiscard]] V* get(const K& key);
-	void insert(const K& key, V value); // assumes no duplicates
-	bool remove(const K& key);          // returns true if anything was removed
-	QList<QPair<K, V>> values;
+	[[nodiscard]] bool contains(const QVariant& key) const;
+	[[nodiscard]] QObject* get(const QVariant& key) const;
+	void insert(const QVariant& key, QObject* instance); // assumes no duplicates
+	QObject* take(const QVariant& key);                  // returns nullptr if not present
+
+	// Removes all instances with keys not present in the given set, preserving order.
+	// Returns the removed instances.
+	QList<QObject*> retain(const QSet<VariantKey>& keys);
+
+	QList<QPair<QVariant, QObject*>> values;
+
+private:
+	QHash<VariantKey, QObject*> index;
 };
 
 ///! Creates instances of a component based on a given model.
@@ -52,6 +71,17 @@ class Variants: public Reloadable {
 	QSDOC_HIDE Q_PROPERTY(QVariant model READ model WRITE setModel NOTIFY modelChanged);
 	/// Current instances of the delegate.
 	Q_PROPERTY(QQmlListProperty<QObject> instances READ instances NOTIFY instancesChanged);
+	/// If instances for new model values should be created asynchronously. Defaults to false.
+	///
+	/// When enabled, new instances are incubated over multiple frames using the spare time
+	/// of each frame, instead of blocking the UI until every instance has been created.
+	/// New instances are added to @@instances once they have finished loading.
+	///
+	/// Instances created while the shell is loading are always created synchronously.
+	/// Setting this property to false finishes loading any pending instances immediately.
+	Q_PROPERTY(bool asynchronous READ isAsynchronous WRITE setAsynchronous NOTIFY asynchronousChanged);
+	/// If any instances are currently being created asynchronously.
+	Q_PROPERTY(bool loading READ isLoading NOTIFY loadingChanged);
 	Q_CLASSINFO("DefaultProperty", "delegate");
 	QML_ELEMENT;
 
@@ -66,18 +96,32 @@ public:
 
 	QQmlListProperty<QObject> instances();
 
+	[[nodiscard]] bool isAsynchronous() const { return this->mAsynchronous; }
+	void setAsynchronous(bool asynchronous);
+
+	[[nodiscard]] bool isLoading() const { return !this->mIncubators.isEmpty(); }
+
 signals:
 	void modelChanged();
 	void instancesChanged();
+	void asynchronousChanged();
+	void loadingChanged();
 
 private:
 	static qsizetype instanceCount(QQmlListProperty<QObject>* prop);
 	static QObject* instanceAt(QQmlListProperty<QObject>* prop, qsizetype i);
 
 	void updateVariants();
+	void createInstance(const QVariant& variant);
+	void incubateInstance(const QVariant& variant);
+	void addInstance(const QVariant& variant, QObject* instance);
+	void onIncubationCompleted(const QVariant& variant, QsQmlIncubator* incubator);
+	void onIncubationFailed(const QVariant& variant, QsQmlIncubator* incubator);
 
 	QQmlComponent* mDelegate = nullptr;
 	QVariantList mModel;
-	AwfulMap<QVariant, QObject*> mInstances;
+	VariantInstanceTable mInstances;
+	QHash<VariantKey, QsQmlIncubator*> mIncubators;
+	bool mAsynchronous = false;
 	bool loaded = false;
 };
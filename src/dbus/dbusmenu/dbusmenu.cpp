@@ -1,5 +1,6 @@
 #include "dbusmenu.hpp"
 #include <algorithm>
+#include <utility>
 
 #include <qbytearray.h>
 #include <qcontainerfwd.h>
@@ -15,7 +16,9 @@
 #include <qloggingcategory.h>
 #include <qnamespace.h>
 #include <qobject.h>
+#include <qpointer.h>
 #include <qqmllist.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 #include <qvariant.h>
@@ -287,6 +290,15 @@ DBusMenu::DBusMenu(const QString& service, const QString& path, QObject* parent)
 	qDBusRegisterMetaType<DBusMenuItemPropertyNames>();
 	qDBusRegisterMetaType<DBusMenuItemPropertyNamesList>();
 
+	this->staleLayoutTimer.setSingleShot(true);
+	this->staleLayoutTimer.setInterval(0);
+	QObject::connect(
+	    &this->staleLayoutTimer,
+	    &QTimer::timeout,
+	    this,
+	    &DBusMenu::onStaleLayoutTimeout
+	);
+
 	this->interface = new DBusMenuInterface(service, path, QDBusConnection::sessionBus(), this);
 
 	if (!this->interface->isValid()) {
@@ -335,8 +347,10 @@ void DBusMenu::updateLayout(qint32 parent, qint32 depth) {
 			qCWarning(logDbusMenu) << "Error updating layout for menu" << parent << "of" << this
 			                       << reply.error();
 		} else {
+			auto revision = reply.argumentAt<0>();
+			this->updateRevision(revision);
 			auto layout = reply.argumentAt<1>();
-			this->updateLayoutRecursive(layout, this->items.value(parent), depth);
+			this->updateLayoutRecursive(layout, this->items.value(parent), depth, revision);
 		}
 
 		delete call;
@@ -348,15 +362,18 @@ void DBusMenu::updateLayout(qint32 parent, qint32 depth) {
 void DBusMenu::updateLayoutRecursive(
     const DBusMenuLayout& layout,
     DBusMenuItem* parent,
-    qint32 depth
+    qint32 depth,
+    quint32 revision
 ) {
 	auto* item = this->items.value(layout.id);
+	auto created = false;
 	if (item == nullptr) {
 		// there is an actual nullptr in the map and not no entry
 		if (this->items.contains(layout.id)) {
 			item = new DBusMenuItem(layout.id, this, parent);
 			item->mShowChildren = parent != nullptr && parent->mShowChildren;
 			this->items.insert(layout.id, item);
+			created = true;
 		}
 	}
 
@@ -366,6 +383,7 @@ void DBusMenu::updateLayoutRecursive(
 	item->updateProperties(layout.properties);
 
 	if (depth != 0) {
+		item->layoutRevision = revision;
 		auto childrenChanged = false;
 		auto iter = item->mChildren.begin();
 		while (iter != item->mChildren.end()) {
@@ -392,7 +410,7 @@ void DBusMenu::updateLayoutRecursive(
 				childrenChanged = true;
 			}
 
-			this->updateLayoutRecursive(child, item, depth - 1);
+			this->updateLayoutRecursive(child, item, depth - 1, revision);
 		}
 
 		if (childrenChanged) {
@@ -406,7 +424,11 @@ void DBusMenu::updateLayoutRecursive(
 		}
 	}
 
-	if (item->mShowChildren && !item->childrenLoaded) {
+	if (depth == 0 && created && item->mShowChildren && item->displayChildren) {
+		// Added by a partial refresh, which does not include the new item's children.
+		this->updateLayout(item->id, -1);
+	} else if (item->mShowChildren && !item->childrenLoaded && (depth != 0 || created)) {
+		// Existing items left at depth 0 by a partial refresh may still be loading their children.
 		item->childrenLoaded = true;
 	}
 
@@ -452,9 +474,50 @@ void DBusMenu::sendEvent(qint32 item, const QString& event) {
 
 DBusMenuItem* DBusMenu::menu() { return &this->rootItem; }
 
-void DBusMenu::onLayoutUpdated(quint32 /*unused*/, qint32 parent) {
-	// note: spec says this is recursive
-	this->updateLayout(parent, -1);
+void DBusMenu::updateRevision(quint32 revision) {
+	if (this->revisionKnown && revision != this->revision) this->revisionsChange = true;
+	this->revisionKnown = true;
+	this->revision = std::max(this->revision, revision);
+}
+
+void DBusMenu::onLayoutUpdated(quint32 revision, qint32 parent) {
+	// Some applications never change the revision, so only older revisions are ignored.
+	if (revision < this->revision) {
+		qCDebug(logDbusMenu) << "Ignoring outdated layout revision" << revision << "for menu" << parent
+		                     << "of" << this;
+		return;
+	}
+
+	this->updateRevision(revision);
+
+	auto& staleRevision = this->staleItems[parent];
+	staleRevision = std::max(staleRevision, revision);
+	this->staleLayoutTimer.start();
+}
+
+void DBusMenu::onStaleLayoutTimeout() {
+	auto stale = std::exchange(this->staleItems, {});
+
+	for (const auto& [id, revision]: stale.asKeyValueRange()) {
+		auto* item = this->items.value(id);
+		// Children not loaded, so there is nothing to refresh.
+		if (item == nullptr || !item->mShowChildren) continue;
+
+		// A stale root refreshes the whole layout.
+		if (id != 0 && stale.contains(0)) continue;
+
+		// Already fetched at or after the reported revision, usually by a refresh that was
+		// in flight when the application sent the update.
+		if (this->revisionsChange && item->layoutRevision >= revision) {
+			qCDebug(logDbusMenu) << "Skipping refresh of up to date menu" << id << "of" << this;
+			continue;
+		}
+
+		// Per the spec, a parent of 0 means the whole layout is invalid. Otherwise only the
+		// parent's direct children changed, as changes deeper in the tree are reported with
+		// their own parent, so loaded subtrees of existing children are kept.
+		this->updateLayout(id, id == 0 ? -1 : 1);
+	}
 }
 
 void DBusMenu::onItemPropertiesUpdated( // NOLINT
@@ -500,10 +563,29 @@ DBusMenuPngImage::requestImage(const QString& /*unused*/, QSize* size, const QSi
 	return image;
 }
 
+DBusMenuHandle::DBusMenuHandle(QObject* parent): menu::QsMenuHandle(parent) {
+	this->cacheTimer.setSingleShot(true);
+	this->cacheTimer.setInterval(DBusMenuHandle::CACHE_TIME);
+	QObject::connect(&this->cacheTimer, &QTimer::timeout, this, &DBusMenuHandle::onCacheTimeout);
+
+	QObject::connect(
+	    DBusMenuPrefetcher::instance(),
+	    &DBusMenuPrefetcher::enabledChanged,
+	    this,
+	    &DBusMenuHandle::onPrefetchEnabledChanged
+	);
+}
+
+DBusMenuHandle::~DBusMenuHandle() {
+	if (this->refcount != 0) DBusMenuPrefetcher::instance()->menuClosed();
+}
+
 void DBusMenuHandle::setAddress(const QString& service, const QString& path) {
 	if (service == this->service && path == this->path) return;
 	this->service = service;
 	this->path = path;
+	// The new menu is queued again, as it is not loaded yet.
+	this->prefetched = false;
 	this->onMenuPathChanged();
 }
 
@@ -511,11 +593,14 @@ void DBusMenuHandle::refHandle() {
 	this->refcount++;
 	qCDebug(logDbusMenu) << this << "gained a reference. Refcount is now" << this->refcount;
 
-	if (this->refcount == 1 || !this->mMenu) {
+	if (this->refcount == 1) DBusMenuPrefetcher::instance()->menuOpened();
+
+	if (!this->mMenu) {
 		this->onMenuPathChanged();
 	} else {
 		// Refresh the layout when opening a menu in case a bad client isn't updating it
-		// and another ref is open somewhere.
+		// and the menu is cached or another ref is open somewhere. The cached layout is
+		// shown until the response arrives.
 		this->mMenu->rootItem.updateLayout();
 	}
 }
@@ -525,10 +610,53 @@ void DBusMenuHandle::unrefHandle() {
 	qCDebug(logDbusMenu) << this << "lost a reference. Refcount is now" << this->refcount;
 
 	if (this->refcount == 0) {
-		this->onMenuPathChanged();
+		DBusMenuPrefetcher::instance()->menuClosed();
+		this->retain();
+	}
+}
+
+void DBusMenuHandle::prefetch() {
+	if (this->service.isEmpty() || this->path.isEmpty()) return;
+
+	qCDebug(logDbusMenu) << "Prefetching" << this;
+	this->retain();
+	if (!this->mMenu) this->onMenuPathChanged();
+}
+
+void DBusMenuHandle::retain() {
+	this->cached = true;
+	this->cacheTimer.start();
+}
+
+void DBusMenuHandle::onCacheTimeout() {
+	this->cached = false;
+
+	// Kept loaded instead of being fetched again by the prefetcher.
+	if (DBusMenuPrefetcher::instance()->isEnabled()) this->prefetched = true;
+
+	if (this->refcount == 0 && !this->prefetched) this->onMenuPathChanged();
+}
+
+void DBusMenuHandle::onPrefetchEnabledChanged() {
+	if (DBusMenuPrefetcher::instance()->isEnabled()) {
+		this->queuePrefetch();
+	} else if (this->prefetched) {
+		this->prefetched = false;
+		if (this->refcount == 0 && !this->cached) this->onMenuPathChanged();
 	}
 }
 
+void DBusMenuHandle::queuePrefetch() {
+	if (this->mMenu || this->service.isEmpty() || this->path.isEmpty()) return;
+	DBusMenuPrefetcher::instance()->enqueue(this);
+}
+
+void DBusMenuHandle::loadIdle() {
+	qCDebug(logDbusMenu) << "Prefetching" << this << "while idle";
+	this->prefetched = true;
+	if (!this->mMenu) this->onMenuPathChanged();
+}
+
 void DBusMenuHandle::onMenuPathChanged() {
 	qCDebug(logDbusMenu) << "Updating" << this << "with refcount" << this->refcount;
 
@@ -542,7 +670,9 @@ void DBusMenuHandle::onMenuPathChanged() {
 		emit this->menuChanged();
 	}
 
-	if (this->refcount > 0 && !this->service.isEmpty() && !this->path.isEmpty()) {
+	auto keepLoaded = this->refcount > 0 || this->cached || this->prefetched;
+
+	if (keepLoaded && !this->service.isEmpty() && !this->path.isEmpty()) {
 		this->mMenu = new DBusMenu(this->service, this->path);
 		this->mMenu->setParent(this);
 
@@ -553,11 +683,62 @@ void DBusMenuHandle::onMenuPathChanged() {
 		});
 
 		this->mMenu->rootItem.setShowChildrenRecursive(true);
+	} else {
+		this->queuePrefetch();
 	}
 }
 
 QsMenuEntry* DBusMenuHandle::menu() { return this->loaded ? &this->mMenu->rootItem : nullptr; }
 
+DBusMenuPrefetcher::DBusMenuPrefetcher() {
+	this->timer.setInterval(DBusMenuPrefetcher::PREFETCH_INTERVAL);
+	QObject::connect(&this->timer, &QTimer::timeout, this, &DBusMenuPrefetcher::onTimeout);
+}
+
+DBusMenuPrefetcher* DBusMenuPrefetcher::instance() {
+	static auto* instance = new DBusMenuPrefetcher(); // NOLINT
+	return instance;
+}
+
+void DBusMenuPrefetcher::setEnabled(bool enabled) {
+	if (enabled == this->enabled) return;
+	this->enabled = enabled;
+
+	if (!enabled) {
+		this->queue.clear();
+		this->timer.stop();
+	}
+
+	emit this->enabledChanged();
+}
+
+void DBusMenuPrefetcher::enqueue(DBusMenuHandle* handle) {
+	if (!this->enabled || this->queue.contains(handle)) return;
+	this->queue.append(handle);
+	if (!this->timer.isActive()) this->timer.start();
+}
+
+void DBusMenuPrefetcher::remove(DBusMenuHandle* handle) { this->queue.removeAll(handle); }
+
+void DBusMenuPrefetcher::menuOpened() { this->openMenus++; }
+void DBusMenuPrefetcher::menuClosed() { this->openMenus--; }
+
+void DBusMenuPrefetcher::onTimeout() {
+	// Prefetching waits while a menu is open, so it does not compete with that menu's requests.
+	if (this->openMenus != 0) return;
+
+	while (!this->queue.isEmpty()) {
+		auto handle = this->queue.takeFirst();
+
+		if (handle) {
+			handle->loadIdle();
+			break;
+		}
+	}
+
+	if (this->queue.isEmpty()) this->timer.stop();
+}
+
 QDebug operator<<(QDebug debug, const DBusMenuHandle* handle) {
 	if (handle) {
 		auto saver = QDebugStateSaver(debug);
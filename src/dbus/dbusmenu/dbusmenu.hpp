@@ -4,12 +4,16 @@
 #include <qcontainerfwd.h>
 #include <qdebug.h>
 #include <qhash.h>
+#include <qlist.h>
 #include <qloggingcategory.h>
 #include <qnamespace.h>
 #include <qobject.h>
+#include <qpointer.h>
 #include <qqmlintegration.h>
 #include <qqmllist.h>
 #include <qquickimageprovider.h>
+#include <qtclasshelpermacros.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
@@ -76,6 +80,8 @@ public:
 	[[nodiscard]] bool isShowingChildren() const;
 	void setShowChildrenRecursive(bool showChildren);
 
+	[[nodiscard]] DBusMenuItem* parentItem() const { return this->parentMenu; }
+
 	[[nodiscard]] ObjectModel<QsMenuEntry>* children() override;
 
 	void updateProperties(const QVariantMap& properties, const QStringList& removed = {});
@@ -86,6 +92,8 @@ public:
 	QVector<qint32> mChildren;
 	bool mShowChildren = false;
 	bool childrenLoaded = false;
+	// Layout revision the item's children were last fetched at.
+	quint32 layoutRevision = 0;
 	DBusMenu* menu = nullptr;
 
 signals:
@@ -149,8 +157,17 @@ private slots:
 	    const DBusMenuItemPropertyNamesList& removedProps
 	);
 
+	void onStaleLayoutTimeout();
+
 private:
-	void updateLayoutRecursive(const DBusMenuLayout& layout, DBusMenuItem* parent, qint32 depth);
+	void updateLayoutRecursive(
+	    const DBusMenuLayout& layout,
+	    DBusMenuItem* parent,
+	    qint32 depth,
+	    quint32 revision
+	);
+
+	void updateRevision(quint32 revision);
 
 	QS_DBUS_PROPERTY_BINDING(
 	    DBusMenu,
@@ -162,6 +179,16 @@ private:
 	);
 
 	DBusMenuInterface* interface = nullptr;
+	// Latest layout revision seen from LayoutUpdated or GetLayout.
+	quint32 revision = 0;
+	bool revisionKnown = false;
+	// Set once the application has been seen to change its layout revision. Some never do,
+	// in which case revisions cannot be used to skip refreshes.
+	bool revisionsChange = false;
+	// Items reported by LayoutUpdated with the latest revision reported for each,
+	// refetched together once per event loop iteration.
+	QHash<qint32, quint32> staleItems;
+	QTimer staleLayoutTimer;
 };
 
 QDebug operator<<(QDebug debug, DBusMenu* menu);
@@ -172,25 +199,83 @@ QDebug operator<<(QDebug debug, const DBusMenuHandle* handle);
 
 class DBusMenuHandle: public menu::QsMenuHandle {
 public:
-	explicit DBusMenuHandle(QObject* parent): menu::QsMenuHandle(parent) {}
+	explicit DBusMenuHandle(QObject* parent);
+	~DBusMenuHandle() override;
+	Q_DISABLE_COPY_MOVE(DBusMenuHandle);
 
 	void setAddress(const QString& service, const QString& path);
 
 	void refHandle() override;
 	void unrefHandle() override;
 
+	// Loads the menu without showing it, so it can be opened without waiting for the
+	// application. The menu is kept loaded and up to date for CACHE_TIME.
+	void prefetch();
+
 	[[nodiscard]] QsMenuEntry* menu() override;
 
+	// Time a prefetched or closed menu is kept loaded in ms.
+	static constexpr qint32 CACHE_TIME = 30000;
+
 private:
 	void onMenuPathChanged();
+	void onCacheTimeout();
+	void onPrefetchEnabledChanged();
+	// Keeps the menu loaded for CACHE_TIME after the last reference is released.
+	void retain();
+	void queuePrefetch();
+	// Called by DBusMenuPrefetcher. Loads the menu and keeps it loaded while prefetching is enabled.
+	void loadIdle();
 
 	QString service;
 	QString path;
 	DBusMenu* mMenu = nullptr;
 	bool loaded = false;
 	quint32 refcount = 0;
+	// Set while the menu is kept loaded without any references.
+	bool cached = false;
+	// Set while the menu is kept loaded by DBusMenuPrefetcher.
+	bool prefetched = false;
+	QTimer cacheTimer;
 
 	friend QDebug operator<<(QDebug debug, const DBusMenuHandle* handle);
+	friend class DBusMenuPrefetcher;
+};
+
+// Loads the menus of DBusMenuHandles in the background while no menu is open,
+// one every PREFETCH_INTERVAL, and keeps them loaded. Disabled by default.
+class DBusMenuPrefetcher: public QObject {
+	Q_OBJECT;
+
+public:
+	static DBusMenuPrefetcher* instance();
+
+	[[nodiscard]] bool isEnabled() const { return this->enabled; }
+	void setEnabled(bool enabled);
+
+	void enqueue(DBusMenuHandle* handle);
+	void remove(DBusMenuHandle* handle);
+
+	// Called by handles as they gain their first and lose their last reference.
+	void menuOpened();
+	void menuClosed();
+
+	// Time between prefetched menus in ms.
+	static constexpr qint32 PREFETCH_INTERVAL = 1000;
+
+signals:
+	void enabledChanged();
+
+private slots:
+	void onTimeout();
+
+private:
+	explicit DBusMenuPrefetcher();
+
+	bool enabled = false;
+	qsizetype openMenus = 0;
+	QList<QPointer<DBusMenuHandle>> queue;
+	QTimer timer;
 };
 
 } // namespace qs::dbus::dbusmenu
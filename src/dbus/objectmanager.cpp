@@ -12,6 +12,7 @@
 #include "../core/logcat.hpp"
 #include "dbus_objectmanager.h"
 #include "dbus_objectmanager_types.hpp"
+#include "scheduler.hpp"
 
 namespace {
 QS_LOGGING_CATEGORY(logDbusObjectManager, "quickshell.dbus.objectmanager", QtWarningMsg);
@@ -24,11 +25,14 @@ DBusObjectManager::DBusObjectManager(QObject* parent): QObject(parent) {
 	qDBusRegisterMetaType<DBusObjectManagerObjects>();
 }
 
+DBusObjectManager::~DBusObjectManager() { this->unregisterInterface(); }
+
 bool DBusObjectManager::setInterface(
     const QString& service,
     const QString& path,
     const QDBusConnection& connection
 ) {
+	this->unregisterInterface();
 	delete this->mInterface;
 	this->mInterface = new DBusObjectManagerInterface(service, path, connection, this);
 
@@ -54,10 +58,20 @@ bool DBusObjectManager::setInterface(
 	    &DBusObjectManager::interfacesRemoved
 	);
 
+	// Lets property groups of objects under this path be fetched together.
+	DBusPropertyScheduler::forConnection(connection)->registerObjectManager(service, path);
+
 	this->fetchInitialObjects();
 	return true;
 }
 
+void DBusObjectManager::unregisterInterface() {
+	if (!this->mInterface) return;
+
+	DBusPropertyScheduler::forConnection(this->mInterface->connection())
+	    ->unregisterObjectManager(this->mInterface->service(), this->mInterface->path());
+}
+
 void DBusObjectManager::fetchInitialObjects() {
 	if (!this->mInterface) return;
 
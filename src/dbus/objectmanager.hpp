@@ -3,6 +3,7 @@
 #include <qdbusconnection.h>
 #include <qobject.h>
 #include <qstring.h>
+#include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
 
 #include "dbus_objectmanager_types.hpp"
@@ -16,6 +17,8 @@ class DBusObjectManager: public QObject {
 
 public:
 	explicit DBusObjectManager(QObject* parent = nullptr);
+	~DBusObjectManager() override;
+	Q_DISABLE_COPY_MOVE(DBusObjectManager);
 
 	bool setInterface(
 	    const QString& service,
@@ -30,6 +33,7 @@ signals:
 
 private:
 	void fetchInitialObjects();
+	void unregisterInterface();
 
 	DBusObjectManagerInterface* mInterface = nullptr;
 };
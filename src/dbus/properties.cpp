@@ -12,6 +12,7 @@
 #include <qdbuspendingcall.h>
 #include <qdbuspendingreply.h>
 #include <qdebug.h>
+#include <qlatin1stringview.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qmetatype.h>
@@ -21,7 +22,9 @@
 #include <qvariant.h>
 
 #include "../core/logcat.hpp"
+#include "../core/profiler.hpp"
 #include "dbus_properties.h"
+#include "scheduler.hpp"
 
 QS_LOGGING_CATEGORY(logDbusProperties, "quickshell.dbus.properties", QtWarningMsg);
 
@@ -116,14 +119,24 @@ DBusPropertyGroup::DBusPropertyGroup(QVector<DBusPropertyCore*> properties, QObj
     : QObject(parent)
     , properties(std::move(properties)) {}
 
+DBusPropertyGroup::~DBusPropertyGroup() {
+	if (this->scheduler != nullptr) this->scheduler->cancel(this);
+}
+
 void DBusPropertyGroup::setInterface(QDBusAbstractInterface* interface) {
 	if (this->interface != nullptr) {
 		delete this->propertyInterface;
 		this->propertyInterface = nullptr;
 	}
 
+	if (this->scheduler != nullptr) {
+		this->scheduler->cancel(this);
+		this->scheduler = nullptr;
+	}
+
 	if (interface != nullptr) {
 		this->interface = interface;
+		this->scheduler = DBusPropertyScheduler::forConnection(interface->connection());
 
 		this->propertyInterface = new DBusPropertiesInterface(
 		    interface->service(),
@@ -154,7 +167,7 @@ void DBusPropertyGroup::updateAllDirect() {
 	}
 
 	for (auto* property: this->properties) {
-		this->requestPropertyUpdate(property);
+		this->scheduler->fetchProperty(this, property);
 	}
 }
 
@@ -166,28 +179,44 @@ void DBusPropertyGroup::updateAllViaGetAll() {
 		qFatal() << "Attempted to update properties of disconnected property group";
 	}
 
-	auto pendingCall = this->propertyInterface->GetAll(this->interface->interface());
-	auto* call = new QDBusPendingCallWatcher(pendingCall, this);
-
-	auto responseCallback = [this](QDBusPendingCallWatcher* call) {
-		const QDBusPendingReply<QVariantMap> reply = *call;
+	this->scheduler->requestAll(this);
+}
 
-		if (reply.isError()) {
+void DBusPropertyGroup::applyFetchResult(
+    const QVariantMap& values,
+    const QDBusError& error,
+    bool all,
+    const QVector<DBusPropertyCore*>& requested
+) {
+	if (all) {
+		if (error.isValid()) {
 			qCWarning(logDbusProperties).noquote()
 			    << "Error updating properties of" << this->toString() << "via GetAll";
-			qCWarning(logDbusProperties) << reply.error();
-			emit this->getAllFailed(reply.error());
+			qCWarning(logDbusProperties) << error;
+			emit this->getAllFailed(error);
 		} else {
 			qCDebug(logDbusProperties).noquote()
 			    << "Received GetAll property set for" << this->toString();
-			this->updatePropertySet(reply.value(), true);
+			this->updatePropertySet(values, true);
 			emit this->getAllFinished();
 		}
 
-		delete call;
-	};
+		return;
+	}
 
-	QObject::connect(call, &QDBusPendingCallWatcher::finished, this, responseCallback);
+	if (!error.isValid()) {
+		qCDebug(logDbusProperties).noquote()
+		    << "Received batched property set for" << this->toString();
+		this->updatePropertySet(values, false);
+	}
+
+	// Properties the batch could not provide are fetched individually so errors
+	// are reported the same way as for an unbatched update.
+	for (auto* property: requested) {
+		if (error.isValid() || !values.contains(property->name())) {
+			this->scheduler->fetchProperty(this, property);
+		}
+	}
 }
 
 void DBusPropertyGroup::updatePropertySet(const QVariantMap& properties, bool complainMissing) {
@@ -241,28 +270,35 @@ void DBusPropertyGroup::requestPropertyUpdate(DBusPropertyCore* property) {
 
 	qCDebug(logDbusProperties).noquote() << "Updating property" << propStr;
 
-	auto pendingCall = this->propertyInterface->Get(this->interface->interface(), property->name());
-	auto* call = new QDBusPendingCallWatcher(pendingCall, this);
-
-	auto responseCallback = [this, propStr, property](QDBusPendingCallWatcher* call) {
-		const QDBusPendingReply<QDBusVariant> reply = *call;
+	this->scheduler->requestProperty(this, property);
+}
 
-		if (reply.isError()) {
-			if (!property->isRequired() && reply.error().type() == QDBusError::InvalidArgs) {
-				qCDebug(logDbusProperties) << "Error updating non-required property" << propStr;
-				qCDebug(logDbusProperties) << reply.error();
-			} else {
-				qCWarning(logDbusProperties).noquote() << "Error updating property" << propStr;
-				qCWarning(logDbusProperties) << reply.error();
+void DBusPropertyGroup::applyPropertyResult(
+    DBusPropertyCore* property,
+    const QVariant& value,
+    const QDBusError& error
+) {
+	if (error.isValid()) {
+		const QString propStr = this->propertyString(property);
+
+		if (!property->isRequired() && error.type() == QDBusError::InvalidArgs) {
+			qCDebug(logDbusProperties) << "Error updating non-required property" << propStr;
+			qCDebug(logDbusProperties) << error;
+
+			// Optional properties such as a device's RSSI are invalidated when they go away,
+			// so the last value would otherwise be kept forever.
+			if (property->mExists) {
+				property->mExists = false;
+				property->clear();
+				qCDebug(logDbusProperties).noquote() << "Cleared removed property" << propStr;
 			}
 		} else {
-			this->tryUpdateProperty(property, reply.value().variant());
+			qCWarning(logDbusProperties).noquote() << "Error updating property" << propStr;
+			qCWarning(logDbusProperties) << error;
 		}
-
-		delete call;
-	};
-
-	QObject::connect(call, &QDBusPendingCallWatcher::finished, this, responseCallback);
+	} else {
+		this->tryUpdateProperty(property, value);
+	}
 }
 
 void DBusPropertyGroup::pushPropertyUpdate(DBusPropertyCore* property) {
@@ -318,6 +354,8 @@ void DBusPropertyGroup::onPropertiesChanged(
 	qCDebug(logDbusProperties).noquote()
 	    << "Received property change set and invalidations for" << this->toString();
 
+	QsProfiler::countEvent(QLatin1StringView("dbus"), interfaceName);
+
 	for (const auto& name: invalidatedProperties) {
 		auto prop = std::ranges::find_if(this->properties, [&name](DBusPropertyCore* prop) {
 			return prop->nameRef() == name;
@@ -99,6 +99,8 @@ public:
 protected:
 	virtual QDBusError store(const QVariant& variant) = 0;
 	[[nodiscard]] virtual QVariant serialize() = 0;
+	// Resets the value to its default after the property stops existing.
+	virtual void clear() = 0;
 
 private:
 	bool mExists : 1 = false;
@@ -205,6 +207,14 @@ protected:
 		return QDBusError();
 	}
 
+	void clear() override {
+		this->bindable()->setValue(BindableType());
+
+		if constexpr (updatedPtr != nullptr) {
+			(this->owner()->*updatedPtr)();
+		}
+	}
+
 	QVariant serialize() override {
 		if constexpr (bindable_p::HasToWire<Transform>::value) {
 			return QVariant::fromValue(Transform::toWire(this->bindable()->value()));
@@ -225,12 +235,16 @@ private:
 	[[nodiscard]] constexpr Bindable* bindable() const { return &(this->owner()->*bindablePtr); }
 };
 
+class DBusPropertyScheduler;
+
 class DBusPropertyGroup: public QObject {
 	Q_OBJECT;
 
 public:
 	explicit DBusPropertyGroup(QVector<DBusPropertyCore*> properties = {}, QObject* parent = nullptr);
 	explicit DBusPropertyGroup(QObject* parent): DBusPropertyGroup({}, parent) {}
+	~DBusPropertyGroup() override;
+	Q_DISABLE_COPY_MOVE(DBusPropertyGroup);
 
 	void setInterface(QDBusAbstractInterface* interface);
 	void attachProperty(DBusPropertyCore* property);
@@ -258,11 +272,22 @@ private:
 	void tryUpdateProperty(DBusPropertyCore* property, const QVariant& variant) const;
 	[[nodiscard]] QString propertyString(const DBusPropertyCore* property) const;
 
+	void applyPropertyResult(DBusPropertyCore* property, const QVariant& value, const QDBusError& error);
+
+	void applyFetchResult(
+	    const QVariantMap& values,
+	    const QDBusError& error,
+	    bool all,
+	    const QVector<DBusPropertyCore*>& requested
+	);
+
 	DBusPropertiesInterface* propertyInterface = nullptr;
 	QDBusAbstractInterface* interface = nullptr;
+	DBusPropertyScheduler* scheduler = nullptr;
 	QVector<DBusPropertyCore*> properties;
 
 	friend class AbstractDBusProperty;
+	friend class DBusPropertyScheduler;
 };
 
 } // namespace qs::dbus
@@ -0,0 +1,285 @@
+#include "scheduler.hpp"
+#include <algorithm>
+#include <utility>
+
+#include <qcontainerfwd.h>
+#include <qdbusconnection.h>
+#include <qdbuserror.h>
+#include <qdbusextratypes.h>
+#include <qdbusmessage.h>
+#include <qdbuspendingcall.h>
+#include <qdbuspendingreply.h>
+#include <qelapsedtimer.h>
+#include <qhash.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qpointer.h>
+#include <qstring.h>
+#include <qtmetamacros.h>
+
+#include "../core/logcat.hpp"
+#include "dbus_objectmanager_types.hpp"
+#include "dbus_properties.h"
+#include "properties.hpp"
+
+namespace {
+QS_LOGGING_CATEGORY(logDbusScheduler, "quickshell.dbus.scheduler", QtWarningMsg);
+}
+
+namespace qs::dbus {
+
+DBusPropertyScheduler::DBusPropertyScheduler(const QDBusConnection& connection)
+    : connection(connection) {}
+
+DBusPropertyScheduler* DBusPropertyScheduler::forConnection(const QDBusConnection& connection) {
+	static auto schedulers = QHash<QString, DBusPropertyScheduler*>(); // NOLINT
+
+	auto*& scheduler = schedulers[connection.name()];
+	if (!scheduler) scheduler = new DBusPropertyScheduler(connection);
+	return scheduler;
+}
+
+void DBusPropertyScheduler::requestProperty(DBusPropertyGroup* group, DBusPropertyCore* property) {
+	this->mStats.requests++;
+	this->pendingRequests++;
+
+	auto& fetch = this->pending[group];
+	if (!fetch.all && !fetch.properties.contains(property)) fetch.properties.append(property);
+
+	this->queueFlush();
+}
+
+void DBusPropertyScheduler::requestAll(DBusPropertyGroup* group) {
+	this->mStats.requests++;
+	this->pendingRequests++;
+
+	auto& fetch = this->pending[group];
+	fetch.all = true;
+	fetch.properties.clear();
+
+	this->queueFlush();
+}
+
+void DBusPropertyScheduler::cancel(DBusPropertyGroup* group) { this->pending.remove(group); }
+
+void DBusPropertyScheduler::registerObjectManager(const QString& service, const QString& path) {
+	this->objectManagers.insert(service, path);
+}
+
+void DBusPropertyScheduler::unregisterObjectManager(const QString& service, const QString& path) {
+	if (this->objectManagers.value(service) == path) this->objectManagers.remove(service);
+}
+
+void DBusPropertyScheduler::queueFlush() {
+	if (this->flushQueued) return;
+	this->flushQueued = true;
+	QMetaObject::invokeMethod(this, &DBusPropertyScheduler::flush, Qt::QueuedConnection);
+}
+
+void DBusPropertyScheduler::flush() {
+	this->flushQueued = false;
+	auto pending = std::exchange(this->pending, {});
+	auto requests = std::exchange(this->pendingRequests, 0);
+	auto callsBefore = this->mStats.calls();
+
+	auto managedBatches = QHash<QString, QVector<BatchEntry>>();
+
+	for (const auto& [group, fetch]: pending.asKeyValueRange()) {
+		if (group->propertyInterface == nullptr) continue;
+
+		// A single Get is cheaper than a GetAll for a lone invalidation.
+		if (!fetch.all && fetch.properties.length() == 1) {
+			this->fetchProperty(group, fetch.properties.first());
+			continue;
+		}
+
+		auto service = group->interface->service();
+		if (this->objectManagerRoot(service, group->interface->path()).isEmpty()) {
+			this->fetchAll(group, fetch);
+		} else {
+			managedBatches[service].append({.group = group, .fetch = fetch});
+		}
+	}
+
+	for (const auto& [service, batch]: managedBatches.asKeyValueRange()) {
+		if (batch.length() == 1) {
+			this->fetchAll(batch.first().group, batch.first().fetch);
+		} else {
+			this->fetchManagedObjects(service, this->objectManagers.value(service), batch);
+		}
+	}
+
+	qCDebug(logDbusScheduler) << "Flushed" << requests << "property requests as"
+	                          << this->mStats.calls() - callsBefore << "calls on"
+	                          << this->connection.name();
+	qCDebug(logDbusScheduler) << "Totals for" << this->connection.name() << "-" << this->mStats.requests
+	                          << "requests," << this->mStats.calls() << "calls,"
+	                          << this->mStats.errors << "errors, average latency"
+	                          << (this->mStats.calls() == 0
+	                                  ? 0
+	                                  : this->mStats.totalLatencyNs
+	                                        / static_cast<qint64>(this->mStats.calls()) / 1000)
+	                          << "us, max latency" << this->mStats.maxLatencyNs / 1000 << "us";
+}
+
+void DBusPropertyScheduler::fetchProperty(DBusPropertyGroup* group, DBusPropertyCore* property) {
+	if (group->propertyInterface == nullptr) return;
+
+	this->mStats.getCalls++;
+
+	auto timer = QElapsedTimer();
+	timer.start();
+
+	auto pendingCall = group->propertyInterface->Get(group->interface->interface(), property->name());
+	auto* call = new QDBusPendingCallWatcher(pendingCall, group);
+
+	auto responseCallback = [this, group, property, timer](QDBusPendingCallWatcher* call) {
+		const QDBusPendingReply<QDBusVariant> reply = *call;
+		this->recordCall("Get", group->toString(), timer, reply.isError());
+
+		if (reply.isError()) {
+			group->applyPropertyResult(property, QVariant(), reply.error());
+		} else {
+			group->applyPropertyResult(property, reply.value().variant(), QDBusError());
+		}
+
+		delete call;
+	};
+
+	QObject::connect(call, &QDBusPendingCallWatcher::finished, group, responseCallback);
+}
+
+void DBusPropertyScheduler::fetchAll(DBusPropertyGroup* group, const PendingFetch& fetch) {
+	if (group->propertyInterface == nullptr) return;
+
+	this->mStats.getAllCalls++;
+
+	auto timer = QElapsedTimer();
+	timer.start();
+
+	auto pendingCall = group->propertyInterface->GetAll(group->interface->interface());
+	auto* call = new QDBusPendingCallWatcher(pendingCall, group);
+
+	auto responseCallback = [this, group, fetch, timer](QDBusPendingCallWatcher* call) {
+		const QDBusPendingReply<QVariantMap> reply = *call;
+		this->recordCall("GetAll", group->toString(), timer, reply.isError());
+
+		if (reply.isError()) {
+			group->applyFetchResult(QVariantMap(), reply.error(), fetch.all, fetch.properties);
+		} else {
+			group->applyFetchResult(reply.value(), QDBusError(), fetch.all, fetch.properties);
+		}
+
+		delete call;
+	};
+
+	QObject::connect(call, &QDBusPendingCallWatcher::finished, group, responseCallback);
+}
+
+void DBusPropertyScheduler::fetchManagedObjects(
+    const QString& service,
+    const QString& root,
+    const QVector<BatchEntry>& batch
+) {
+	struct ManagedFetch {
+		QPointer<DBusPropertyGroup> group;
+		QString path;
+		QString interface;
+		PendingFetch fetch;
+	};
+
+	this->mStats.managedObjectsCalls++;
+
+	auto fetches = QVector<ManagedFetch>();
+	for (const auto& entry: batch) {
+		fetches.append({
+		    .group = entry.group,
+		    .path = entry.group->interface->path(),
+		    .interface = entry.group->interface->interface(),
+		    .fetch = entry.fetch,
+		});
+	}
+
+	auto timer = QElapsedTimer();
+	timer.start();
+
+	auto message = QDBusMessage::createMethodCall(
+	    service,
+	    root,
+	    "org.freedesktop.DBus.ObjectManager",
+	    "GetManagedObjects"
+	);
+
+	auto pendingCall = this->connection.asyncCall(message);
+	auto* call = new QDBusPendingCallWatcher(pendingCall, this);
+
+	auto responseCallback = [this, target = service + root, fetches, timer](
+	                            QDBusPendingCallWatcher* call
+	                        ) {
+		const QDBusPendingReply<DBusObjectManagerObjects> reply = *call;
+		this->recordCall("GetManagedObjects", target, timer, reply.isError());
+
+		if (reply.isError()) {
+			qCDebug(logDbusScheduler) << "Falling back to GetAll for" << fetches.length()
+			                          << "objects of" << target << "after error" << reply.error();
+		}
+
+		auto objects = reply.isError() ? DBusObjectManagerObjects() : reply.value();
+
+		for (const auto& entry: fetches) {
+			auto* group = entry.group.data();
+			if (group == nullptr || group->propertyInterface == nullptr) continue;
+
+			// The group may have been pointed at another object while the call was in flight.
+			if (group->interface->path() != entry.path || group->interface->interface() != entry.interface)
+			{
+				continue;
+			}
+
+			auto object = objects.constFind(QDBusObjectPath(entry.path));
+			if (object != objects.constEnd()) {
+				auto properties = object->constFind(entry.interface);
+				if (properties != object->constEnd()) {
+					group->applyFetchResult(*properties, QDBusError(), entry.fetch.all, entry.fetch.properties);
+					continue;
+				}
+			}
+
+			// Not exported through the object manager.
+			this->fetchAll(group, entry.fetch);
+		}
+
+		delete call;
+	};
+
+	QObject::connect(call, &QDBusPendingCallWatcher::finished, this, responseCallback);
+}
+
+QString DBusPropertyScheduler::objectManagerRoot(const QString& service, const QString& path) const {
+	auto root = this->objectManagers.value(service);
+	if (root.isEmpty()) return QString();
+
+	if (root == "/" || path == root || path.startsWith(root + '/')) return root;
+	return QString();
+}
+
+void DBusPropertyScheduler::recordCall(
+    const char* method,
+    const QString& target,
+    const QElapsedTimer& timer,
+    bool error
+) {
+	auto elapsed = timer.nsecsElapsed();
+
+	this->mStats.totalLatencyNs += elapsed;
+	this->mStats.maxLatencyNs = std::max(this->mStats.maxLatencyNs, elapsed);
+	if (error) this->mStats.errors++;
+
+	qCDebug(logDbusScheduler).noquote()
+	    << method << "for" << target << (error ? "failed" : "completed") << "in" << elapsed / 1000
+	    << "us";
+}
+
+} // namespace qs::dbus
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <qcontainerfwd.h>
+#include <qdbusconnection.h>
+#include <qelapsedtimer.h>
+#include <qhash.h>
+#include <qobject.h>
+#include <qstring.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+
+namespace qs::dbus {
+
+class DBusPropertyCore;
+class DBusPropertyGroup;
+
+// Batches property fetches for a single connection.
+//
+// Requests made within the same event loop iteration are merged per object, so
+// several invalidated properties of one object are fetched with a single GetAll,
+// and GetAll requests for several objects of a service exposing an ObjectManager
+// are fetched with a single GetManagedObjects.
+class DBusPropertyScheduler: public QObject {
+	Q_OBJECT;
+
+public:
+	struct Stats {
+		quint64 requests = 0;
+		quint64 getCalls = 0;
+		quint64 getAllCalls = 0;
+		quint64 managedObjectsCalls = 0;
+		quint64 errors = 0;
+		qint64 totalLatencyNs = 0;
+		qint64 maxLatencyNs = 0;
+
+		[[nodiscard]] quint64 calls() const {
+			return this->getCalls + this->getAllCalls + this->managedObjectsCalls;
+		}
+	};
+
+	static DBusPropertyScheduler* forConnection(const QDBusConnection& connection);
+
+	void requestProperty(DBusPropertyGroup* group, DBusPropertyCore* property);
+	void requestAll(DBusPropertyGroup* group);
+	void cancel(DBusPropertyGroup* group);
+
+	// Fetches a property immediately, bypassing batching.
+	void fetchProperty(DBusPropertyGroup* group, DBusPropertyCore* property);
+
+	void registerObjectManager(const QString& service, const QString& path);
+	void unregisterObjectManager(const QString& service, const QString& path);
+
+	[[nodiscard]] const Stats& stats() const { return this->mStats; }
+
+private slots:
+	void flush();
+
+private:
+	explicit DBusPropertyScheduler(const QDBusConnection& connection);
+
+	struct PendingFetch {
+		bool all = false;
+		QVector<DBusPropertyCore*> properties;
+	};
+
+	struct BatchEntry {
+		DBusPropertyGroup* group = nullptr;
+		PendingFetch fetch;
+	};
+
+	void queueFlush();
+	void fetchAll(DBusPropertyGroup* group, const PendingFetch& fetch);
+	void fetchManagedObjects(const QString& service, const QString& root, const QVector<BatchEntry>& batch);
+	[[nodiscard]] QString objectManagerRoot(const QString& service, const QString& path) const;
+	void recordCall(const char* method, const QString& target, const QElapsedTimer& timer, bool error);
+
+	QDBusConnection connection;
+	QHash<DBusPropertyGroup*, PendingFetch> pending;
+	QHash<QString, QString> objectManagers;
+	quint64 pendingRequests = 0;
+	bool flushQueued = false;
+	Stats mStats;
+};
+
+} // namespace qs::dbus
@@ -5,12 +5,14 @@ FileViewInternal {
 	property bool blockLoading: this.__blockLoading;
 	property bool blockAllReads: this.__blockAllReads;
 	property bool printErrors: this.__printErrors;
+	property bool textOnly: this.__textOnly;
 	property string path: this.__path;
 
 	onPreloadChanged: this.__preload = preload;
 	onBlockLoadingChanged: this.__blockLoading = this.blockLoading;
 	onBlockAllReadsChanged: this.__blockAllReads = this.blockAllReads;
 	onPrintErrorsChanged: this.__printErrors = this.printErrors;
+	onTextOnlyChanged: this.__textOnly = this.textOnly;
 
 	// Unfortunately path can't be kept as an empty string until the file loads
 	// without using QQmlPropertyValueInterceptor which is private. If we lean fully
@@ -19,6 +21,7 @@ FileViewInternal {
 	onPathChanged: {
 		if (!this.preload) this.__preload = false;
 		this.__printErrors = this.printErrors;
+		this.__textOnly = this.textOnly;
 		this.__path = this.path;
 		if (this.preload) this.__preload = true;
 	}
@@ -34,6 +37,7 @@ FileViewInternal {
 		this.__blockLoading = this.blockLoading;
 		this.__blockAllReads = this.blockAllReads;
 		this.__printErrors = this.printErrors;
+		this.__textOnly = this.textOnly;
 		this.__path = this.path;
 		const text = this.__text;
 		if (this.preload) this.__preload = true;
@@ -45,6 +49,7 @@ FileViewInternal {
 		this.__blockLoading = this.blockLoading;
 		this.__blockAllReads = this.blockAllReads;
 		this.__printErrors = this.printErrors;
+		this.__textOnly = this.textOnly;
 		this.__path = this.path;
 		const data = this.__data;
 		if (this.preload) this.__preload = true;
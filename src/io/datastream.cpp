@@ -2,10 +2,26 @@
 #include <algorithm>
 #include <utility>
 
+#include <qbytearray.h>
+#include <qbytearrayview.h>
+#include <qjsondocument.h>
 #include <qlocalsocket.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qnamespace.h>
 #include <qobject.h>
+#include <qobjectdefs.h>
+#include <qstring.h>
+#include <qthreadpool.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
+#include <qvariant.h>
+
+#include "../core/logcat.hpp"
+
+namespace {
+QS_LOGGING_CATEGORY(logStdioCollector, "quickshell.io.stdiocollector", QtWarningMsg);
+}
 
 DataStreamParser* DataStream::reader() const { return this->mReader; }
 
@@ -112,22 +128,194 @@ void SplitParser::setSplitMarker(QString marker) {
 	emit this->splitMarkerChanged();
 }
 
+StdioJsonParser::StdioJsonParser(QByteArray data): data(std::move(data)) {
+	this->setAutoDelete(false);
+}
+
+void StdioJsonParser::run() {
+	auto error = QJsonParseError();
+	auto document = QJsonDocument::fromJson(this->data, &error);
+
+	if (error.error == QJsonParseError::NoError) {
+		this->result = document.toVariant();
+	} else {
+		this->result = QVariant::fromValue(nullptr);
+		this->error = QString("%1 at offset %2").arg(error.errorString()).arg(error.offset);
+	}
+
+	// Dropped here so the buffer is not held by the queued call.
+	this->data = QByteArray();
+	QMetaObject::invokeMethod(this, &StdioJsonParser::finished, Qt::QueuedConnection);
+}
+
+void StdioJsonParser::finished() {
+	emit this->done();
+	delete this;
+}
+
+StdioCollector::StdioCollector(QObject* parent): DataStreamParser(parent) {
+	this->updateTimer.setSingleShot(true);
+	this->updateTimer.setInterval(0);
+	QObject::connect(&this->updateTimer, &QTimer::timeout, this, &StdioCollector::onUpdateTimeout);
+}
+
 void StdioCollector::parseBytes(QByteArray& incoming, QByteArray& buffer) {
-	buffer.append(incoming);
+	// The collector keeps its own buffers, so nothing is left in the stream's buffer.
+	// incoming may be the stream's buffer when the parser is attached mid stream.
+	this->append(incoming);
+	buffer.clear();
 
-	if (!this->mWaitForEnd) {
-		this->mData = buffer;
-		emit this->dataChanged();
+	if (this->mWaitForEnd) return;
+
+	if (this->updateTimer.interval() == 0) {
+		this->publish();
+	} else if (this->updateTimer.isActive()) {
+		this->updatePending = true;
+	} else {
+		this->publish();
+		this->updateTimer.start();
 	}
 }
 
+void StdioCollector::onUpdateTimeout() {
+	if (!this->updatePending) return;
+	this->updatePending = false;
+	this->publish();
+	this->updateTimer.start();
+}
+
 void StdioCollector::streamEnded(QByteArray& buffer) {
-	if (this->mWaitForEnd) {
-		this->mData = buffer;
-		emit this->dataChanged();
+	if (!buffer.isEmpty()) {
+		this->append(buffer);
+		buffer.clear();
 	}
 
+	this->updateTimer.stop();
+	this->updatePending = false;
+
+	// Always published, as the last reads may have been held back by updateInterval.
+	this->publish();
+
+	// Assembled now so the capture buffers can be released without copying.
+	auto data = this->data();
+	this->head = QByteArray();
+	this->tail = QByteArray();
+	this->dropped = false;
+	this->mData = data;
+	this->dataCached = true;
+	this->dataStale = false;
+
 	emit this->streamFinished();
+
+	if (this->mParseJson) {
+		// Results of earlier parses still in progress are ignored.
+		this->jsonParser = new StdioJsonParser(data);
+		QObject::connect(this->jsonParser, &StdioJsonParser::done, this, &StdioCollector::onJsonParsed);
+		QThreadPool::globalInstance()->start(this->jsonParser);
+	}
+}
+
+void StdioCollector::onJsonParsed() {
+	auto* parser = qobject_cast<StdioJsonParser*>(this->sender());
+	if (parser != this->jsonParser) return;
+	this->jsonParser = nullptr;
+
+	if (!parser->error.isEmpty()) {
+		qCWarning(logStdioCollector) << this << "failed to parse output as json:" << parser->error;
+	}
+
+	this->mJson = parser->result;
+	this->mJsonError = parser->error;
+	emit this->jsonChanged();
+}
+
+qsizetype StdioCollector::headLimit() const {
+	auto maxBytes = static_cast<qsizetype>(this->mMaxBytes);
+
+	switch (this->mTruncation) {
+	case StdioTruncation::KeepHead: return maxBytes;
+	case StdioTruncation::KeepTail: return 0;
+	case StdioTruncation::KeepHeadAndTail: return maxBytes / 2;
+	}
+
+	return maxBytes;
+}
+
+void StdioCollector::append(QByteArrayView data) {
+	if (this->mMaxBytes <= 0) {
+		this->head.append(data);
+		return;
+	}
+
+	auto headLimit = this->headLimit();
+	auto tailLimit = static_cast<qsizetype>(this->mMaxBytes) - headLimit;
+
+	if (this->head.size() < headLimit) {
+		auto length = std::min(headLimit - this->head.size(), data.size());
+		this->head.append(data.first(length));
+		data = data.sliced(length);
+	}
+
+	if (data.isEmpty()) return;
+
+	if (tailLimit == 0) {
+		this->dropped = true;
+		return;
+	}
+
+	if (data.size() >= tailLimit) {
+		if (data.size() > tailLimit || !this->tail.isEmpty()) this->dropped = true;
+		this->tail.clear();
+		this->tail.append(data.last(tailLimit));
+		return;
+	}
+
+	this->tail.append(data);
+
+	if (this->tail.size() > tailLimit) {
+		this->dropped = true;
+
+		// Trimmed only after doubling, so the cost of moving the tail is amortized over the
+		// reads that filled it.
+		if (this->tail.size() > tailLimit * 2) this->tail.remove(0, this->tail.size() - tailLimit);
+	}
+}
+
+void StdioCollector::publish() {
+	this->dataCached = !this->tail.isEmpty();
+	this->dataStale = this->dataCached;
+	this->publishedHeadSize = this->head.size();
+	if (!this->dataCached) this->mData = QByteArray();
+	this->mTruncated = this->dropped;
+	emit this->dataChanged();
+}
+
+QString StdioCollector::text() const {
+	if (this->dataCached) return QString::fromUtf8(this->data());
+	return QString::fromUtf8(QByteArrayView(this->head).first(this->publishedHeadSize));
+}
+
+QByteArray StdioCollector::data() const {
+	if (!this->dataCached) {
+		// Only copied if reads were appended after the last update.
+		if (this->head.size() == this->publishedHeadSize) return this->head;
+		return this->head.first(this->publishedHeadSize);
+	}
+
+	if (this->dataStale) {
+		this->dataStale = false;
+
+		auto tailLimit = static_cast<qsizetype>(this->mMaxBytes) - this->headLimit();
+		auto tail = QByteArrayView(this->tail);
+		if (this->mMaxBytes > 0 && tail.size() > tailLimit) tail = tail.last(tailLimit);
+
+		this->mData = QByteArray();
+		this->mData.reserve(this->head.size() + tail.size());
+		this->mData.append(this->head);
+		this->mData.append(tail);
+	}
+
+	return this->mData;
 }
 
 void StdioCollector::setWaitForEnd(bool waitForEnd) {
@@ -135,3 +323,37 @@ void StdioCollector::setWaitForEnd(bool waitForEnd) {
 	this->mWaitForEnd = waitForEnd;
 	emit this->waitForEndChanged();
 }
+
+void StdioCollector::setMaxBytes(qint64 maxBytes) {
+	if (maxBytes < 0) maxBytes = 0;
+	if (maxBytes == this->mMaxBytes) return;
+	this->mMaxBytes = maxBytes;
+	emit this->maxBytesChanged();
+}
+
+void StdioCollector::setTruncation(StdioTruncation::Enum truncation) {
+	if (truncation == this->mTruncation) return;
+	this->mTruncation = truncation;
+	emit this->truncationChanged();
+}
+
+void StdioCollector::setUpdateInterval(qint32 updateInterval) {
+	if (updateInterval < 0) updateInterval = 0;
+	if (updateInterval == this->updateTimer.interval()) return;
+	this->updateTimer.setInterval(updateInterval);
+	emit this->updateIntervalChanged();
+}
+
+void StdioCollector::setParseJson(bool parseJson) {
+	if (parseJson == this->mParseJson) return;
+	this->mParseJson = parseJson;
+
+	if (!parseJson && (this->jsonParser != nullptr || !this->mJson.isNull())) {
+		this->jsonParser = nullptr;
+		this->mJson = QVariant::fromValue(nullptr);
+		this->mJsonError = QString();
+		emit this->jsonChanged();
+	}
+
+	emit this->parseJsonChanged();
+}
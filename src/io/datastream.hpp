@@ -1,11 +1,15 @@
 #pragma once
 
 #include <qbytearray.h>
+#include <qbytearrayview.h>
 #include <qcontainerfwd.h>
 #include <qlocalsocket.h>
 #include <qobject.h>
 #include <qqmlintegration.h>
+#include <qrunnable.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 #include <qvariant.h>
 
 class DataStreamParser;
@@ -90,11 +94,90 @@ private:
 	bool mSplitMarkerChanged = false;
 };
 
+///! Part of the output kept by StdioCollector when it exceeds the byte limit.
+/// See @@StdioCollector.maxBytes.
+namespace StdioTruncation { // NOLINT
+Q_NAMESPACE;
+QML_ELEMENT;
+
+enum Enum : quint8 {
+	/// Keep the start of the output, and drop everything after the limit.
+	KeepHead = 0,
+	/// Keep the end of the output, dropping the oldest data.
+	KeepTail = 1,
+	/// Keep the start and the end of the output, each taking half of the limit,
+	/// and drop the middle.
+	KeepHeadAndTail = 2,
+};
+Q_ENUM_NS(Enum);
+} // namespace StdioTruncation
+
+class StdioCollector;
+
+// Parses collected output as json on the thread pool.
+class StdioJsonParser
+    : public QObject
+    , public QRunnable {
+	Q_OBJECT;
+
+public:
+	explicit StdioJsonParser(QByteArray data);
+
+	void run() override;
+
+	QVariant result;
+	QString error;
+
+signals:
+	void done();
+
+private slots:
+	void finished();
+
+private:
+	QByteArray data;
+};
+
 ///! DataStreamParser that collects all output into a buffer
 /// StdioCollector collects all process output into a buffer exposed as @@text or @@data.
+///
+/// #### Large output
+/// Commands which produce a lot of output should set @@maxBytes to bound memory usage,
+/// and @@updateInterval if @@waitForEnd is false, to avoid reevaluating bindings
+/// for every read.
+///
+/// ```qml
+/// Process {
+///   command: ["journalctl", "-b", "-f"]
+///   running: true
+///
+///   stdout: StdioCollector {
+///     waitForEnd: false
+///     maxBytes: 64 * 1024
+///     truncation: StdioTruncation.KeepTail
+///     updateInterval: 250
+///   }
+/// }
+/// ```
+///
+/// #### JSON output
+/// Output can be parsed as json in the background once the stream ends, by setting @@parseJson.
+///
+/// ```qml
+/// Process {
+///   command: ["hyprctl", "clients", "-j"]
+///   running: true
+///
+///   stdout: StdioCollector {
+///     parseJson: true
+///     onJsonChanged: console.log(json.length, "clients")
+///   }
+/// }
+/// ```
 class StdioCollector: public DataStreamParser {
 	Q_OBJECT;
 	QML_ELEMENT;
+	// clang-format off
 	/// The stdio buffer exposed as text. if @@waitForEnd is true, this will not change
 	/// until the stream ends.
 	Q_PROPERTY(QString text READ text NOTIFY dataChanged);
@@ -105,25 +188,107 @@ class StdioCollector: public DataStreamParser {
 	Q_PROPERTY(QByteArray data READ data NOTIFY dataChanged);
 	/// If true, @@text and @@data will not be updated until the stream ends. Defaults to true.
 	Q_PROPERTY(bool waitForEnd READ waitForEnd WRITE setWaitForEnd NOTIFY waitForEndChanged);
+	/// The maximum number of bytes kept, or 0 for no limit. Defaults to 0.
+	///
+	/// When the output exceeds this limit, the part selected by @@truncation is kept
+	/// and the rest is dropped as it is read. Limits are applied to bytes, and may split
+	/// multibyte characters at the edges of the kept parts.
+	Q_PROPERTY(qint64 maxBytes READ maxBytes WRITE setMaxBytes NOTIFY maxBytesChanged);
+	/// The part of the output kept when it exceeds @@maxBytes.
+	/// Defaults to `StdioTruncation.KeepHeadAndTail`.
+	Q_PROPERTY(StdioTruncation::Enum truncation READ truncation WRITE setTruncation NOTIFY truncationChanged);
+	/// If any output was dropped from @@text and @@data due to @@maxBytes.
+	Q_PROPERTY(bool truncated READ truncated NOTIFY dataChanged);
+	/// The minimum time between updates of @@text and @@data in milliseconds
+	/// while @@waitForEnd is false, or 0 to update after every read. Defaults to 0.
+	///
+	/// The first read after a quiet period is reported immediately, and later reads
+	/// are combined until the interval has passed.
+	Q_PROPERTY(qint32 updateInterval READ updateInterval WRITE setUpdateInterval NOTIFY updateIntervalChanged);
+	/// If true, the output will be parsed as json in the background when the stream ends,
+	/// and the result exposed as @@json. Defaults to false.
+	Q_PROPERTY(bool parseJson READ parseJson WRITE setParseJson NOTIFY parseJsonChanged);
+	/// The output parsed as json, or null if @@parseJson is false, the stream has not ended yet,
+	/// or the output is not valid json. Updated shortly after @@streamFinished(s).
+	///
+	/// Parse errors are logged, and exposed as @@jsonError.
+	Q_PROPERTY(QVariant json READ json NOTIFY jsonChanged);
+	/// The error encountered when parsing @@json, or an empty string if parsing succeeded.
+	Q_PROPERTY(QString jsonError READ jsonError NOTIFY jsonChanged);
+	// clang-format on
 
 public:
-	explicit StdioCollector(QObject* parent = nullptr): DataStreamParser(parent) {}
+	explicit StdioCollector(QObject* parent = nullptr);
 
 	void parseBytes(QByteArray& incoming, QByteArray& buffer) override;
 	void streamEnded(QByteArray& buffer) override;
 
-	[[nodiscard]] QString text() const { return this->mData; }
-	[[nodiscard]] QByteArray data() const { return this->mData; }
+	[[nodiscard]] QString text() const;
+	[[nodiscard]] QByteArray data() const;
 
 	[[nodiscard]] bool waitForEnd() const { return this->mWaitForEnd; }
 	void setWaitForEnd(bool waitForEnd);
 
+	[[nodiscard]] qint64 maxBytes() const { return this->mMaxBytes; }
+	void setMaxBytes(qint64 maxBytes);
+
+	[[nodiscard]] StdioTruncation::Enum truncation() const { return this->mTruncation; }
+	void setTruncation(StdioTruncation::Enum truncation);
+
+	[[nodiscard]] bool truncated() const { return this->mTruncated; }
+
+	[[nodiscard]] qint32 updateInterval() const { return this->updateTimer.interval(); }
+	void setUpdateInterval(qint32 updateInterval);
+
+	[[nodiscard]] bool parseJson() const { return this->mParseJson; }
+	void setParseJson(bool parseJson);
+
+	[[nodiscard]] QVariant json() const { return this->mJson; }
+	[[nodiscard]] QString jsonError() const { return this->mJsonError; }
+
 signals:
 	void waitForEndChanged();
 	void dataChanged();
 	void streamFinished();
+	void maxBytesChanged();
+	void truncationChanged();
+	void updateIntervalChanged();
+	void parseJsonChanged();
+	void jsonChanged();
+
+private slots:
+	void onUpdateTimeout();
+	void onJsonParsed();
 
 private:
+	void append(QByteArrayView data);
+	void publish();
+	[[nodiscard]] qsizetype headLimit() const;
+
 	bool mWaitForEnd = true;
-	QByteArray mData;
+	qint64 mMaxBytes = 0;
+	StdioTruncation::Enum mTruncation = StdioTruncation::KeepHeadAndTail;
+	bool mParseJson = false;
+
+	// Output of the current stream. The tail is trimmed lazily, and may hold up to twice its limit.
+	QByteArray head;
+	QByteArray tail;
+	bool dropped = false;
+
+	// The published output is only assembled from the capture buffers when read,
+	// so throttled updates which are never read do not copy the buffers.
+	// Without a tail it is read from the head directly, as a cached copy would share
+	// the head and force the next append to copy all of it.
+	mutable QByteArray mData;
+	mutable bool dataStale = false;
+	bool dataCached = false;
+	qsizetype publishedHeadSize = 0;
+	bool mTruncated = false;
+
+	QTimer updateTimer;
+	bool updatePending = false;
+
+	StdioJsonParser* jsonParser = nullptr;
+	QVariant mJson = QVariant::fromValue(nullptr);
+	QString mJsonError;
 };
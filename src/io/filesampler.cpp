@@ -0,0 +1,396 @@
+#include "filesampler.hpp"
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <qbytearray.h>
+#include <qbytearrayview.h>
+#include <qcontainerfwd.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qobjectdefs.h>
+#include <qstring.h>
+#include <qthread.h>
+#include <qtimer.h>
+#include <qtypes.h>
+#include <qvariant.h>
+#include <unistd.h>
+
+#include "../core/logcat.hpp"
+
+namespace qs::io {
+
+namespace {
+QS_LOGGING_CATEGORY(logFileSampler, "quickshell.io.filesampler", QtWarningMsg);
+
+// Most procfs and sysfs files fit in a single page.
+constexpr qsizetype INITIAL_BUFFER_SIZE = 4096;
+
+bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+QVariant parseNumber(QByteArrayView value, bool* ok) {
+	auto integer = value.toLongLong(ok);
+	if (*ok) return integer;
+
+	auto real = value.toDouble(ok);
+	if (*ok) return real;
+
+	return QVariant();
+}
+
+QVariant parseValue(QByteArrayView value) {
+	value = value.trimmed();
+
+	auto ok = false;
+	auto number = parseNumber(value, &ok);
+	if (ok) return number;
+
+	// Numbers with a trailing unit, e.g. "16318856 kB".
+	auto space = value.indexOf(' ');
+	if (space != -1) {
+		number = parseNumber(value.first(space), &ok);
+		if (ok) return number;
+	}
+
+	return QString::fromUtf8(value);
+}
+
+template <typename F>
+void forEachLine(QByteArrayView data, F&& callback) {
+	while (!data.isEmpty()) {
+		auto end = data.indexOf('\n');
+		auto line = end == -1 ? data : data.first(end);
+		data = end == -1 ? QByteArrayView() : data.sliced(end + 1);
+
+		line = line.trimmed();
+		if (!line.isEmpty()) callback(line);
+	}
+}
+
+QVariantMap parseKeyValue(QByteArrayView data) {
+	auto values = QVariantMap();
+
+	forEachLine(data, [&](QByteArrayView line) {
+		qsizetype split = -1;
+		for (qsizetype i = 0; i != line.size(); i++) {
+			if (line[i] == ':' || line[i] == '=') {
+				split = i;
+				break;
+			}
+		}
+
+		if (split <= 0) return;
+
+		auto key = QString::fromUtf8(line.first(split).trimmed());
+		values.insert(key, parseValue(line.sliced(split + 1)));
+	});
+
+	return values;
+}
+
+QVariantMap parseProcStat(QByteArrayView data) {
+	auto values = QVariantMap();
+
+	forEachLine(data, [&](QByteArrayView line) {
+		auto key = QString();
+		auto fields = QVariantList();
+
+		qsizetype i = 0;
+		while (i != line.size()) {
+			while (i != line.size() && isSpace(line[i])) i++;
+			auto start = i;
+			while (i != line.size() && !isSpace(line[i])) i++;
+			if (start == i) break;
+
+			auto token = line.sliced(start, i - start);
+
+			if (key.isEmpty()) {
+				key = QString::fromUtf8(token);
+			} else {
+				auto ok = false;
+				auto number = parseNumber(token, &ok);
+				fields.append(ok ? number : QVariant(QString::fromUtf8(token)));
+			}
+		}
+
+		if (fields.length() == 1) {
+			values.insert(key, fields.first());
+		} else {
+			values.insert(key, fields);
+		}
+	});
+
+	return values;
+}
+
+} // namespace
+
+FileSampleSource::FileSampleSource(QByteArray path): path(std::move(path)) {}
+
+FileSampleSource::~FileSampleSource() { this->close(); }
+
+void FileSampleSource::close() {
+	if (this->fd != -1) {
+		::close(this->fd);
+		this->fd = -1;
+	}
+}
+
+bool FileSampleSource::readInto(QByteArray& buffer) {
+	if (this->fd == -1) {
+		this->fd = ::open(this->path.constData(), O_RDONLY | O_CLOEXEC); // NOLINT
+		if (this->fd == -1) return false;
+	}
+
+	if (buffer.capacity() < INITIAL_BUFFER_SIZE) buffer.reserve(INITIAL_BUFFER_SIZE);
+
+	// Resizing within capacity does not reallocate, so the buffer is reused
+	// between samples unless it is still shared with the last published value.
+	qsizetype size = 0;
+	while (true) {
+		if (size == buffer.capacity()) buffer.reserve(buffer.capacity() * 2);
+		buffer.resize(buffer.capacity());
+
+		auto r = ::pread(this->fd, buffer.data() + size, buffer.size() - size, size);
+
+		if (r == -1) {
+			if (errno == EINTR) continue;
+
+			qCDebug(logFileSampler) << "Failed to read" << this->path << "-" << std::strerror(errno);
+
+			// Files such as those of a removed device stay broken after an error,
+			// so the file is reopened on the next sample.
+			this->close();
+			buffer.resize(0);
+			return false;
+		}
+
+		if (r == 0) break;
+		size += r;
+	}
+
+	buffer.resize(size);
+	return true;
+}
+
+bool FileSampleSource::read() {
+	if (!this->readInto(this->current)) this->current.resize(0);
+
+	if (this->hasRead && this->current == this->previous) return false;
+
+	this->hasRead = true;
+	std::swap(this->current, this->previous);
+	return true;
+}
+
+QVariant FileSampleSource::parse(QByteArrayView data, FileSamplerFormat::Enum format) {
+	switch (format) {
+	case FileSamplerFormat::Raw: return QVariant();
+	case FileSamplerFormat::Value: return data.trimmed().isEmpty() ? QVariant() : parseValue(data);
+	case FileSamplerFormat::KeyValue: return parseKeyValue(data);
+	case FileSamplerFormat::ProcStat: return parseProcStat(data);
+	}
+
+	return QVariant();
+}
+
+FileSamplerWorker* FileSamplerWorker::instance() {
+	static auto* instance = [] {
+		auto* thread = new QThread(); // NOLINT
+		thread->setObjectName("FileSampler");
+
+		auto* worker = new FileSamplerWorker(); // NOLINT
+		worker->moveToThread(thread);
+		thread->start(QThread::LowPriority);
+
+		return worker;
+	}();
+
+	return instance;
+}
+
+void FileSamplerWorker::addSampler(
+    FileSampler* sampler,
+    const QByteArray& path,
+    FileSamplerFormat::Enum format,
+    int interval,
+    quint64 generation
+) {
+	auto& group = this->groups[interval];
+
+	if (group.timer == nullptr) {
+		group.timer = new QTimer(this);
+		group.timer->setInterval(interval);
+		group.timer->setTimerType(interval < 1000 ? Qt::PreciseTimer : Qt::CoarseTimer);
+		QObject::connect(group.timer, &QTimer::timeout, this, [this, interval]() {
+			this->onTimeout(interval);
+		});
+		group.timer->start();
+	}
+
+	auto entry = Entry {
+	    .sampler = sampler,
+	    .source = new FileSampleSource(path),
+	    .format = format,
+	    .generation = generation,
+	};
+
+	group.entries.append(entry);
+
+	qCDebug(logFileSampler) << "Added sampler for" << path << "with interval" << interval
+	                        << "to group of" << group.entries.length();
+
+	// Sampled immediately instead of waiting for the first tick.
+	FileSamplerWorker::sample(entry);
+}
+
+void FileSamplerWorker::removeSampler(FileSampler* sampler) {
+	for (auto group = this->groups.begin(); group != this->groups.end(); ++group) {
+		auto& entries = group->entries;
+
+		for (auto i = 0; i != entries.length(); i++) {
+			if (entries[i].sampler != sampler) continue;
+
+			delete entries[i].source;
+			entries.removeAt(i);
+
+			if (entries.isEmpty()) {
+				delete group->timer;
+				this->groups.erase(group);
+			}
+
+			return;
+		}
+	}
+}
+
+void FileSamplerWorker::onTimeout(int interval) {
+	auto group = this->groups.constFind(interval);
+	if (group == this->groups.constEnd()) return;
+
+	for (const auto& entry: group->entries) {
+		FileSamplerWorker::sample(entry);
+	}
+}
+
+void FileSamplerWorker::sample(const Entry& entry) {
+	if (!entry.source->read()) return;
+
+	const auto& data = entry.source->data();
+	auto text = QString::fromUtf8(data);
+	auto values = FileSampleSource::parse(data, entry.format);
+
+	// The sampler is removed from the worker before it is destroyed, so it is valid here,
+	// and pending results are discarded along with it.
+	auto* sampler = entry.sampler;
+	QMetaObject::invokeMethod(
+	    sampler,
+	    [sampler, generation = entry.generation, text = std::move(text), values = std::move(values)]() {
+		    // Results sent before the sampler was reconfigured may still be queued.
+		    if (generation != sampler->generation) return;
+		    sampler->onSampled(text, values);
+	    },
+	    Qt::QueuedConnection
+	);
+}
+
+FileSampler::~FileSampler() {
+	if (this->registered) {
+		auto* worker = FileSamplerWorker::instance();
+		QMetaObject::invokeMethod(
+		    worker,
+		    [worker, sampler = this]() { worker->removeSampler(sampler); },
+		    Qt::BlockingQueuedConnection
+		);
+	}
+}
+
+void FileSampler::componentComplete() {
+	this->complete = true;
+	this->updateRegistration();
+}
+
+void FileSampler::setPath(const QString& path) {
+	if (path == this->mPath) return;
+	this->mPath = path;
+	emit this->pathChanged();
+	this->updateRegistration();
+}
+
+void FileSampler::setFormat(FileSamplerFormat::Enum format) {
+	if (format == this->mFormat) return;
+	this->mFormat = format;
+	emit this->formatChanged();
+	this->updateRegistration();
+}
+
+void FileSampler::setInterval(int interval) {
+	if (interval == this->mInterval) return;
+	this->mInterval = interval;
+	emit this->intervalChanged();
+	this->updateRegistration();
+}
+
+void FileSampler::setRunning(bool running) {
+	if (running == this->mRunning) return;
+	this->mRunning = running;
+	emit this->runningChanged();
+	this->updateRegistration();
+}
+
+void FileSampler::updateRegistration() {
+	if (!this->complete) return;
+
+	auto* worker = FileSamplerWorker::instance();
+
+	if (this->registered) {
+		// Blocking so the worker is no longer reading the old file once this returns.
+		QMetaObject::invokeMethod(
+		    worker,
+		    [worker, sampler = this]() { worker->removeSampler(sampler); },
+		    Qt::BlockingQueuedConnection
+		);
+
+		this->registered = false;
+	}
+
+	if (!this->mRunning || this->mPath.isEmpty()) return;
+
+	if (this->mInterval <= 0) {
+		qCWarning(logFileSampler) << this << "has a non positive interval and will not be sampled.";
+		return;
+	}
+
+	this->registered = true;
+	this->generation++;
+
+	QMetaObject::invokeMethod(
+	    worker,
+	    [worker,
+	     sampler = this,
+	     path = this->mPath.toLocal8Bit(),
+	     format = this->mFormat,
+	     interval = this->mInterval,
+	     generation = this->generation]() {
+		    worker->addSampler(sampler, path, format, interval, generation);
+	    },
+	    Qt::QueuedConnection
+	);
+}
+
+void FileSampler::onSampled(const QString& text, const QVariant& values) {
+	auto textChanged = text != this->mText;
+	auto valuesChanged = values != this->mValues;
+
+	if (textChanged) this->mText = text;
+	if (valuesChanged) this->mValues = values;
+
+	if (textChanged) emit this->textChanged();
+	if (valuesChanged) emit this->valuesChanged();
+	if (textChanged || valuesChanged) emit this->changed();
+}
+
+} // namespace qs::io
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <qbytearray.h>
+#include <qbytearrayview.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qqmlintegration.h>
+#include <qqmlparserstatus.h>
+#include <qtclasshelpermacros.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+#include <qvariant.h>
+
+namespace qs::io {
+
+///! Format of a file read by FileSampler.
+/// See @@FileSampler.format.
+namespace FileSamplerFormat { // NOLINT
+Q_NAMESPACE;
+QML_ELEMENT;
+
+enum Enum : quint8 {
+	/// The file is not parsed, and @@FileSampler.values is always null.
+	Raw = 0,
+	/// The file contains a single value, such as most sysfs attributes.
+	///
+	/// @@FileSampler.values is the trimmed content of the file, converted to a number if numeric.
+	Value = 1,
+	/// Each line contains a key and a value separated by `:` or `=`, such as
+	/// `/proc/meminfo` or sysfs `uevent` files.
+	///
+	/// @@FileSampler.values is an object mapping each key to its value, converted to a number
+	/// if numeric. Numbers followed by a unit, such as `16318856 kB`, are converted without the unit.
+	KeyValue = 2,
+	/// Each line contains a key followed by whitespace separated numbers, such as `/proc/stat`.
+	///
+	/// @@FileSampler.values is an object mapping each key to a number, or to a list of
+	/// numbers if the line contains more than one.
+	ProcStat = 3,
+};
+Q_ENUM_NS(Enum);
+} // namespace FileSamplerFormat
+
+class FileSampler;
+
+// A file that is kept open and reread from the start into reused buffers.
+// Not thread safe, only used from the sampler thread.
+class FileSampleSource {
+public:
+	explicit FileSampleSource(QByteArray path);
+	~FileSampleSource();
+	Q_DISABLE_COPY_MOVE(FileSampleSource);
+
+	// Reads the file, returning true if its content changed since the last read.
+	bool read();
+	[[nodiscard]] const QByteArray& data() const { return this->previous; }
+
+	static QVariant parse(QByteArrayView data, FileSamplerFormat::Enum format);
+
+private:
+	bool readInto(QByteArray& buffer);
+	void close();
+
+	QByteArray path;
+	int fd = -1;
+	bool hasRead = false;
+	QByteArray current;
+	QByteArray previous;
+};
+
+// Samples files for all FileSamplers on a single thread, grouped by interval.
+class FileSamplerWorker: public QObject {
+	Q_OBJECT;
+
+public:
+	static FileSamplerWorker* instance();
+
+	// Both must be called from the sampler thread.
+	void addSampler(
+	    FileSampler* sampler,
+	    const QByteArray& path,
+	    FileSamplerFormat::Enum format,
+	    int interval,
+	    quint64 generation
+	);
+	void removeSampler(FileSampler* sampler);
+
+private:
+	explicit FileSamplerWorker() = default;
+
+	struct Entry {
+		FileSampler* sampler = nullptr;
+		FileSampleSource* source = nullptr;
+		FileSamplerFormat::Enum format = FileSamplerFormat::Raw;
+		quint64 generation = 0;
+	};
+
+	struct IntervalGroup {
+		QTimer* timer = nullptr;
+		QList<Entry> entries;
+	};
+
+	void onTimeout(int interval);
+	static void sample(const Entry& entry);
+
+	QHash<int, IntervalGroup> groups;
+};
+
+///! Efficiently samples small, frequently changing files.
+/// FileSampler repeatedly reads a file at a fixed interval, and is intended for
+/// system metrics exposed through `/proc` and `/sys`, such as CPU usage, memory usage
+/// or battery state.
+///
+/// Unlike polling with @@FileView, the file is kept open between samples, all samplers
+/// share a single background thread, and common formats are parsed without involving
+/// javascript. @@text and @@values only change when the content of the file changes.
+///
+/// #### Example: Memory usage
+/// ```qml
+/// FileSampler {
+///   id: meminfo
+///   path: "/proc/meminfo"
+///   format: FileSamplerFormat.KeyValue
+///   interval: 2000
+/// }
+///
+/// readonly property real memoryUsed: meminfo.values
+///   ? 1 - meminfo.values.MemAvailable / meminfo.values.MemTotal
+///   : 0
+/// ```
+class FileSampler
+    : public QObject
+    , public QQmlParserStatus {
+	Q_OBJECT;
+	QML_ELEMENT;
+	Q_INTERFACES(QQmlParserStatus);
+	// clang-format off
+	/// The path of the file to sample.
+	Q_PROPERTY(QString path READ path WRITE setPath NOTIFY pathChanged);
+	/// How the file should be parsed into @@values. Defaults to `FileSamplerFormat.Raw`.
+	Q_PROPERTY(qs::io::FileSamplerFormat::Enum format READ format WRITE setFormat NOTIFY formatChanged);
+	/// The time between samples in milliseconds. Defaults to 1000.
+	///
+	/// Samplers with the same interval are sampled together.
+	Q_PROPERTY(int interval READ interval WRITE setInterval NOTIFY intervalChanged);
+	/// If the file should be sampled. Defaults to true.
+	Q_PROPERTY(bool running READ isRunning WRITE setRunning NOTIFY runningChanged);
+	/// The content of the file as of the last sample, or an empty string if it could not be read.
+	Q_PROPERTY(QString text READ text NOTIFY textChanged);
+	/// The content of the file as of the last sample, parsed according to @@format.
+	Q_PROPERTY(QVariant values READ values NOTIFY valuesChanged);
+	// clang-format on
+
+public:
+	explicit FileSampler(QObject* parent = nullptr): QObject(parent) {}
+	~FileSampler() override;
+	Q_DISABLE_COPY_MOVE(FileSampler);
+
+	void classBegin() override {}
+	void componentComplete() override;
+
+	[[nodiscard]] QString path() const { return this->mPath; }
+	void setPath(const QString& path);
+
+	[[nodiscard]] FileSamplerFormat::Enum format() const { return this->mFormat; }
+	void setFormat(FileSamplerFormat::Enum format);
+
+	[[nodiscard]] int interval() const { return this->mInterval; }
+	void setInterval(int interval);
+
+	[[nodiscard]] bool isRunning() const { return this->mRunning; }
+	void setRunning(bool running);
+
+	[[nodiscard]] QString text() const { return this->mText; }
+	[[nodiscard]] QVariant values() const { return this->mValues; }
+
+signals:
+	/// Emitted after a sample in which the file's content changed.
+	void changed();
+
+	void pathChanged();
+	void formatChanged();
+	void intervalChanged();
+	void runningChanged();
+	void textChanged();
+	void valuesChanged();
+
+private:
+	void updateRegistration();
+	void onSampled(const QString& text, const QVariant& values);
+
+	QString mPath;
+	FileSamplerFormat::Enum mFormat = FileSamplerFormat::Raw;
+	int mInterval = 1000;
+	bool mRunning = true;
+	bool complete = false;
+	bool registered = false;
+	quint64 generation = 0;
+	QString mText;
+	QVariant mValues;
+
+	friend class FileSamplerWorker;
+};
+
+} // namespace qs::io
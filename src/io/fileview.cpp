@@ -3,10 +3,13 @@
 #include <utility>
 
 #include <qatomic.h>
+#include <qbytearray.h>
+#include <qbytearrayview.h>
+#include <qcontainerfwd.h>
 #include <qdir.h>
+#include <qfile.h>
 #include <qfiledevice.h>
 #include <qfileinfo.h>
-#include <qfilesystemwatcher.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qmutex.h>
@@ -16,10 +19,14 @@
 #include <qqmlinfo.h>
 #include <qsavefile.h>
 #include <qscopedpointer.h>
+#include <qstringconverter.h>
 #include <qthreadpool.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
+#include <sys/stat.h>
 
+#include "../core/filewatch.hpp"
 #include "../core/logcat.hpp"
 #include "../core/util.hpp"
 
@@ -27,7 +34,33 @@ namespace qs::io {
 
 namespace {
 QS_LOGGING_CATEGORY(logFileView, "quickshell.io.fileview", QtWarningMsg);
+
+// Files read as text only are read and decoded in chunks of this size.
+constexpr qsizetype TEXT_CHUNK_SIZE = 64 * 1024;
+
+// Decodes the file into data as it is read, so the file's bytes are never held in memory
+// alongside the text. Returns false if a read fails.
+bool readText(QFile& file, FileViewData& data, const QAtomicInteger<bool>& shouldCancel) {
+	auto decoder = QStringDecoder(QStringDecoder::Utf8, QStringDecoder::Flag::ConvertInitialBom);
+	auto chunk = QByteArray(TEXT_CHUNK_SIZE, Qt::Uninitialized);
+	auto text = QString();
+	text.reserve(file.size());
+
+	while (true) {
+		if (shouldCancel.loadAcquire()) return true;
+
+		auto r = file.read(chunk.data(), chunk.size());
+		if (r == -1) return false;
+		if (r == 0) break;
+
+		text += decoder(QByteArrayView(chunk.constData(), r));
+	}
+
+	text.squeeze();
+	data = text;
+	return true;
 }
+} // namespace
 
 QString FileViewError::toString(FileViewError::Enum value) {
 	switch (value) {
@@ -149,7 +182,14 @@ void FileViewReader::read(
 
 	if (shouldCancel.loadAcquire()) return;
 
-	if (file.size() != 0) {
+	if (state.textOnly) {
+		if (!readText(file, state.data, shouldCancel)) {
+			qmlWarning(view) << "Read of " << state.path << " failed: read() failed.";
+
+			state.error = FileViewError::Unknown;
+			return;
+		}
+	} else if (file.size() != 0) {
 		auto data = QByteArray(file.size(), Qt::Uninitialized);
 		qint64 i = 0;
 
@@ -202,6 +242,78 @@ void FileViewReader::read(
 	}
 }
 
+void FileViewTailReader::run() {
+	if (!this->shouldCancel.loadAcquire()) {
+		FileViewTailReader::read(this->tail, this->shouldCancel);
+	}
+
+	this->finishRun();
+}
+
+void FileViewTailReader::read(FileViewTailState& tail, const QAtomicInteger<bool>& shouldCancel) {
+	auto file = QFile(tail.path);
+
+	if (!file.open(QFile::ReadOnly)) {
+		// Followed from the start once created.
+		tail.atStart = false;
+		tail.offset = 0;
+		tail.inode = 0;
+		tail.partialLine.clear();
+		return;
+	}
+
+	struct stat info {};
+	if (fstat(file.handle(), &info) != 0) return;
+	auto size = static_cast<qint64>(info.st_size);
+
+	if (tail.atStart) {
+		tail.atStart = false;
+		tail.inode = info.st_ino;
+		tail.offset = size;
+		return;
+	}
+
+	if (info.st_ino != tail.inode || size < tail.offset) {
+		qCDebug(logFileView) << "Following" << tail.path << "from the start as it was replaced or truncated.";
+		tail.inode = info.st_ino;
+		tail.offset = 0;
+		tail.partialLine.clear();
+	}
+
+	if (size == tail.offset || !file.seek(tail.offset)) return;
+
+	// Bytes appended after the stat are picked up by the next read.
+	auto data = std::exchange(tail.partialLine, {});
+	auto start = data.size();
+	data.resize(start + (size - tail.offset));
+	auto end = start;
+
+	while (end != data.size()) {
+		if (shouldCancel.loadAcquire()) return;
+
+		auto r = file.read(data.data() + end, data.size() - end); // NOLINT
+		if (r <= 0) break;
+		end += r;
+	}
+
+	data.resize(end);
+	tail.offset += end - start;
+
+	qsizetype lineStart = 0;
+	while (true) {
+		auto lineEnd = data.indexOf('\n', lineStart);
+		if (lineEnd == -1) break;
+
+		auto line = QByteArrayView(data).sliced(lineStart, lineEnd - lineStart);
+		if (line.endsWith('\r')) line.chop(1);
+
+		tail.lines.append(QString::fromUtf8(line));
+		lineStart = lineEnd + 1;
+	}
+
+	tail.partialLine = data.sliced(lineStart);
+}
+
 void FileViewWriter::run() {
 	if (!this->shouldCancel.loadAcquire()) {
 		FileViewWriter::write(this->owner, this->state, this->doAtomicWrite, this->shouldCancel);
@@ -291,8 +403,34 @@ void FileViewWriter::write(
 	}
 }
 
+FileView::FileView(QObject* parent): QObject(parent) {
+	this->adapterWriteTimer.setSingleShot(true);
+
+	QObject::connect(
+	    &this->watcher,
+	    &FileWatch::fileChanged,
+	    this,
+	    &FileView::onWatchedFileChanged
+	);
+
+	QObject::connect(
+	    &this->adapterWriteTimer,
+	    &QTimer::timeout,
+	    this,
+	    &FileView::onAdapterWriteTimeout
+	);
+}
+
 FileView::~FileView() {
 	if (this->mAdapter) {
+		// Signals cannot be emitted at this point, so the write is done directly.
+		if (this->adapterWriteTimer.isActive() && !this->targetPath.isEmpty()) {
+			auto state = FileViewState(this->targetPath);
+			state.data = this->mAdapter->serializeAdapter();
+			state.printErrors = this->bPrintErrors;
+			FileViewWriter::write(this, state, this->bAtomicWrites);
+		}
+
 		this->mAdapter->setFileView(nullptr);
 	}
 }
@@ -311,6 +449,7 @@ void FileView::loadAsync(bool doStringConversion) {
 			auto* reader = new FileViewReader(this, doStringConversion);
 			reader->state.path = this->targetPath;
 			reader->state.printErrors = this->bPrintErrors;
+			reader->state.textOnly = this->bTextOnly;
 			QObject::connect(reader, &FileViewOperation::done, this, &FileView::operationFinished);
 			QThreadPool::globalInstance()->start(reader); // takes ownership
 			this->liveOperation = reader;
@@ -405,6 +544,7 @@ void FileView::loadSync() {
 	} else if (!this->waitForJob()) {
 		auto state = FileViewState(this->targetPath);
 		state.printErrors = this->bPrintErrors;
+		state.textOnly = this->bTextOnly;
 		FileViewReader::read(this, state, false);
 		this->updateState(state);
 
@@ -466,6 +606,9 @@ void FileView::setPath(const QString& path) {
 	auto p = path.startsWith("file://") ? path.sliced(7) : path;
 	if (p == this->targetPath) return;
 
+	// A delayed adapter write belongs to the old path.
+	this->flushAdapterWrite();
+
 	if (this->liveWriter()) {
 		this->waitForJob();
 	} else {
@@ -474,6 +617,7 @@ void FileView::setPath(const QString& path) {
 
 	this->targetPath = p;
 	this->updatePath();
+	this->updateTail();
 }
 
 void FileView::updatePath() {
@@ -492,55 +636,63 @@ void FileView::updatePath() {
 }
 
 void FileView::updateWatchedFiles() {
-	// If inotify events are sent to the watcher after deletion and deleteLater
-	// isn't used, a use after free in the QML engine will occur.
-	if (this->watcher) {
-		this->watcher->deleteLater();
-		this->watcher = nullptr;
+	if (!this->targetPath.isEmpty() && (this->bWatchChanges || this->bTail)) {
+		qCDebug(logFileView) << "Watching" << this->targetPath << "for" << this;
+		this->watcher.setPaths({this->targetPath});
+	} else {
+		this->watcher.clear();
 	}
+}
 
-	if (!this->targetPath.isEmpty() && this->bWatchChanges) {
-		qCDebug(logFileView) << "Creating watcher for" << this << "at" << this->targetPath;
-		this->watcher = new QFileSystemWatcher(this);
-		this->watcher->addPath(this->targetPath);
+void FileView::onWatchedFileChanged() {
+	if (this->bWatchChanges) emit this->fileChanged();
+	if (this->bTail) this->startTailRead();
+}
 
-		auto dirPath = this->targetPath;
-		if (!dirPath.contains("/")) dirPath = "./" % dirPath;
+void FileView::updateTail() {
+	if (this->tailOperation) {
+		this->tailOperation->tryCancel();
+		QObject::disconnect(this->tailOperation, nullptr, this, nullptr);
+		this->tailOperation = nullptr;
+	}
 
-		if (auto lastIndex = dirPath.lastIndexOf('/'); lastIndex != -1) {
-			dirPath = dirPath.sliced(0, lastIndex);
-			this->watcher->addPath(dirPath);
-		}
+	this->tailReadPending = false;
+	this->tailState = FileViewTailState();
+	this->tailState.path = this->targetPath;
 
-		QObject::connect(
-		    this->watcher,
-		    &QFileSystemWatcher::fileChanged,
-		    this,
-		    &FileView::onWatchedFileChanged
-		);
+	// The first read only finds the end of the file.
+	if (this->bTail && !this->targetPath.isEmpty()) this->startTailRead();
 
-		QObject::connect(
-		    this->watcher,
-		    &QFileSystemWatcher::directoryChanged,
-		    this,
-		    &FileView::onWatchedDirectoryChanged
-		);
-	}
+	this->updateWatchedFiles();
 }
 
-void FileView::onWatchedFileChanged() {
-	if (!this->watcher->files().contains(this->targetPath)) {
-		this->watcher->addPath(this->targetPath);
+void FileView::startTailRead() {
+	// Reads must run in order, as each continues from where the last stopped.
+	if (this->tailOperation) {
+		this->tailReadPending = true;
+		return;
 	}
 
-	emit this->fileChanged();
+	auto* reader = new FileViewTailReader(this, this->tailState);
+	QObject::connect(reader, &FileViewOperation::done, this, &FileView::onTailReadFinished);
+	QThreadPool::globalInstance()->start(reader); // takes ownership
+	this->tailOperation = reader;
 }
 
-void FileView::onWatchedDirectoryChanged() {
-	if (!this->watcher->files().contains(this->targetPath) && QFileInfo(this->targetPath).exists()) {
-		// the file was just created
-		this->watcher->addPath(this->targetPath);
-		emit this->fileChanged();
+void FileView::onTailReadFinished() {
+	if (this->sender() != this->tailOperation) return;
+
+	auto* reader = this->tailOperation;
+	this->tailOperation = nullptr;
+
+	auto lines = std::exchange(reader->tail.lines, {});
+	this->tailState = std::move(reader->tail);
+
+	if (!lines.isEmpty()) emit this->linesAppended(lines);
+
+	if (this->tailReadPending) {
+		this->tailReadPending = false;
+		this->startTailRead();
 	}
 }
 
@@ -676,9 +828,28 @@ void FileView::writeAdapter() {
 		return;
 	}
 
+	auto interval = this->bAdapterWriteInterval.value();
+
+	if (interval <= 0) {
+		this->adapterWriteTimer.stop();
+		this->setData(this->mAdapter->serializeAdapter());
+	} else if (!this->adapterWriteTimer.isActive()) {
+		// The adapter is serialized when the timer fires, picking up any further changes.
+		this->adapterWriteTimer.start(interval);
+	}
+}
+
+void FileView::onAdapterWriteTimeout() {
+	if (!this->mAdapter) return;
 	this->setData(this->mAdapter->serializeAdapter());
 }
 
+void FileView::flushAdapterWrite() {
+	if (!this->adapterWriteTimer.isActive()) return;
+	this->adapterWriteTimer.stop();
+	this->onAdapterWriteTimeout();
+}
+
 void FileView::onAdapterDestroyed() { this->mAdapter = nullptr; }
 
 void FileViewAdapter::setFileView(FileView* fileView) {
@@ -3,8 +3,8 @@
 #include <utility>
 
 #include <qatomic.h>
+#include <qcontainerfwd.h>
 #include <qdebug.h>
-#include <qfilesystemwatcher.h>
 #include <qlogging.h>
 #include <qmutex.h>
 #include <qobject.h>
@@ -14,10 +14,13 @@
 #include <qqmlparserstatus.h>
 #include <qrunnable.h>
 #include <qstringview.h>
+#include <qtimer.h>
 #include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "../core/doc.hpp"
+#include "../core/filewatch.hpp"
 #include "../core/util.hpp"
 
 namespace qs::io {
@@ -70,9 +73,21 @@ struct FileViewState {
 	FileViewData data;
 	bool exists = false;
 	bool printErrors = true;
+	bool textOnly = false;
 	FileViewError::Enum error = FileViewError::Success;
 };
 
+struct FileViewTailState {
+	QString path;
+	qint64 offset = 0;
+	quint64 inode = 0;
+	// Set until the end of the file has been found, which is where following starts.
+	bool atStart = true;
+	// The last line, if it has not been terminated yet.
+	QByteArray partialLine;
+	QStringList lines;
+};
+
 class FileView;
 
 class FileViewOperation
@@ -141,6 +156,20 @@ public:
 	bool doAtomicWrite;
 };
 
+// Reads lines appended to a file since the last read, for FileView.tail.
+class FileViewTailReader: public FileViewOperation {
+public:
+	explicit FileViewTailReader(FileView* owner, FileViewTailState tail)
+	    : FileViewOperation(owner)
+	    , tail(std::move(tail)) {}
+
+	void run() override;
+
+	static void read(FileViewTailState& tail, const QAtomicInteger<bool>& shouldCancel = false);
+
+	FileViewTailState tail;
+};
+
 class FileViewAdapter;
 
 ///! Simple accessor for small files.
@@ -228,6 +257,42 @@ class FileView: public QObject {
 	///
 	/// Currently the only adapter is @@JsonAdapter.
 	Q_PROPERTY(FileViewAdapter* adapter READ adapter WRITE setAdapter NOTIFY adapterChanged);
+	/// If nonzero, calls to @@writeAdapter() are delayed by up to this many milliseconds
+	/// and combined into a single write. Defaults to 0, which writes immediately.
+	///
+	/// This is useful when the @@adapter is written every time it changes, and some of
+	/// its properties change rapidly, for example when bound to a slider.
+	///
+	/// A delayed write is completed early if @@path changes or the FileView is destroyed.
+	Q_PROPERTY(int adapterWriteInterval READ default WRITE default NOTIFY adapterWriteIntervalChanged BINDABLE bindableAdapterWriteInterval);
+	/// If true (default false), the file is decoded into @@text() in chunks as it is read,
+	/// instead of being read whole and then decoded, so the file's bytes are never held in
+	/// memory alongside its text. This is useful for large files such as logs, history
+	/// databases and caches which are only used as text.
+	///
+	/// @@data() is encoded from the text when used, so invalid UTF-8 in the file is not
+	/// preserved.
+	QSDOC_PROPERTY_OVERRIDE(bool textOnly READ default WRITE default NOTIFY textOnlyChanged);
+	/// If true (default false), the file is followed like `tail -f`, and @@linesAppended(s)
+	/// is emitted with every line added to the end of the file.
+	///
+	/// Only the newly appended bytes are read, so this is suitable for large and
+	/// frequently growing files such as logs. Lines that already exist when following
+	/// starts are not reported. If the file is truncated or replaced, it is followed from its
+	/// new start.
+	///
+	/// Following does not affect @@text() or @@data(), and does not require @@watchChanges.
+	///
+	/// #### Example: Showing new log lines
+	/// ```qml
+	/// FileView {
+	///   path: "/var/log/app.log"
+	///   preload: false
+	///   tail: true
+	///   onLinesAppended: lines => logModel.values = [...logModel.values, ...lines].slice(-100)
+	/// }
+	/// ```
+	Q_PROPERTY(bool tail READ default WRITE default NOTIFY tailChanged BINDABLE bindableTail);
 
 	QSDOC_HIDE Q_PROPERTY(QString __path READ path WRITE setPath NOTIFY pathChanged);
 	QSDOC_HIDE Q_PROPERTY(QString __text READ text NOTIFY internalTextChanged);
@@ -242,13 +307,14 @@ class FileView: public QObject {
 	QSDOC_HIDE Q_PROPERTY(bool __blockLoading READ blockLoading WRITE setBlockLoading NOTIFY blockLoadingChanged);
 	QSDOC_HIDE Q_PROPERTY(bool __blockAllReads READ blockAllReads WRITE setBlockAllReads NOTIFY blockAllReadsChanged);
 	QSDOC_HIDE Q_PROPERTY(bool __printErrors READ default WRITE default NOTIFY printErrorsChanged BINDABLE bindablePrintErrors);
+	QSDOC_HIDE Q_PROPERTY(bool __textOnly READ default WRITE default NOTIFY textOnlyChanged BINDABLE bindableTextOnly);
 	// clang-format on
 	Q_CLASSINFO("DefaultProperty", "adapter");
 	QML_NAMED_ELEMENT(FileViewInternal);
 	QSDOC_NAMED_ELEMENT(FileView);
 
 public:
-	explicit FileView(QObject* parent = nullptr): QObject(parent) {}
+	explicit FileView(QObject* parent = nullptr);
 	~FileView() override;
 	Q_DISABLE_COPY_MOVE(FileView);
 
@@ -329,6 +395,9 @@ public:
 
 	[[nodiscard]] QBindable<bool> bindablePrintErrors() { return &this->bPrintErrors; }
 	[[nodiscard]] QBindable<bool> bindableWatchChanges() { return &this->bWatchChanges; }
+	[[nodiscard]] QBindable<int> bindableAdapterWriteInterval() { return &this->bAdapterWriteInterval; }
+	[[nodiscard]] QBindable<bool> bindableTextOnly() { return &this->bTextOnly; }
+	[[nodiscard]] QBindable<bool> bindableTail() { return &this->bTail; }
 
 	[[nodiscard]] FileViewAdapter* adapter() const;
 	void setAdapter(FileViewAdapter* adapter);
@@ -346,6 +415,8 @@ signals:
 	void fileChanged();
 	/// Emitted when the active @@adapter$'s data is changed.
 	void adapterUpdated();
+	/// Emitted with the lines added to the end of the file if @@tail is true.
+	void linesAppended(const QStringList& lines);
 
 	void pathChanged();
 	QSDOC_HIDE void internalTextChanged();
@@ -361,10 +432,16 @@ signals:
 	void printErrorsChanged();
 	void watchChangesChanged();
 	void adapterChanged();
+	void adapterWriteIntervalChanged();
+	void textOnlyChanged();
+	void tailChanged();
 
 private slots:
 	void operationFinished();
 	void onAdapterDestroyed();
+	void onAdapterWriteTimeout();
+	void onWatchedFileChanged();
+	void onTailReadFinished();
 
 private:
 	void loadAsync(bool doStringConversion);
@@ -375,8 +452,9 @@ private:
 	void updateState(FileViewState& newState);
 	void updatePath();
 	void updateWatchedFiles();
-	void onWatchedFileChanged();
-	void onWatchedDirectoryChanged();
+	void updateTail();
+	void startTailRead();
+	void flushAdapterWrite();
 
 	[[nodiscard]] bool shouldBlockRead() const;
 	[[nodiscard]] FileViewReader* liveReader() const;
@@ -399,7 +477,11 @@ private:
 	bool mBlockAllReads = false;
 
 	FileViewAdapter* mAdapter = nullptr;
-	QFileSystemWatcher* watcher = nullptr;
+	QTimer adapterWriteTimer;
+	FileWatch watcher;
+	FileViewTailState tailState;
+	FileViewTailReader* tailOperation = nullptr;
+	bool tailReadPending = false;
 
 	GuardedEmitter<&FileView::internalTextChanged> textChangedEmitter;
 	GuardedEmitter<&FileView::internalDataChanged> dataChangedEmitter;
@@ -423,9 +505,13 @@ public:
 	Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(FileView, bool, bAtomicWrites, true, &FileView::atomicWritesChanged);
 	Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(FileView, bool, bPrintErrors, true, &FileView::printErrorsChanged);
 	Q_OBJECT_BINDABLE_PROPERTY(FileView, bool, bWatchChanges, &FileView::watchChangesChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(FileView, int, bAdapterWriteInterval, &FileView::adapterWriteIntervalChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(FileView, bool, bTextOnly, &FileView::textOnlyChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(FileView, bool, bTail, &FileView::tailChanged);
 	// clang-format on
 
 	QS_BINDING_SUBSCRIBE_METHOD(FileView, bWatchChanges, updateWatchedFiles, onValueChanged);
+	QS_BINDING_SUBSCRIBE_METHOD(FileView, bTail, updateTail, onValueChanged);
 
 	void setPreload(bool preload);
 	void setBlockLoading(bool blockLoading);
@@ -3,6 +3,7 @@
 #include <variant>
 
 #include <qcontainerfwd.h>
+#include <qlatin1stringview.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qtextstream.h>
@@ -10,6 +11,7 @@
 
 #include "../core/generation.hpp"
 #include "../core/logging.hpp"
+#include "../core/profiler.hpp"
 #include "../ipc/ipc.hpp"
 #include "../ipc/ipccommand.hpp"
 #include "ipc.hpp"
@@ -137,6 +139,10 @@ using StringCallResponse = std::variant<
 void StringCallCommand::exec(qs::ipc::IpcServerConnection* conn) const {
 	auto resp = conn->responseStream<StringCallResponse>();
 
+	if (QsProfiler::instance()->isRunning()) {
+		QsProfiler::countEvent(QLatin1StringView("ipc"), this->target + '.' + this->function);
+	}
+
 	if (auto* generation = EngineGeneration::currentGeneration()) {
 		auto* registry = IpcHandlerRegistry::forGeneration(generation);
 
@@ -245,6 +251,33 @@ int callFunction(
 	return -1;
 }
 
+QuietCallResult callFunctionQuiet(
+    IpcFastClient* client,
+    const QString& target,
+    const QString& function,
+    const QVector<QString>& arguments
+) {
+	auto sent = client->sendMessage(
+	    IpcCommand(StringCallCommand {.target = target, .function = function, .arguments = arguments})
+	);
+
+	if (!sent) return QuietCallResult::Rejected;
+
+	StringCallResponse slot;
+	if (!client->waitForResponse(slot)) return QuietCallResult::Failed;
+
+	if (std::holds_alternative<Completed>(slot)) {
+		auto& result = std::get<Completed>(slot);
+		if (!result.isVoid) {
+			QTextStream(stdout) << result.returnValue << Qt::endl;
+		}
+
+		return QuietCallResult::Completed;
+	}
+
+	return QuietCallResult::Rejected;
+}
+
 struct PropertyValue {
 	QString value;
 };
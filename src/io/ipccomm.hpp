@@ -37,6 +37,24 @@ int callFunction(
     const QVector<QString>& arguments
 );
 
+enum class QuietCallResult : quint8 {
+	Completed,
+	// The instance did not run the function. The call may be retried.
+	Rejected,
+	// The connection was lost after the call was sent.
+	Failed,
+};
+
+// Calls a function without logging, for use before logging and the application are set up.
+// Only a successful result is printed. Anything else should be retried through
+// callFunction for a full error report.
+QuietCallResult callFunctionQuiet(
+    qs::ipc::IpcFastClient* client,
+    const QString& target,
+    const QString& function,
+    const QVector<QString>& arguments
+);
+
 struct StringPropReadCommand {
 	QString target;
 	QString property;
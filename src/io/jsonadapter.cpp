@@ -1,4 +1,5 @@
 #include "jsonadapter.hpp"
+#include <utility>
 
 #include <qcontainerfwd.h>
 #include <qjsonarray.h>
@@ -14,6 +15,7 @@
 #include <qqmlengine.h>
 #include <qqmlinfo.h>
 #include <qqmllist.h>
+#include <qset.h>
 #include <qstringview.h>
 #include <qvariant.h>
 
@@ -39,8 +41,7 @@ void JsonAdapter::deserializeAdapter(const QByteArray& data) {
 	}
 
 	this->changesBlocked = true;
-	this->oldCreatedObjects = this->createdObjects;
-	this->createdObjects.clear();
+	this->oldCreatedObjects = std::exchange(this->createdObjects, {});
 
 	this->deserializeRec(json.object(), this, &JsonAdapter::staticMetaObject);
 
@@ -51,12 +52,32 @@ void JsonAdapter::deserializeAdapter(const QByteArray& data) {
 	this->oldCreatedObjects.clear();
 	this->changesBlocked = false;
 
-	this->connectNotifiers();
+	// Reused objects are already connected, and new objects' children are new as well.
+	auto notifySlot = JsonAdapter::notifySlotIndex();
+	for (auto* object: std::exchange(this->newObjects, {})) {
+		this->connectObjectNotifiers(notifySlot, object, &JsonObject::staticMetaObject);
+	}
+}
+
+int JsonAdapter::notifySlotIndex() {
+	static auto notifySlot = JsonAdapter::staticMetaObject.indexOfSlot("onPropertyChanged()");
+	return notifySlot;
 }
 
 void JsonAdapter::connectNotifiers() {
-	auto notifySlot = JsonAdapter::staticMetaObject.indexOfSlot("onPropertyChanged()");
-	this->connectNotifiersRec(notifySlot, this, &JsonAdapter::staticMetaObject);
+	this->connectNotifiersRec(JsonAdapter::notifySlotIndex(), this, &JsonAdapter::staticMetaObject);
+}
+
+void JsonAdapter::connectObjectNotifiers(int notifySlot, QObject* obj, const QMetaObject* base) {
+	const auto* metaObject = obj->metaObject();
+
+	for (auto i = base->propertyOffset(); i != metaObject->propertyCount(); i++) {
+		const auto prop = metaObject->property(i);
+
+		if (prop.isReadable() && prop.hasNotifySignal()) {
+			QMetaObject::connect(obj, prop.notifySignalIndex(), this, notifySlot, Qt::UniqueConnection);
+		}
+	}
 }
 
 void JsonAdapter::connectNotifiersRec(int notifySlot, QObject* obj, const QMetaObject* base) {
@@ -67,21 +88,23 @@ void JsonAdapter::connectNotifiersRec(int notifySlot, QObject* obj, const QMetaO
 
 		if (prop.isReadable() && prop.hasNotifySignal()) {
 			QMetaObject::connect(obj, prop.notifySignalIndex(), this, notifySlot, Qt::UniqueConnection);
+			this->connectValueNotifiers(notifySlot, prop.read(obj));
+		}
+	}
+}
 
-			auto val = prop.read(obj);
-			if (val.canView<JsonObject*>()) {
-				auto* pobj = prop.read(obj).view<JsonObject*>();
-				if (pobj) this->connectNotifiersRec(notifySlot, pobj, &JsonObject::staticMetaObject);
-			} else if (val.canConvert<QQmlListProperty<JsonObject>>()) {
-				auto listVal = val.value<QQmlListProperty<JsonObject>>();
+void JsonAdapter::connectValueNotifiers(int notifySlot, const QVariant& value) {
+	if (value.canView<JsonObject*>()) {
+		auto* pobj = value.view<JsonObject*>();
+		if (pobj) this->connectNotifiersRec(notifySlot, pobj, &JsonObject::staticMetaObject);
+	} else if (value.canConvert<QQmlListProperty<JsonObject>>()) {
+		auto listVal = value.value<QQmlListProperty<JsonObject>>();
 
-				auto len = listVal.count(&listVal);
-				for (auto i = 0; i != len; i++) {
-					auto* pobj = listVal.at(&listVal, i);
+		auto len = listVal.count(&listVal);
+		for (auto i = 0; i != len; i++) {
+			auto* pobj = listVal.at(&listVal, i);
 
-					if (pobj) this->connectNotifiersRec(notifySlot, pobj, &JsonObject::staticMetaObject);
-				}
-			}
+			if (pobj) this->connectNotifiersRec(notifySlot, pobj, &JsonObject::staticMetaObject);
 		}
 	}
 }
@@ -89,7 +112,23 @@ void JsonAdapter::connectNotifiersRec(int notifySlot, QObject* obj, const QMetaO
 void JsonAdapter::onPropertyChanged() {
 	if (this->changesBlocked) return;
 
-	this->connectNotifiers();
+	// Objects assigned from QML can only be reached through the property that changed,
+	// so only its value is walked instead of the whole object graph.
+	auto* sender = this->sender();
+	auto signalIndex = this->senderSignalIndex();
+
+	if (sender && signalIndex != -1) {
+		const auto* metaObject = sender->metaObject();
+
+		for (auto i = 0; i != metaObject->propertyCount(); i++) {
+			const auto prop = metaObject->property(i);
+
+			if (prop.notifySignalIndex() == signalIndex) {
+				this->connectValueNotifiers(JsonAdapter::notifySlotIndex(), prop.read(sender));
+			}
+		}
+	}
+
 	this->adapterUpdated();
 }
 
@@ -145,6 +184,19 @@ QJsonObject JsonAdapter::serializeRec(const QObject* obj, const QMetaObject* bas
 	return json;
 }
 
+JsonObject* JsonAdapter::createObject(const QMetaType& type) {
+	auto* object = static_cast<JsonObject*>(type.create());
+	object->setParent(this);
+	this->createdObjects.insert(object);
+	this->newObjects.append(object);
+	return object;
+}
+
+void JsonAdapter::reuseObject(JsonObject* object) {
+	// Objects created by a previous deserialization are deleted unless reused.
+	if (this->oldCreatedObjects.remove(object)) this->createdObjects.insert(object);
+}
+
 void JsonAdapter::deserializeRec(const QJsonObject& json, QObject* obj, const QMetaObject* base) {
 	const auto* metaObject = obj->metaObject();
 
@@ -155,13 +207,13 @@ void JsonAdapter::deserializeRec(const QJsonObject& json, QObject* obj, const QM
 
 			if (prop.metaType() == QMetaType::fromType<QVariant>()) {
 				auto variant = jval.toVariant();
-				auto oldValue = prop.read(this).value<QJSValue>();
+				auto oldValue = prop.read(obj).value<QJSValue>();
 
 				// Calling prop.write with a new QJSValue will cause a property update
 				// even if content is identical.
-				if (jval.toVariant() != oldValue.toVariant()) {
-					auto jsValue = qmlEngine(this)->fromVariant<QJSValue>(jval.toVariant());
-					prop.write(this, QVariant::fromValue(jsValue));
+				if (variant != oldValue.toVariant()) {
+					auto jsValue = qmlEngine(this)->fromVariant<QJSValue>(variant);
+					prop.write(obj, QVariant::fromValue(jsValue));
 				}
 			} else if (QMetaType::canView(prop.metaType(), QMetaType::fromType<JsonObject*>())) {
 				// FIXME: This doesn't support creating descendants of JsonObject, as QMetaType.metaObject()
@@ -173,20 +225,18 @@ void JsonAdapter::deserializeRec(const QJsonObject& json, QObject* obj, const QM
 
 					if (isNew) {
 						// metaObject->metaType removes the pointer
-						currentValue =
-						    static_cast<JsonObject*>(prop.metaType().metaObject()->metaType().create());
-
-						currentValue->setParent(this);
-						this->createdObjects.push_back(currentValue);
-					} else if (this->oldCreatedObjects.removeOne(currentValue)) {
-						this->createdObjects.push_back(currentValue);
+						currentValue = this->createObject(prop.metaType().metaObject()->metaType());
+					} else {
+						this->reuseObject(currentValue);
 					}
 
 					this->deserializeRec(jval.toObject(), currentValue, &JsonObject::staticMetaObject);
 
 					if (isNew) prop.write(obj, QVariant::fromValue(currentValue));
 				} else if (jval.isNull()) {
-					prop.write(obj, QVariant::fromValue(nullptr));
+					if (prop.read(obj).view<JsonObject*>() != nullptr) {
+						prop.write(obj, QVariant::fromValue(nullptr));
+					}
 				} else {
 					qmlWarning(this) << "Failed to deserialize property " << prop.name() << " as object. Got "
 					                 << jval.toVariant().typeName();
@@ -196,30 +246,25 @@ void JsonAdapter::deserializeRec(const QJsonObject& json, QObject* obj, const QM
 			               QMetaType::fromType<QQmlListProperty<JsonObject>>()
 			           ))
 			{
-				auto pval = prop.read(this);
+				auto pval = prop.read(obj);
 
 				if (pval.canConvert<QQmlListProperty<JsonObject>>()) {
 					auto lp = pval.value<QQmlListProperty<JsonObject>>();
 					auto array = jval.toArray();
 					auto lpCount = lp.count(&lp);
 
-					auto i = 0;
-					for (; i != array.count(); i++) {
+					for (auto i = 0; i != array.count(); i++) {
+						auto* existingValue = i < lpCount ? lp.at(&lp, i) : nullptr;
 						JsonObject* currentValue = nullptr;
-						auto isNew = i >= lpCount;
 
 						const auto& jsonValue = array.at(i);
 						if (jsonValue.isObject()) {
-							if (isNew) {
-								currentValue = lp.at(&lp, i);
-								if (this->oldCreatedObjects.removeOne(currentValue)) {
-									this->createdObjects.push_back(currentValue);
-								}
+							if (existingValue) {
+								currentValue = existingValue;
+								this->reuseObject(currentValue);
 							} else {
 								// FIXME: should be the type inside the QQmlListProperty but how can we get that?
-								currentValue = static_cast<JsonObject*>(QMetaType::fromType<JsonObject>().create());
-								currentValue->setParent(this);
-								this->createdObjects.push_back(currentValue);
+								currentValue = this->createObject(QMetaType::fromType<JsonObject>());
 							}
 
 							this->deserializeRec(
@@ -233,12 +278,21 @@ void JsonAdapter::deserializeRec(const QJsonObject& json, QObject* obj, const QM
 							                 << jsonValue.toVariant().typeName();
 						}
 
-						if (isNew) {
+						if (i >= lpCount) {
 							lp.append(&lp, currentValue);
+						} else if (currentValue != existingValue) {
+							// Only happens when an entry changes between null and an object.
+							if (lp.replace) {
+								lp.replace(&lp, i, currentValue);
+							} else {
+								while (lp.count(&lp) > i) lp.removeLast(&lp);
+								lp.append(&lp, currentValue);
+								lpCount = i + 1;
+							}
 						}
 					}
 
-					for (; i < lpCount; i++) {
+					while (lp.count(&lp) > array.count()) {
 						lp.removeLast(&lp);
 					}
 				} else {
@@ -249,7 +303,7 @@ void JsonAdapter::deserializeRec(const QJsonObject& json, QObject* obj, const QM
 				auto variant = jval.toVariant();
 
 				if (variant.convert(prop.metaType())) {
-					prop.write(obj, variant);
+					if (prop.read(obj) != variant) prop.write(obj, variant);
 				} else {
 					qmlWarning(this) << "Failed to deserialize property " << prop.name() << ": expected "
 					                 << prop.metaType().name() << " but got " << jval.toVariant().typeName();
@@ -8,8 +8,10 @@
 #include <qobjectdefs.h>
 #include <qqmlintegration.h>
 #include <qqmlparserstatus.h>
+#include <qset.h>
 #include <qstringview.h>
 #include <qtmetamacros.h>
+#include <qvariant.h>
 
 #include "fileview.hpp"
 
@@ -34,10 +36,13 @@ class JsonObject: public QObject {
 ///
 /// When the @@FileView$'s data is loaded, properties of a JsonAdapter or
 /// sub-object adapter (@@JsonObject$) are updated if their values have changed.
+/// Existing sub-objects, including those in lists, are updated in place rather than
+/// being recreated.
 ///
 /// When properties of a JsonAdapter or sub-object adapter are changed from QML,
 /// @@FileView.adapterUpdated(s) is emitted, which may be used to save the file's new
-/// state (see @@FileView.writeAdapter()$).
+/// state (see @@FileView.writeAdapter()$). If properties change rapidly, @@FileView.adapterWriteInterval
+/// can be used to combine the resulting writes.
 ///
 /// ### Example
 /// ```qml
@@ -104,14 +109,21 @@ private slots:
 	void onPropertyChanged();
 
 private:
+	[[nodiscard]] static int notifySlotIndex();
 	void connectNotifiers();
+	void connectObjectNotifiers(int notifySlot, QObject* obj, const QMetaObject* base);
 	void connectNotifiersRec(int notifySlot, QObject* obj, const QMetaObject* base);
+	void connectValueNotifiers(int notifySlot, const QVariant& value);
 	void deserializeRec(const QJsonObject& json, QObject* obj, const QMetaObject* base);
 	[[nodiscard]] QJsonObject serializeRec(const QObject* obj, const QMetaObject* base) const;
+	JsonObject* createObject(const QMetaType& type);
+	void reuseObject(JsonObject* object);
 
 	bool changesBlocked = false;
-	QList<JsonObject*> createdObjects;
-	QList<JsonObject*> oldCreatedObjects;
+	QSet<JsonObject*> createdObjects;
+	QSet<JsonObject*> oldCreatedObjects;
+	// Objects created during the current deserialization, which need notifiers connected.
+	QList<JsonObject*> newObjects;
 };
 
 } // namespace qs::io
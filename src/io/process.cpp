@@ -1,9 +1,10 @@
 #include "process.hpp"
-#include <csignal> // NOLINT
+#include <algorithm>
 #include <utility>
 
 #include <qdir.h>
 #include <qhash.h>
+#include <qjsvalue.h>
 #include <qlist.h>
 #include <qlogging.h>
 #include <qobject.h>
@@ -19,6 +20,13 @@
 #include "datastream.hpp"
 #include "processcore.hpp"
 
+namespace {
+constexpr qint32 COPROCESS_RESTART_MIN_DELAY = 100;
+constexpr qint32 COPROCESS_RESTART_MAX_DELAY = 30000;
+// A coprocess running for this long is considered healthy, and restarts without delay growth.
+constexpr qint64 COPROCESS_STABLE_TIME = 10000;
+} // namespace
+
 Process::Process(QObject* parent): PostReloadHook(parent) {
 	QObject::connect(
 	    QuickshellSettings::instance(),
@@ -26,12 +34,19 @@ Process::Process(QObject* parent): PostReloadHook(parent) {
 	    this,
 	    &Process::onGlobalWorkingDirectoryChanged
 	);
+
+	this->restartTimer.setSingleShot(true);
+	QObject::connect(&this->restartTimer, &QTimer::timeout, this, &Process::onRestartTimeout);
 }
 
 Process::~Process() {
 	if (this->process != nullptr && this->process->processId() != 0) {
-		// Deleting after the process finishes hides the process destroyed warning in logs
-		QObject::connect(this->process, &QProcess::finished, [p = this->process] { delete p; });
+		// Deleted after the process finishes so it is reaped.
+		QObject::connect(
+		    this->process,
+		    &qs::io::process::ChildProcess::finished,
+		    [p = this->process] { delete p; }
+		);
 
 		this->process->setParent(nullptr);
 		this->process->kill();
@@ -44,8 +59,12 @@ bool Process::isRunning() const { return this->process != nullptr; }
 
 void Process::setRunning(bool running) {
 	this->targetRunning = running;
+	this->keepAlive = running;
+	this->restartTimer.stop();
+
 	if (running) this->startProcessIfReady();
 	else if (this->isRunning()) this->process->terminate();
+	else this->failPendingRequests(); // queued for a coprocess that will no longer start
 }
 
 QVariant Process::processId() const {
@@ -117,6 +136,7 @@ void Process::setStdoutParser(DataStreamParser* parser) {
 
 	if (parser != nullptr) {
 		QObject::connect(parser, &QObject::destroyed, this, &Process::onStdoutParserDestroyed);
+		QObject::connect(parser, &DataStreamParser::read, this, &Process::onStdoutRead);
 	}
 
 	emit this->stdoutParserChanged();
@@ -177,6 +197,20 @@ void Process::setStdinEnabled(bool enabled) {
 	emit this->stdinEnabledChanged();
 }
 
+bool Process::coprocess() const { return this->mCoprocess; }
+
+void Process::setCoprocess(bool coprocess) {
+	if (coprocess == this->mCoprocess) return;
+	this->mCoprocess = coprocess;
+
+	if (!coprocess) {
+		this->restartTimer.stop();
+		this->failPendingRequests();
+	}
+
+	emit this->coprocessChanged();
+}
+
 void Process::startProcessIfReady() {
 	if (this->process != nullptr || !this->isPostReload || !this->targetRunning
 	    || this->mCommand.isEmpty())
@@ -195,25 +229,44 @@ void Process::startProcessIfReady() {
 
 	auto args = this->mCommand.sliced(1);
 
-	this->process = new QProcess(this);
+	using qs::io::process::StdioMode;
 
-	// clang-format off
-	QObject::connect(this->process, &QProcess::started, this, &Process::onStarted);
-	QObject::connect(this->process, &QProcess::finished, this, &Process::onFinished);
-	QObject::connect(this->process, &QProcess::errorOccurred, this, &Process::onErrorOccurred);
-	QObject::connect(this->process, &QProcess::readyReadStandardOutput, this, &Process::onStdoutReadyRead);
-	QObject::connect(this->process, &QProcess::readyReadStandardError, this, &Process::onStderrReadyRead);
-	// clang-format on
+	auto options = qs::io::process::SpawnOptions {
+	    .program = cmd,
+	    .arguments = args,
+	    .stdinMode = this->mStdinEnabled || this->mCoprocess ? StdioMode::Pipe : StdioMode::Null,
+	    .stdoutMode = this->mStdoutParser != nullptr ? StdioMode::Pipe : StdioMode::Null,
+	    .stderrMode = this->mStderrParser != nullptr ? StdioMode::Pipe : StdioMode::Null,
+	};
+
+	this->setupEnvironment(options);
 
 	this->stdoutBuffer.clear();
 	this->stderrBuffer.clear();
 
-	if (this->mStdoutParser == nullptr) this->process->closeReadChannel(QProcess::StandardOutput);
-	if (this->mStderrParser == nullptr) this->process->closeReadChannel(QProcess::StandardError);
-	if (!this->mStdinEnabled) this->process->closeWriteChannel();
+	auto* process = new qs::io::process::ChildProcess(this);
+
+	if (!process->start(options)) {
+		qWarning() << "Process failed to start, likely because the binary could not be found. Command:"
+		           << this->mCommand << "Error:" << process->errorString();
+		delete process;
+		this->failPendingRequests();
+		return;
+	}
 
-	this->setupEnvironment(this->process);
-	this->process->start(cmd, args);
+	this->process = process;
+	this->uptime.start();
+
+	// clang-format off
+	QObject::connect(process, &qs::io::process::ChildProcess::started, this, &Process::onStarted);
+	QObject::connect(process, &qs::io::process::ChildProcess::finished, this, &Process::onFinished);
+	QObject::connect(process, &qs::io::process::ChildProcess::readyReadStandardOutput, this, &Process::onStdoutReadyRead);
+	QObject::connect(process, &qs::io::process::ChildProcess::readyReadStandardError, this, &Process::onStderrReadyRead);
+	// clang-format on
+
+	if (!this->queuedRequestData.isEmpty()) {
+		process->write(std::exchange(this->queuedRequestData, {}));
+	}
 }
 
 void Process::exec(QList<QString> command) {
@@ -241,28 +294,24 @@ void Process::startDetached() {
 		return;
 	}
 
-	auto& cmd = this->mCommand.first();
-	auto args = this->mCommand.sliced(1);
-
-	QProcess process;
+	auto options = qs::io::process::SpawnOptions {
+	    .program = this->mCommand.first(),
+	    .arguments = this->mCommand.sliced(1),
+	    .newSession = true,
+	};
 
-	this->setupEnvironment(&process);
-	process.setProgram(cmd);
-	process.setArguments(args);
+	this->setupEnvironment(options);
 
-	process.setStandardInputFile(QProcess::nullDevice());
-	process.setStandardOutputFile(QProcess::nullDevice());
-	process.setStandardErrorFile(QProcess::nullDevice());
-
-	process.startDetached();
-}
-
-void Process::setupEnvironment(QProcess* process) {
-	if (!this->mWorkingDirectory.isEmpty()) {
-		process->setWorkingDirectory(this->mWorkingDirectory);
+	auto error = QString();
+	if (!qs::io::process::ChildProcess::startDetached(options, &error)) {
+		qmlWarning(this) << "Failed to start detached process: " << error;
 	}
+}
 
-	qs::io::process::setupProcessEnvironment(process, this->mClearEnvironment, this->mEnvironment);
+void Process::setupEnvironment(qs::io::process::SpawnOptions& options) const {
+	options.workingDirectory = this->mWorkingDirectory;
+	options.environment =
+	    qs::io::process::processEnvironment(this->mClearEnvironment, this->mEnvironment);
 }
 
 void Process::onStarted() {
@@ -279,20 +328,89 @@ void Process::onFinished(qint32 exitCode, QProcess::ExitStatus exitStatus) {
 	this->stdoutBuffer.clear();
 	this->stderrBuffer.clear();
 
+	// Anything not answered by the remaining output never will be.
+	this->failPendingRequests();
+
 	emit this->exited(exitCode, exitStatus);
 	emit this->runningChanged();
 	emit this->processIdChanged();
 
 	this->startProcessIfReady(); // for `running = false; running = true`
+
+	if (this->process == nullptr && this->mCoprocess && this->keepAlive) this->scheduleRestart();
 }
 
-void Process::onErrorOccurred(QProcess::ProcessError error) {
-	if (error == QProcess::FailedToStart) { // other cases should be covered by other events
-		qWarning() << "Process failed to start, likely because the binary could not be found. Command:"
-		           << this->mCommand;
-		this->process->deleteLater();
-		this->process = nullptr;
-		emit this->runningChanged();
+void Process::scheduleRestart() {
+	if (this->uptime.isValid() && this->uptime.elapsed() >= COPROCESS_STABLE_TIME) {
+		this->restartDelay = 0;
+	}
+
+	this->restartDelay = this->restartDelay == 0
+	                       ? COPROCESS_RESTART_MIN_DELAY
+	                       : std::min(this->restartDelay * 2, COPROCESS_RESTART_MAX_DELAY);
+
+	qmlWarning(this) << "Coprocess exited, restarting in " << this->restartDelay << "ms.";
+	this->restartTimer.start(this->restartDelay);
+}
+
+void Process::onRestartTimeout() {
+	if (!this->mCoprocess || !this->keepAlive) return;
+	this->targetRunning = true;
+	this->startProcessIfReady();
+}
+
+void Process::request(const QString& data, const QJSValue& callback) {
+	if (!this->mCoprocess) {
+		qmlWarning(this) << "Cannot send request as coprocess is false.";
+		return;
+	}
+
+	if (this->mStdoutParser == nullptr) {
+		qmlWarning(this) << "Cannot send request as there is no stdout parser to read responses.";
+		return;
+	}
+
+	if (!callback.isUndefined() && !callback.isCallable()) {
+		qmlWarning(this) << "Request callback must be a function.";
+		return;
+	}
+
+	this->pendingRequests.append(callback);
+
+	if (this->process != nullptr) {
+		this->process->write(data.toUtf8());
+	} else {
+		this->queuedRequestData.append(data.toUtf8());
+		// A restart already scheduled writes the request when it starts.
+		if (!this->restartTimer.isActive()) this->setRunning(true);
+	}
+}
+
+void Process::onStdoutRead(const QString& data) {
+	if (!this->mCoprocess || this->pendingRequests.isEmpty()) return;
+
+	this->restartDelay = 0;
+	auto callback = this->pendingRequests.takeFirst();
+	this->respond(callback, QJSValue(data));
+}
+
+void Process::respond(const QJSValue& callback, const QJSValue& response) {
+	if (!callback.isCallable()) return;
+
+	auto result = callback.call({response});
+
+	if (result.isError()) {
+		qmlWarning(this) << "Error in request callback: " << result.toString();
+	}
+}
+
+void Process::failPendingRequests() {
+	this->queuedRequestData.clear();
+
+	// Callbacks may make new requests.
+	auto pending = std::exchange(this->pendingRequests, {});
+	for (const auto& callback: pending) {
+		this->respond(callback, QJSValue(QJSValue::NullValue));
 	}
 }
 
@@ -310,7 +428,7 @@ void Process::onStderrReadyRead() {
 
 void Process::signal(qint32 signal) {
 	if (this->process == nullptr) return;
-	kill(static_cast<qint32>(this->process->processId()), signal); // NOLINT
+	this->process->sendSignal(signal);
 }
 
 void Process::write(const QString& data) {
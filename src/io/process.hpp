@@ -1,11 +1,15 @@
 #pragma once
 
 #include <qcontainerfwd.h>
+#include <qelapsedtimer.h>
 #include <qhash.h>
+#include <qjsvalue.h>
+#include <qlist.h>
 #include <qobject.h>
 #include <qprocess.h>
 #include <qqmlintegration.h>
 #include <qtclasshelpermacros.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 #include <qvariant.h>
@@ -31,6 +35,22 @@
 ///   }
 /// }
 /// ```
+///
+/// #### Coprocess
+/// Commands which are run repeatedly can instead be kept running as a coprocess,
+/// answering requests written to their stdin. See @@coprocess and @@request().
+///
+/// ```qml
+/// Process {
+///   id: calc
+///   command: [ "bc", "-l" ]
+///   coprocess: true
+///   stdout: SplitParser {}
+/// }
+///
+/// // elsewhere
+/// calc.request("2 * 21\n", result => console.log(result)); // 42
+/// ```
 class Process: public PostReloadHook {
 	Q_OBJECT;
 	// clang-format off
@@ -132,6 +152,16 @@ class Process: public PostReloadHook {
 	/// If stdin is enabled. Defaults to false. If this property is false the process's stdin channel
 	/// will be closed and @@write() will do nothing, even if set back to true.
 	Q_PROPERTY(bool stdinEnabled READ stdinEnabled WRITE setStdinEnabled NOTIFY stdinEnabledChanged);
+	/// If the process should be kept running to answer @@request() calls. Defaults to false.
+	///
+	/// A coprocess always has stdin enabled, and is started by the first @@request() if not
+	/// already @@running. If it exits while @@running is true it is restarted, with a delay
+	/// that doubles on each consecutive failure, up to 30 seconds. The delay is reset once
+	/// the process answers a request or has been running for 10 seconds.
+	///
+	/// Each value read by the @@stdout parser is the response to the oldest unanswered request.
+	/// Use a @@SplitParser to frame responses by line or by another delimiter.
+	Q_PROPERTY(bool coprocess READ coprocess WRITE setCoprocess NOTIFY coprocessChanged);
 	// clang-format on
 	QML_ELEMENT;
 
@@ -182,6 +212,15 @@ public:
 	/// Writes to the process's stdin. Does nothing if @@running is false.
 	Q_INVOKABLE void write(const QString& data);
 
+	/// Sends a request to the coprocess, calling `callback` with its response.
+	///
+	/// `data` is written to stdin as is, and should include a trailing newline if
+	/// the process reads lines. Requests are answered in the order they were sent.
+	/// If the process exits before answering, `callback` is called with `null`.
+	///
+	/// Does nothing if @@coprocess is false. See @@coprocess for details.
+	Q_INVOKABLE void request(const QString& data, const QJSValue& callback = QJSValue());
+
 	/// Launches an instance of the process detached from Quickshell.
 	///
 	/// The subprocess will not be tracked, @@running will be false,
@@ -216,6 +255,9 @@ public:
 	[[nodiscard]] bool stdinEnabled() const;
 	void setStdinEnabled(bool enabled);
 
+	[[nodiscard]] bool coprocess() const;
+	void setCoprocess(bool coprocess);
+
 signals:
 	void started();
 	void exited(qint32 exitCode, QProcess::ExitStatus exitStatus);
@@ -229,22 +271,27 @@ signals:
 	void stdoutParserChanged();
 	void stderrParserChanged();
 	void stdinEnabledChanged();
+	void coprocessChanged();
 
 private slots:
 	void onStarted();
 	void onFinished(qint32 exitCode, QProcess::ExitStatus exitStatus);
-	void onErrorOccurred(QProcess::ProcessError error);
 	void onStdoutReadyRead();
 	void onStderrReadyRead();
+	void onStdoutRead(const QString& data);
 	void onStdoutParserDestroyed();
 	void onStderrParserDestroyed();
 	void onGlobalWorkingDirectoryChanged();
+	void onRestartTimeout();
 
 private:
 	void startProcessIfReady();
-	void setupEnvironment(QProcess* process);
+	void scheduleRestart();
+	void respond(const QJSValue& callback, const QJSValue& response);
+	void failPendingRequests();
+	void setupEnvironment(qs::io::process::SpawnOptions& options) const;
 
-	QProcess* process = nullptr;
+	qs::io::process::ChildProcess* process = nullptr;
 	QList<QString> mCommand;
 	QString mWorkingDirectory;
 	QHash<QString, QVariant> mEnvironment;
@@ -253,7 +300,18 @@ private:
 	QByteArray stdoutBuffer;
 	QByteArray stderrBuffer;
 
+	// Callbacks of requests written or queued for the coprocess, oldest first.
+	QList<QJSValue> pendingRequests;
+	// Requests made while the coprocess was not running, written once it starts.
+	QByteArray queuedRequestData;
+	QTimer restartTimer;
+	qint32 restartDelay = 0;
+	QElapsedTimer uptime;
+
 	bool targetRunning = false;
+	// Set while the coprocess should be restarted when it exits.
+	bool keepAlive = false;
 	bool mStdinEnabled = false;
 	bool mClearEnvironment = false;
+	bool mCoprocess = false;
 };
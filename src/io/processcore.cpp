@@ -1,19 +1,99 @@
 #include "processcore.hpp"
+#include <array>
+#include <cerrno>
+#include <csignal> // NOLINT
+#include <cstring>
+#include <utility>
+#include <vector>
 
+#include <fcntl.h>
+#include <qbytearray.h>
 #include <qcontainerfwd.h>
+#include <qfile.h>
 #include <qhash.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qobjectdefs.h>
 #include <qprocess.h>
+#include <qscopeguard.h>
+#include <qsocketnotifier.h>
+#include <qtimer.h>
+#include <qtypes.h>
 #include <qvariant.h>
+#include <spawn.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 #include "../core/common.hpp"
+#include "../core/logcat.hpp"
 
 namespace qs::io::process {
 
-void setupProcessEnvironment(
-    QProcess* process,
-    bool clear,
-    const QHash<QString, QVariant>& envChanges
-) {
+namespace {
+QS_LOGGING_CATEGORY(logProcess, "quickshell.process", QtWarningMsg);
+
+constexpr qsizetype READ_CHUNK_SIZE = 16384;
+// Only used on kernels without pidfd_open (before 5.3).
+constexpr int EXIT_POLL_INTERVAL = 50;
+
+// Owns both ends of a pipe until they are taken.
+class Pipe {
+public:
+	Pipe() = default;
+	~Pipe() {
+		for (auto fd: this->fds) {
+			if (fd != -1) ::close(fd);
+		}
+	}
+	Q_DISABLE_COPY_MOVE(Pipe);
+
+	bool open() { return ::pipe2(this->fds.data(), O_CLOEXEC) == 0; }
+	[[nodiscard]] int end(int end) const { return this->fds.at(end); }
+	int take(int end) { return std::exchange(this->fds.at(end), -1); }
+
+private:
+	std::array<int, 2> fds {-1, -1};
+};
+
+int pidfdOpen(pid_t pid) {
+#ifdef SYS_pidfd_open
+	return static_cast<int>(::syscall(SYS_pidfd_open, pid, 0));
+#else
+	errno = ENOSYS;
+	return -1;
+#endif
+}
+
+void ignoreSigpipe() {
+	// Writes to the stdin of an exited child would otherwise kill quickshell. QProcess does the same.
+	static auto ignored = [] {
+		::signal(SIGPIPE, SIG_IGN); // NOLINT
+		return true;
+	}();
+
+	(void) ignored;
+}
+
+void setNonBlocking(int fd) { ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK); } // NOLINT
+
+// Holds encoded strings alongside the null terminated pointer array passed to exec.
+struct CStringArray {
+	explicit CStringArray(QList<QByteArray> strings): strings(std::move(strings)) {
+		this->pointers.reserve(this->strings.length() + 1);
+		for (auto& string: this->strings) this->pointers.push_back(string.data());
+		this->pointers.push_back(nullptr);
+	}
+
+	QList<QByteArray> strings;
+	std::vector<char*> pointers;
+};
+
+} // namespace
+
+QProcessEnvironment processEnvironment(bool clear, const QHash<QString, QVariant>& envChanges) {
 	const auto& sysenv = qs::Common::INITIAL_ENVIRONMENT;
 	auto env = clear ? QProcessEnvironment() : sysenv;
 
@@ -31,7 +111,381 @@ void setupProcessEnvironment(
 		}
 	}
 
-	process->setProcessEnvironment(env);
+	return env;
+}
+
+ChildProcess::~ChildProcess() {
+	this->stopExitTracking();
+	ChildProcess::closeChannel(this->stdoutChannel);
+	ChildProcess::closeChannel(this->stderrChannel);
+	this->closeStdin();
+}
+
+bool ChildProcess::start(const SpawnOptions& options) {
+	if (this->pid != 0) {
+		this->mErrorString = "Process is already running";
+		return false;
+	}
+
+	ignoreSigpipe();
+
+	auto stdinPipe = Pipe();
+	auto stdoutPipe = Pipe();
+	auto stderrPipe = Pipe();
+
+	if ((options.stdinMode == StdioMode::Pipe && !stdinPipe.open())
+	    || (options.stdoutMode == StdioMode::Pipe && !stdoutPipe.open())
+	    || (options.stderrMode == StdioMode::Pipe && !stderrPipe.open()))
+	{
+		this->mErrorString =
+		    QString("Failed to create pipes: %1").arg(QString::fromUtf8(std::strerror(errno)));
+		return false;
+	}
+
+	auto actions = posix_spawn_file_actions_t();
+	auto attr = posix_spawnattr_t();
+	posix_spawn_file_actions_init(&actions);
+	posix_spawnattr_init(&attr);
+
+	auto guard = qScopeGuard([&] {
+		posix_spawn_file_actions_destroy(&actions);
+		posix_spawnattr_destroy(&attr);
+	});
+
+	// dup2 clears O_CLOEXEC on the target, and every other pipe end is closed on exec.
+	auto setupStdio = [&](int target, StdioMode mode, Pipe& pipe, int childEnd) {
+		switch (mode) {
+		case StdioMode::Pipe:
+			posix_spawn_file_actions_adddup2(&actions, pipe.end(childEnd), target);
+			break;
+		case StdioMode::Null:
+			posix_spawn_file_actions_addopen(
+			    &actions,
+			    target,
+			    "/dev/null",
+			    target == STDIN_FILENO ? O_RDONLY : O_WRONLY,
+			    0
+			);
+			break;
+		case StdioMode::Inherit: break;
+		}
+	};
+
+	setupStdio(STDIN_FILENO, options.stdinMode, stdinPipe, 0);
+	setupStdio(STDOUT_FILENO, options.stdoutMode, stdoutPipe, 1);
+	setupStdio(STDERR_FILENO, options.stderrMode, stderrPipe, 1);
+
+	if (!options.workingDirectory.isEmpty()) {
+		posix_spawn_file_actions_addchdir_np(
+		    &actions,
+		    QFile::encodeName(options.workingDirectory).constData()
+		);
+	}
+
+	// Signal handlers and the signal mask would otherwise be inherited from quickshell.
+	auto mask = sigset_t();
+	sigemptyset(&mask);
+	posix_spawnattr_setsigmask(&attr, &mask);
+
+	auto defaults = sigset_t();
+	sigfillset(&defaults);
+	posix_spawnattr_setsigdefault(&attr, &defaults);
+
+	auto flags = static_cast<short>(POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+#ifdef POSIX_SPAWN_SETSID
+	if (options.newSession) flags = static_cast<short>(flags | POSIX_SPAWN_SETSID);
+#endif
+	posix_spawnattr_setflags(&attr, flags);
+
+	auto program = QFile::encodeName(options.program);
+
+	auto argList = QList<QByteArray>();
+	argList.reserve(options.arguments.length() + 1);
+	argList.append(program);
+	for (const auto& arg: options.arguments) argList.append(arg.toLocal8Bit());
+	auto argv = CStringArray(std::move(argList));
+
+	auto envList = QList<QByteArray>();
+	for (const auto& var: options.environment.toStringList()) envList.append(var.toLocal8Bit());
+	auto envp = CStringArray(std::move(envList));
+
+	// The program is looked up in quickshell's PATH, matching QProcess.
+	pid_t pid = 0;
+	auto result = posix_spawnp(
+	    &pid,
+	    program.constData(),
+	    &actions,
+	    &attr,
+	    argv.pointers.data(),
+	    envp.pointers.data()
+	);
+
+	if (result != 0) {
+		this->mErrorString = QString("Failed to start %1: %2")
+		                         .arg(options.program, QString::fromUtf8(std::strerror(result)));
+		return false;
+	}
+
+	this->pid = pid;
+	this->startedEmitted = false;
+	qCDebug(logProcess) << "Started" << options.program << "with pid" << pid;
+
+	// The child can't be reaped before its pidfd is opened, so its pid can't be reused here.
+	this->pidfd = pidfdOpen(pid);
+
+	if (this->pidfd != -1) {
+		this->exitNotifier = new QSocketNotifier(this->pidfd, QSocketNotifier::Read, this);
+		QObject::connect(
+		    this->exitNotifier,
+		    &QSocketNotifier::activated,
+		    this,
+		    &ChildProcess::onExitNotified
+		);
+	} else {
+		qCDebug(logProcess) << "pidfd_open failed, polling for exit:" << std::strerror(errno);
+		this->exitPollTimer = new QTimer(this);
+		this->exitPollTimer->setInterval(EXIT_POLL_INTERVAL);
+		QObject::connect(this->exitPollTimer, &QTimer::timeout, this, &ChildProcess::onExitNotified);
+		this->exitPollTimer->start();
+	}
+
+	if (options.stdoutMode == StdioMode::Pipe) {
+		this->stdoutChannel.fd = stdoutPipe.take(0);
+		setNonBlocking(this->stdoutChannel.fd);
+		this->stdoutChannel.notifier =
+		    new QSocketNotifier(this->stdoutChannel.fd, QSocketNotifier::Read, this);
+		QObject::connect(
+		    this->stdoutChannel.notifier,
+		    &QSocketNotifier::activated,
+		    this,
+		    &ChildProcess::onStdoutReadable
+		);
+	}
+
+	if (options.stderrMode == StdioMode::Pipe) {
+		this->stderrChannel.fd = stderrPipe.take(0);
+		setNonBlocking(this->stderrChannel.fd);
+		this->stderrChannel.notifier =
+		    new QSocketNotifier(this->stderrChannel.fd, QSocketNotifier::Read, this);
+		QObject::connect(
+		    this->stderrChannel.notifier,
+		    &QSocketNotifier::activated,
+		    this,
+		    &ChildProcess::onStderrReadable
+		);
+	}
+
+	if (options.stdinMode == StdioMode::Pipe) {
+		this->stdinFd = stdinPipe.take(1);
+		setNonBlocking(this->stdinFd);
+		this->stdinNotifier = new QSocketNotifier(this->stdinFd, QSocketNotifier::Write, this);
+		this->stdinNotifier->setEnabled(false);
+		QObject::connect(
+		    this->stdinNotifier,
+		    &QSocketNotifier::activated,
+		    this,
+		    &ChildProcess::onStdinWritable
+		);
+	}
+
+	QMetaObject::invokeMethod(this, &ChildProcess::emitStarted, Qt::QueuedConnection);
+	return true;
+}
+
+bool ChildProcess::startDetached(const SpawnOptions& options, QString* error) {
+	auto* child = new ChildProcess();
+
+	if (!child->start(options)) {
+		if (error) *error = child->errorString();
+		delete child;
+		return false;
+	}
+
+	QObject::connect(child, &ChildProcess::finished, child, &QObject::deleteLater);
+	return true;
+}
+
+void ChildProcess::emitStarted() {
+	if (this->startedEmitted) return;
+	this->startedEmitted = true;
+	emit this->started();
+}
+
+QByteArray ChildProcess::readAllStandardOutput() {
+	return std::exchange(this->stdoutChannel.buffer, {});
+}
+
+QByteArray ChildProcess::readAllStandardError() {
+	return std::exchange(this->stderrChannel.buffer, {});
+}
+
+void ChildProcess::closeReadChannel(QProcess::ProcessChannel channel) {
+	auto& readChannel =
+	    channel == QProcess::StandardOutput ? this->stdoutChannel : this->stderrChannel;
+
+	ChildProcess::closeChannel(readChannel);
+	readChannel.buffer.clear();
+}
+
+void ChildProcess::onStdoutReadable() {
+	if (this->readChannel(this->stdoutChannel)) emit this->readyReadStandardOutput();
+}
+
+void ChildProcess::onStderrReadable() {
+	if (this->readChannel(this->stderrChannel)) emit this->readyReadStandardError();
+}
+
+bool ChildProcess::readChannel(ReadChannel& channel) {
+	if (channel.fd == -1) return false;
+
+	auto hasData = false;
+
+	while (true) {
+		auto size = channel.buffer.size();
+		channel.buffer.resize(size + READ_CHUNK_SIZE);
+
+		auto r = ::read(channel.fd, channel.buffer.data() + size, READ_CHUNK_SIZE);
+		channel.buffer.resize(size + (r > 0 ? r : 0));
+
+		if (r > 0) {
+			hasData = true;
+			// A short read means the pipe is drained. Anything after it is picked up on the next notification.
+			if (r == READ_CHUNK_SIZE) continue;
+			break;
+		}
+
+		if (r == -1 && errno == EINTR) continue;
+
+		if (r == -1 && errno != EAGAIN) {
+			qCDebug(logProcess) << "Failed to read output of" << this->pid << "-" << std::strerror(errno);
+		}
+
+		if (r == 0 || errno != EAGAIN) ChildProcess::closeChannel(channel);
+		break;
+	}
+
+	return hasData;
+}
+
+void ChildProcess::closeChannel(ReadChannel& channel) {
+	if (channel.fd == -1) return;
+
+	delete channel.notifier;
+	channel.notifier = nullptr;
+	::close(channel.fd);
+	channel.fd = -1;
+}
+
+void ChildProcess::write(const QByteArray& data) {
+	if (this->stdinFd == -1 || this->closeStdinAfterWrite) return;
+	this->stdinBuffer.append(data);
+	this->flushStdin();
+}
+
+void ChildProcess::closeWriteChannel() {
+	this->closeStdinAfterWrite = true;
+	this->flushStdin();
+}
+
+void ChildProcess::onStdinWritable() { this->flushStdin(); }
+
+void ChildProcess::flushStdin() {
+	if (this->stdinFd == -1) return;
+
+	while (!this->stdinBuffer.isEmpty()) {
+		auto r = ::write(this->stdinFd, this->stdinBuffer.constData(), this->stdinBuffer.size());
+
+		if (r == -1) {
+			if (errno == EINTR) continue;
+			if (errno == EAGAIN) break;
+
+			// Usually EPIPE, from the child closing stdin or exiting.
+			qCDebug(logProcess) << "Failed to write to" << this->pid << "-" << std::strerror(errno);
+			this->stdinBuffer.clear();
+			this->closeStdin();
+			return;
+		}
+
+		this->stdinBuffer.remove(0, r);
+	}
+
+	if (this->stdinBuffer.isEmpty() && this->closeStdinAfterWrite) {
+		this->closeStdin();
+		return;
+	}
+
+	this->stdinNotifier->setEnabled(!this->stdinBuffer.isEmpty());
+}
+
+void ChildProcess::closeStdin() {
+	if (this->stdinFd == -1) return;
+
+	delete this->stdinNotifier;
+	this->stdinNotifier = nullptr;
+	::close(this->stdinFd);
+	this->stdinFd = -1;
+	this->stdinBuffer.clear();
+}
+
+void ChildProcess::sendSignal(qint32 signal) {
+	if (this->pid == 0) return;
+	::kill(static_cast<pid_t>(this->pid), signal);
+}
+
+void ChildProcess::terminate() { this->sendSignal(SIGTERM); }
+void ChildProcess::kill() { this->sendSignal(SIGKILL); }
+
+void ChildProcess::onExitNotified() {
+	if (this->pid == 0) return;
+
+	auto status = 0;
+	auto r = ::waitpid(static_cast<pid_t>(this->pid), &status, WNOHANG);
+
+	// Not exited yet when polling.
+	if (r == 0 || (r == -1 && errno == EINTR)) return;
+
+	auto exitCode = -1;
+	auto exitStatus = QProcess::CrashExit;
+
+	if (r == -1) {
+		qCWarning(logProcess) << "Failed to reap process" << this->pid << "-" << std::strerror(errno);
+	} else if (WIFEXITED(status)) {
+		exitCode = WEXITSTATUS(status);
+		exitStatus = QProcess::NormalExit;
+	} else if (WIFSIGNALED(status)) {
+		exitCode = WTERMSIG(status);
+	}
+
+	qCDebug(logProcess) << "Process" << this->pid << "exited with code" << exitCode << exitStatus;
+
+	this->stopExitTracking();
+	this->pid = 0;
+
+	// The exit may be seen before the queued started signal.
+	this->emitStarted();
+
+	// Output still held by other processes sharing the pipes is not waited for, matching QProcess.
+	if (this->readChannel(this->stdoutChannel)) emit this->readyReadStandardOutput();
+	if (this->readChannel(this->stderrChannel)) emit this->readyReadStandardError();
+
+	ChildProcess::closeChannel(this->stdoutChannel);
+	ChildProcess::closeChannel(this->stderrChannel);
+	this->closeStdin();
+
+	// Receivers may delete the process.
+	emit this->finished(exitCode, exitStatus);
+}
+
+void ChildProcess::stopExitTracking() {
+	delete this->exitNotifier;
+	this->exitNotifier = nullptr;
+	delete this->exitPollTimer;
+	this->exitPollTimer = nullptr;
+
+	if (this->pidfd != -1) {
+		::close(this->pidfd);
+		this->pidfd = -1;
+	}
 }
 
 } // namespace qs::io::process
@@ -2,13 +2,21 @@
 
 #include <utility>
 
+#include <qbytearray.h>
 #include <qcontainerfwd.h>
 #include <qhash.h>
 #include <qlist.h>
+#include <qobject.h>
 #include <qprocess.h>
 #include <qqmlintegration.h>
+#include <qtclasshelpermacros.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
 #include <qvariant.h>
 
+class QSocketNotifier;
+class QTimer;
+
 namespace qs::io::process {
 
 class ProcessContext {
@@ -60,10 +68,113 @@ public:
 	bool unbindStdout : 1 = true;
 };
 
-void setupProcessEnvironment(
-    QProcess* process,
-    bool clear,
-    const QHash<QString, QVariant>& envChanges
-);
+QProcessEnvironment processEnvironment(bool clear, const QHash<QString, QVariant>& envChanges);
+
+enum class StdioMode : quint8 {
+	// Connected to a pipe read or written by ChildProcess.
+	Pipe,
+	// Connected to /dev/null.
+	Null,
+	// Shared with quickshell.
+	Inherit,
+};
+
+struct SpawnOptions {
+	QString program;
+	QList<QString> arguments;
+	// Quickshell's working directory if empty.
+	QString workingDirectory;
+	// Used as is, see processEnvironment().
+	QProcessEnvironment environment;
+	StdioMode stdinMode = StdioMode::Null;
+	StdioMode stdoutMode = StdioMode::Null;
+	StdioMode stderrMode = StdioMode::Null;
+	// Starts the process in a new session, detaching it from quickshell's terminal.
+	bool newSession = false;
+};
+
+// A child process started with posix_spawn, replacing QProcess for Process and execDetached.
+//
+// posix_spawn is implemented with clone(CLONE_VM | CLONE_VFORK) by glibc and musl, so
+// launching does not copy quickshell's page tables as fork does, which is most of the cost
+// of QProcess in a large process. Exit is observed through a pidfd on the event loop
+// instead of a SIGCHLD handler, with polling as a fallback on kernels without pidfd_open.
+//
+// Signals are delivered like QProcess, with started emitted from the event loop after
+// start() returns, and finished emitted once after all output available at exit was read.
+class ChildProcess: public QObject {
+	Q_OBJECT;
+
+public:
+	explicit ChildProcess(QObject* parent = nullptr): QObject(parent) {}
+	// A running child must be waited for, or it is not reaped until quickshell exits.
+	~ChildProcess() override;
+	Q_DISABLE_COPY_MOVE(ChildProcess);
+
+	// Returns false and sets errorString() if the process could not be started,
+	// in which case no signals are emitted.
+	bool start(const SpawnOptions& options);
+
+	// Starts a process that is not tracked, and is reaped when it exits.
+	static bool startDetached(const SpawnOptions& options, QString* error = nullptr);
+
+	// 0 if the process is not running.
+	[[nodiscard]] qint64 processId() const { return this->pid; }
+	[[nodiscard]] QString errorString() const { return this->mErrorString; }
+
+	QByteArray readAllStandardOutput();
+	QByteArray readAllStandardError();
+	// Closes the pipe, discarding unread data.
+	void closeReadChannel(QProcess::ProcessChannel channel);
+
+	// Buffered until stdin accepts it.
+	void write(const QByteArray& data);
+	// Closes stdin once buffered data is written.
+	void closeWriteChannel();
+
+	void sendSignal(qint32 signal);
+	void terminate();
+	void kill();
+
+signals:
+	void started();
+	void readyReadStandardOutput();
+	void readyReadStandardError();
+	void finished(qint32 exitCode, QProcess::ExitStatus exitStatus);
+
+private slots:
+	void onStdoutReadable();
+	void onStderrReadable();
+	void onStdinWritable();
+	void onExitNotified();
+
+private:
+	struct ReadChannel {
+		int fd = -1;
+		QSocketNotifier* notifier = nullptr;
+		QByteArray buffer;
+	};
+
+	void emitStarted();
+	// Reads everything currently available, returning true if anything was read.
+	bool readChannel(ReadChannel& channel);
+	static void closeChannel(ReadChannel& channel);
+	void flushStdin();
+	void closeStdin();
+	void stopExitTracking();
+
+	qint64 pid = 0;
+	int pidfd = -1;
+	QSocketNotifier* exitNotifier = nullptr;
+	QTimer* exitPollTimer = nullptr;
+	ReadChannel stdoutChannel;
+	ReadChannel stderrChannel;
+	int stdinFd = -1;
+	QSocketNotifier* stdinNotifier = nullptr;
+	QByteArray stdinBuffer;
+	bool closeStdinAfterWrite = false;
+	bool startedEmitted = false;
+	QString mErrorString;
+};
 
 } // namespace qs::io::process
@@ -0,0 +1,148 @@
+#include "filesampler.hpp"
+
+#include <qbytearray.h>
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qtemporarydir.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qvariant.h>
+
+#include "../filesampler.hpp"
+#include "../fileview.hpp"
+
+using namespace qs::io;
+
+void TestFileSampler::parse_data() { // NOLINT
+	QTest::addColumn<QByteArray>("data");
+	QTest::addColumn<FileSamplerFormat::Enum>("format");
+	QTest::addColumn<QVariant>("expected");
+
+	// NOLINTBEGIN
+	// clang-format off
+	QTest::addRow("raw") << QByteArray("42\n")
+		<< FileSamplerFormat::Raw << QVariant();
+
+	QTest::addRow("value-int") << QByteArray("42\n")
+		<< FileSamplerFormat::Value << QVariant(42ll);
+
+	QTest::addRow("value-real") << QByteArray("0.52 0.58 0.59 1/467 4410\n")
+		<< FileSamplerFormat::Value << QVariant(0.52);
+
+	QTest::addRow("value-string") << QByteArray("Charging\n")
+		<< FileSamplerFormat::Value << QVariant(QString("Charging"));
+
+	QTest::addRow("value-empty") << QByteArray("")
+		<< FileSamplerFormat::Value << QVariant();
+
+	QTest::addRow("meminfo") << QByteArray("MemTotal:       16318856 kB\nMemFree:         1024 kB\nHugePages_Total:       0\n")
+		<< FileSamplerFormat::KeyValue << QVariant(QVariantMap {
+			{"MemTotal", 16318856ll},
+			{"MemFree", 1024ll},
+			{"HugePages_Total", 0ll},
+		});
+
+	QTest::addRow("uevent") << QByteArray("POWER_SUPPLY_NAME=BAT0\nPOWER_SUPPLY_CAPACITY=87\n")
+		<< FileSamplerFormat::KeyValue << QVariant(QVariantMap {
+			{"POWER_SUPPLY_NAME", QString("BAT0")},
+			{"POWER_SUPPLY_CAPACITY", 87ll},
+		});
+
+	QTest::addRow("procstat") << QByteArray("cpu  10 20 30\ncpu0 1 2 3\nctxt 4000\n")
+		<< FileSamplerFormat::ProcStat << QVariant(QVariantMap {
+			{"cpu", QVariantList {10ll, 20ll, 30ll}},
+			{"cpu0", QVariantList {1ll, 2ll, 3ll}},
+			{"ctxt", 4000ll},
+		});
+	// clang-format on
+	// NOLINTEND
+}
+
+void TestFileSampler::parse() {
+	QFETCH(QByteArray, data);
+	QFETCH(FileSamplerFormat::Enum, format);
+	QFETCH(QVariant, expected);
+
+	QCOMPARE(FileSampleSource::parse(data, format), expected);
+}
+
+void TestFileSampler::readChanges() {
+	auto dir = QTemporaryDir();
+	QVERIFY(dir.isValid());
+
+	auto path = dir.filePath("value");
+	auto write = [&](const QByteArray& data) {
+		auto file = QFile(path);
+		QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+		file.write(data);
+	};
+
+	write("1\n");
+
+	auto source = FileSampleSource(QFile::encodeName(path));
+	QVERIFY(source.read());
+	QCOMPARE(source.data(), QByteArray("1\n"));
+
+	// Unchanged content is not reported again.
+	QVERIFY(!source.read());
+
+	// Rewritten in place, as sysfs files are, through the same fd.
+	write("22\n");
+	QVERIFY(source.read());
+	QCOMPARE(source.data(), QByteArray("22\n"));
+
+	// Larger than the initial buffer.
+	auto large = QByteArray(10000, 'a');
+	write(large);
+	QVERIFY(source.read());
+	QCOMPARE(source.data(), large);
+	QVERIFY(!source.read());
+}
+
+namespace {
+
+void addProcRows() {
+	QTest::addColumn<QString>("path");
+	QTest::addColumn<FileSamplerFormat::Enum>("format");
+
+	QTest::addRow("stat") << "/proc/stat" << FileSamplerFormat::ProcStat;
+	QTest::addRow("meminfo") << "/proc/meminfo" << FileSamplerFormat::KeyValue;
+	QTest::addRow("loadavg") << "/proc/loadavg" << FileSamplerFormat::Value;
+}
+
+} // namespace
+
+void TestFileSampler::benchFileView_data() { addProcRows(); } // NOLINT
+
+// Equivalent to polling a FileView with reload(), excluding the javascript
+// needed to parse the result.
+void TestFileSampler::benchFileView() {
+	QFETCH(QString, path);
+	if (!QFileInfo::exists(path)) QSKIP("File does not exist");
+
+	QBENCHMARK {
+		auto state = FileViewState(path);
+		FileViewReader::read(nullptr, state, true);
+	}
+}
+
+void TestFileSampler::benchSampler_data() { addProcRows(); } // NOLINT
+
+void TestFileSampler::benchSampler() {
+	QFETCH(QString, path);
+	QFETCH(FileSamplerFormat::Enum, format);
+	if (!QFileInfo::exists(path)) QSKIP("File does not exist");
+
+	auto source = FileSampleSource(QFile::encodeName(path));
+
+	QBENCHMARK {
+		if (source.read()) {
+			auto text = QString::fromUtf8(source.data());
+			auto values = FileSampleSource::parse(source.data(), format);
+		}
+	}
+}
+
+QTEST_MAIN(TestFileSampler);
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestFileSampler: public QObject {
+	Q_OBJECT;
+
+private slots:
+	void parse_data(); // NOLINT
+	void parse();
+	void readChanges();
+	void benchFileView_data(); // NOLINT
+	void benchFileView();
+	void benchSampler_data(); // NOLINT
+	void benchSampler();
+};
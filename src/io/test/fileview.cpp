@@ -0,0 +1,107 @@
+#include "fileview.hpp"
+#include <cstdio>
+
+#include <qbytearray.h>
+#include <qfile.h>
+#include <qlist.h>
+#include <qstring.h>
+#include <qtemporarydir.h>
+#include <qtest.h>
+#include <qtestcase.h>
+
+#include "../fileview.hpp"
+
+using namespace qs::io;
+
+namespace {
+
+void writeFile(const QString& path, const QByteArray& data, bool append = false) {
+	auto file = QFile(path);
+	QVERIFY(file.open(append ? QFile::Append : (QFile::WriteOnly | QFile::Truncate)));
+	file.write(data);
+}
+
+} // namespace
+
+void TestFileView::textOnlyRead() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("large");
+
+	// Multibyte characters are split across decode chunks.
+	auto content = QByteArray();
+	for (auto i = 0; content.size() < 256 * 1024; i++) {
+		content += QByteArray::number(i) + " \xc3\xa9\n";
+	}
+	writeFile(path, content);
+
+	auto state = FileViewState(path);
+	state.textOnly = true;
+	FileViewReader::read(nullptr, state, false);
+
+	QCOMPARE(state.error, FileViewError::Success);
+	QCOMPARE(state.data.operator const QString&(), QString::fromUtf8(content));
+	QCOMPARE(state.data.operator const QByteArray&(), content);
+
+	// Files without a known size, such as those in procfs, are read until they end.
+	auto procState = FileViewState("/proc/self/status");
+	procState.textOnly = true;
+	FileViewReader::read(nullptr, procState, false);
+	QCOMPARE(procState.error, FileViewError::Success);
+	QVERIFY(procState.data.operator const QString&().startsWith("Name:"));
+}
+
+void TestFileView::tailAppend() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("log");
+	writeFile(path, "existing\n");
+
+	auto tail = FileViewTailState {.path = path};
+
+	// Existing content is skipped.
+	FileViewTailReader::read(tail);
+	QVERIFY(tail.lines.isEmpty());
+
+	writeFile(path, "one\ntwo\r\nthr", true);
+	FileViewTailReader::read(tail);
+	QCOMPARE(tail.lines, QStringList({"one", "two"}));
+	tail.lines.clear();
+
+	// Partial lines are completed by later appends.
+	writeFile(path, "ee\n", true);
+	FileViewTailReader::read(tail);
+	QCOMPARE(tail.lines, QStringList({"three"}));
+	tail.lines.clear();
+
+	FileViewTailReader::read(tail);
+	QVERIFY(tail.lines.isEmpty());
+}
+
+void TestFileView::tailTruncate() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("log");
+	writeFile(path, "a long existing line\n");
+
+	auto tail = FileViewTailState {.path = path};
+	FileViewTailReader::read(tail);
+
+	writeFile(path, "new\n");
+	FileViewTailReader::read(tail);
+	QCOMPARE(tail.lines, QStringList({"new"}));
+}
+
+void TestFileView::tailReplace() {
+	auto dir = QTemporaryDir();
+	auto path = dir.filePath("log");
+	writeFile(path, "old\n");
+
+	auto tail = FileViewTailState {.path = path};
+	FileViewTailReader::read(tail);
+
+	// Replaced by a longer file, which cannot be detected by size alone.
+	writeFile(dir.filePath("log.new"), "first\nsecond\n");
+	QCOMPARE(std::rename(QFile::encodeName(dir.filePath("log.new")).constData(), QFile::encodeName(path).constData()), 0);
+	FileViewTailReader::read(tail);
+	QCOMPARE(tail.lines, QStringList({"first", "second"}));
+}
+
+QTEST_MAIN(TestFileView);
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestFileView: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void textOnlyRead();
+	static void tailAppend();
+	static void tailTruncate();
+	static void tailReplace();
+};
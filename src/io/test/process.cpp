@@ -1,11 +1,18 @@
 #include "process.hpp"
 
+#include <qjsengine.h>
+#include <qjsvalue.h>
 #include <qlist.h>
+#include <qprocess.h>
 #include <qsignalspy.h>
+#include <qstring.h>
 #include <qtest.h>
 #include <qtestcase.h>
+#include <qvariant.h>
 
+#include "../datastream.hpp"
 #include "../process.hpp"
+#include "../processcore.hpp"
 
 void TestProcess::startAfterReload() {
 	auto process = Process();
@@ -44,4 +51,103 @@ void TestProcess::testExec() {
 	QVERIFY(process.isRunning());
 }
 
+void TestProcess::readOutput() {
+	auto process = Process();
+	auto stdoutCollector = StdioCollector();
+	auto stderrCollector = StdioCollector();
+	auto exitedSpy = QSignalSpy(&process, &Process::exited);
+
+	process.postReload();
+	process.setStdoutParser(&stdoutCollector);
+	process.setStderrParser(&stderrCollector);
+	process.setStdinEnabled(true);
+	process.exec({"sh", "-c", "read line; echo \"$line\"; echo err >&2; exit 3"});
+
+	QVERIFY(process.isRunning());
+	process.write("hello\n");
+
+	QVERIFY(exitedSpy.wait(1000));
+	QCOMPARE(exitedSpy.first().at(0).toInt(), 3);
+	QCOMPARE(exitedSpy.first().at(1).value<QProcess::ExitStatus>(), QProcess::NormalExit);
+	QCOMPARE(stdoutCollector.text(), QString("hello\n"));
+	QCOMPARE(stderrCollector.text(), QString("err\n"));
+	QVERIFY(!process.isRunning());
+}
+
+void TestProcess::coprocess() {
+	auto engine = QJSEngine();
+	engine.globalObject().setProperty("responses", engine.newArray());
+	auto callback = engine.evaluate("(response => responses.push(response))");
+	auto responses = [&]() { return engine.globalObject().property("responses").toVariant(); };
+
+	auto process = Process();
+	auto parser = SplitParser();
+	auto startedSpy = QSignalSpy(&process, &Process::started);
+
+	process.postReload();
+	process.setCommand({"cat"});
+	process.setCoprocess(true);
+	process.setStdoutParser(&parser);
+
+	// Starts the process.
+	process.request("first\n", callback);
+	process.request("second\n", callback);
+
+	QVERIFY(process.isRunning());
+	QTRY_COMPARE(responses(), QVariant(QVariantList({"first", "second"})));
+	QCOMPARE(startedSpy.count(), 1);
+}
+
+void TestProcess::coprocessRestart() {
+	auto engine = QJSEngine();
+	engine.globalObject().setProperty("responses", engine.newArray());
+	auto callback = engine.evaluate("(response => responses.push(response))");
+	auto responses = [&]() { return engine.globalObject().property("responses").toVariant(); };
+
+	auto process = Process();
+	auto parser = SplitParser();
+	auto startedSpy = QSignalSpy(&process, &Process::started);
+
+	process.postReload();
+	// Answers a single request and exits.
+	process.setCommand({"sh", "-c", "read line; echo \"$line\""});
+	process.setCoprocess(true);
+	process.setStdoutParser(&parser);
+	process.setRunning(true);
+
+	process.request("first\n", callback);
+	QTRY_COMPARE(responses(), QVariant(QVariantList({"first"})));
+
+	QTRY_COMPARE(startedSpy.count(), 2);
+	QVERIFY(process.isRunning());
+
+	process.request("second\n", callback);
+	QTRY_COMPARE(responses(), QVariant(QVariantList({"first", "second"})));
+}
+
+void TestProcess::benchSpawn() {
+	QBENCHMARK {
+		auto process = qs::io::process::ChildProcess();
+		auto finishedSpy = QSignalSpy(&process, &qs::io::process::ChildProcess::finished);
+
+		QVERIFY(process.start({.program = "true"}));
+		QVERIFY(finishedSpy.wait(1000));
+	}
+}
+
+// Baseline for benchSpawn.
+void TestProcess::benchSpawnQProcess() {
+	QBENCHMARK {
+		auto process = QProcess();
+		process.setStandardInputFile(QProcess::nullDevice());
+		process.setStandardOutputFile(QProcess::nullDevice());
+		process.setStandardErrorFile(QProcess::nullDevice());
+
+		auto finishedSpy = QSignalSpy(&process, &QProcess::finished);
+
+		process.start("true", {});
+		QVERIFY(finishedSpy.wait(1000));
+	}
+}
+
 QTEST_MAIN(TestProcess);
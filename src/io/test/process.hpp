@@ -9,4 +9,9 @@ class TestProcess: public QObject {
 private slots:
 	static void startAfterReload();
 	static void testExec();
+	static void readOutput();
+	static void coprocess();
+	static void coprocessRestart();
+	static void benchSpawn();
+	static void benchSpawnQProcess();
 };
@@ -0,0 +1,118 @@
+#include "stdiocollector.hpp"
+
+#include <qbytearray.h>
+#include <qobject.h>
+#include <qsignalspy.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtypes.h>
+#include <qvariant.h>
+
+#include "../datastream.hpp"
+
+void TestStdioCollector::truncation_data() {
+	QTest::addColumn<qint64>("maxBytes");
+	QTest::addColumn<StdioTruncation::Enum>("truncation");
+	QTest::addColumn<QByteArray>("expected");
+	QTest::addColumn<bool>("truncated");
+
+	QTest::addRow("unlimited") << qint64(0) << StdioTruncation::KeepHeadAndTail
+	                           << QByteArray("0123456789abcdefghij") << false;
+	QTest::addRow("under limit") << qint64(32) << StdioTruncation::KeepHeadAndTail
+	                             << QByteArray("0123456789abcdefghij") << false;
+	QTest::addRow("head") << qint64(8) << StdioTruncation::KeepHead << QByteArray("01234567")
+	                      << true;
+	QTest::addRow("tail") << qint64(8) << StdioTruncation::KeepTail << QByteArray("cdefghij")
+	                      << true;
+	QTest::addRow("head and tail") << qint64(8) << StdioTruncation::KeepHeadAndTail
+	                               << QByteArray("0123ghij") << true;
+}
+
+void TestStdioCollector::truncation() {
+	QFETCH(qint64, maxBytes);
+	QFETCH(StdioTruncation::Enum, truncation);
+	QFETCH(QByteArray, expected);
+	QFETCH(bool, truncated);
+
+	auto collector = StdioCollector();
+	collector.setMaxBytes(maxBytes);
+	collector.setTruncation(truncation);
+
+	auto buffer = QByteArray();
+
+	// Read in small chunks to exercise trimming of the tail.
+	auto input = QByteArray("0123456789abcdefghij");
+	for (auto i = 0; i < input.size(); i += 3) {
+		auto chunk = input.mid(i, 3);
+		collector.parseBytes(chunk, buffer);
+		QVERIFY(buffer.isEmpty());
+	}
+
+	QVERIFY(collector.data().isEmpty());
+
+	collector.streamEnded(buffer);
+	QCOMPARE(collector.data(), expected);
+	QCOMPARE(collector.truncated(), truncated);
+
+	// Capture restarts for the next stream.
+	auto next = QByteArray("next");
+	collector.parseBytes(next, buffer);
+	collector.streamEnded(buffer);
+	QCOMPARE(collector.data(), QByteArray("next"));
+	QVERIFY(!collector.truncated());
+}
+
+void TestStdioCollector::updateInterval() {
+	auto collector = StdioCollector();
+	collector.setWaitForEnd(false);
+	collector.setUpdateInterval(50);
+
+	auto spy = QSignalSpy(&collector, &StdioCollector::dataChanged);
+	auto buffer = QByteArray();
+
+	for (auto i = 0; i != 100; i++) {
+		auto chunk = QByteArray("x");
+		collector.parseBytes(chunk, buffer);
+	}
+
+	// The first read is reported immediately and the rest are combined.
+	QCOMPARE(spy.count(), 1);
+	QCOMPARE(collector.data().size(), qsizetype(100));
+
+	QTRY_COMPARE(spy.count(), 2);
+	QCOMPARE(collector.data().size(), qsizetype(100));
+
+	collector.streamEnded(buffer);
+	QCOMPARE(spy.count(), 3);
+}
+
+void TestStdioCollector::parseJson() {
+	auto collector = StdioCollector();
+	collector.setParseJson(true);
+
+	auto spy = QSignalSpy(&collector, &StdioCollector::jsonChanged);
+	auto buffer = QByteArray();
+	QCOMPARE(collector.json().typeId(), QMetaType::Nullptr);
+
+	auto chunk = QByteArray(R"({"a": [1, 2")");
+	collector.parseBytes(chunk, buffer);
+	chunk = QByteArray(R"(, 3], "b": "c"})");
+	collector.parseBytes(chunk, buffer);
+	collector.streamEnded(buffer);
+
+	QTRY_COMPARE(spy.count(), 1);
+	auto json = collector.json().toMap();
+	QCOMPARE(json.value("a").toList().length(), 3);
+	QCOMPARE(json.value("b"), QVariant("c"));
+	QVERIFY(collector.jsonError().isEmpty());
+
+	chunk = QByteArray("{");
+	collector.parseBytes(chunk, buffer);
+	collector.streamEnded(buffer);
+
+	QTRY_COMPARE(spy.count(), 2);
+	QCOMPARE(collector.json().typeId(), QMetaType::Nullptr);
+	QVERIFY(!collector.jsonError().isEmpty());
+}
+
+QTEST_MAIN(TestStdioCollector);
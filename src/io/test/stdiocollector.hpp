@@ -0,0 +1,14 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestStdioCollector: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void truncation_data();
+	static void truncation();
+	static void updateInterval();
+	static void parseJson();
+};
@@ -1,7 +1,14 @@
 #include "ipc.hpp"
+#include <array>
+#include <cerrno>
+#include <cstring>
 #include <functional>
 #include <variant>
 
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
 #include <qbuffer.h>
 #include <qlocalserver.h>
 #include <qlocalsocket.h>
@@ -12,6 +19,7 @@
 #include "../core/generation.hpp"
 #include "../core/logcat.hpp"
 #include "../core/paths.hpp"
+#include "../core/profiler.hpp"
 #include "ipccommand.hpp"
 
 namespace qs::ipc {
@@ -119,9 +127,80 @@ int IpcClient::connect(const QString& id, const std::function<void(IpcClient& cl
 	return 0;
 }
 
+IpcFastClient::IpcFastClient(const QString& path) {
+	auto encodedPath = path.toLocal8Bit();
+
+	sockaddr_un addr {};
+	addr.sun_family = AF_UNIX;
+	if (static_cast<size_t>(encodedPath.length()) >= sizeof(addr.sun_path)) return;
+	memcpy(addr.sun_path, encodedPath.constData(), encodedPath.length()); // NOLINT
+
+	this->fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (this->fd == -1) return;
+
+	// NOLINTNEXTLINE
+	if (::connect(this->fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1) {
+		close(this->fd);
+		this->fd = -1;
+	}
+}
+
+IpcFastClient::~IpcFastClient() {
+	if (this->fd != -1) close(this->fd);
+}
+
+bool IpcFastClient::writeAll(const QByteArray& data) {
+	if (this->fd == -1) return false;
+
+	qsizetype written = 0;
+	while (written < data.length()) {
+		// The fast path runs before SIGPIPE is ignored, so a peer that closed the connection
+		// must be reported as EPIPE instead of killing the process.
+		auto r = send(this->fd, data.constData() + written, data.length() - written, MSG_NOSIGNAL);
+
+		if (r == -1) {
+			if (errno == EINTR) continue;
+			// EPIPE included, the connection is no longer usable.
+			close(this->fd);
+			this->fd = -1;
+			return false;
+		}
+
+		written += r;
+	}
+
+	return true;
+}
+
+bool IpcFastClient::readMore() {
+	if (this->fd == -1) return false;
+
+	auto chunk = std::array<char, 4096>();
+
+	while (true) {
+		auto r = read(this->fd, chunk.data(), chunk.size());
+
+		if (r == -1 && errno == EINTR) continue;
+		if (r <= 0) return false;
+
+		this->buffer.append(chunk.data(), r);
+		return true;
+	}
+}
+
 void IpcKillCommand::exec(IpcServerConnection* /*unused*/) {
 	qInfo() << "Exiting due to IPC request.";
 	EngineGeneration::currentGeneration()->quit();
 }
 
+void IpcProfileCommand::exec(IpcServerConnection* conn) const {
+	auto* profiler = QsProfiler::instance();
+	auto response = IpcProfileResponse();
+
+	response.success =
+	    this->start ? profiler->start(&response.message) : profiler->stop(&response.message);
+
+	conn->respond(response);
+}
+
 } // namespace qs::ipc
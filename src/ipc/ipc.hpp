@@ -6,12 +6,15 @@
 #include <utility>
 #include <variant>
 
+#include <qbytearray.h>
+#include <qdatastream.h>
 #include <qflags.h>
 #include <qlocalserver.h>
 #include <qlocalsocket.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
+#include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
@@ -219,4 +222,42 @@ private slots:
 	static void onError(QLocalSocket::LocalSocketError error);
 };
 
+// Blocking client operating directly on a unix socket.
+// Unlike IpcClient this does not need a QCoreApplication or event dispatcher,
+// and is used by the `qs ipc` fast path. It does not log anything.
+class IpcFastClient {
+public:
+	explicit IpcFastClient(const QString& path);
+	~IpcFastClient();
+	Q_DISABLE_COPY_MOVE(IpcFastClient);
+
+	[[nodiscard]] bool isConnected() const { return this->fd != -1; }
+
+	template <typename T>
+	bool sendMessage(const T& message) {
+		auto data = QByteArray();
+		auto stream = QDataStream(&data, QIODevice::WriteOnly);
+		stream << message;
+		return this->writeAll(data);
+	}
+
+	template <typename T>
+	bool waitForResponse(T& slot) {
+		while (this->readMore()) {
+			auto stream = QDataStream(this->buffer);
+			stream >> slot;
+			if (stream.status() == QDataStream::Ok) return true;
+		}
+
+		return false;
+	}
+
+private:
+	bool writeAll(const QByteArray& data);
+	bool readMore();
+
+	int fd = -1;
+	QByteArray buffer;
+};
+
 } // namespace qs::ipc
@@ -2,6 +2,8 @@
 
 #include <variant>
 
+#include <qstring.h>
+
 #include "../io/ipccomm.hpp"
 #include "ipc.hpp"
 
@@ -11,11 +13,29 @@ struct IpcKillCommand: std::monostate {
 	static void exec(IpcServerConnection* /*unused*/);
 };
 
+// Starts or stops the instance's QsProfiler.
+struct IpcProfileCommand {
+	bool start = false;
+
+	void exec(IpcServerConnection* conn) const;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(IpcProfileCommand, data.start);
+
+struct IpcProfileResponse {
+	bool success = false;
+	// An error on failure, or the path of the written profile after stopping.
+	QString message;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(IpcProfileResponse, data.success, data.message);
+
 using IpcCommand = std::variant<
     std::monostate,
     IpcKillCommand,
     qs::io::ipc::comm::QueryMetadataCommand,
     qs::io::ipc::comm::StringCallCommand,
-    qs::io::ipc::comm::StringPropReadCommand>;
+    qs::io::ipc::comm::StringPropReadCommand,
+    IpcProfileCommand>;
 
 } // namespace qs::ipc
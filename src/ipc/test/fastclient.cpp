@@ -0,0 +1,69 @@
+#include "fastclient.hpp"
+
+#include <qdir.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qtest.h>
+#include <qtestcase.h>
+
+#include "../../io/ipccomm.hpp"
+#include "../ipc.hpp"
+
+using qs::io::ipc::comm::QuietCallResult;
+using qs::ipc::IpcFastClient;
+using qs::ipc::IpcServer;
+
+// The server runs on its own thread as the fast client blocks the calling thread.
+void TestIpcFastClient::initTestCase() {
+	QVERIFY(this->dir.isValid());
+
+	this->serverContext = new QObject();
+	this->serverContext->moveToThread(&this->serverThread);
+	this->serverThread.start();
+
+	auto path = this->dir.filePath("ipc.sock");
+	QMetaObject::invokeMethod(
+	    this->serverContext,
+	    [&]() { this->server = new IpcServer(path); },
+	    Qt::BlockingQueuedConnection
+	);
+}
+
+void TestIpcFastClient::cleanupTestCase() {
+	QMetaObject::invokeMethod(
+	    this->serverContext,
+	    [this]() {
+		    delete this->server;
+		    delete this->serverContext;
+	    },
+	    Qt::BlockingQueuedConnection
+	);
+
+	this->serverThread.quit();
+	this->serverThread.wait();
+}
+
+void TestIpcFastClient::noServer() {
+	auto client = IpcFastClient(this->dir.filePath("missing.sock"));
+	QVERIFY(!client.isConnected());
+}
+
+void TestIpcFastClient::roundTrip() {
+	auto client = IpcFastClient(this->dir.filePath("ipc.sock"));
+	QVERIFY(client.isConnected());
+
+	// No generation exists in the test, so the call must be rejected without side effects.
+	auto result = qs::io::ipc::comm::callFunctionQuiet(&client, "target", "function", {});
+	QCOMPARE(result, QuietCallResult::Rejected);
+}
+
+void TestIpcFastClient::benchRoundTrip() {
+	auto path = this->dir.filePath("ipc.sock");
+
+	QBENCHMARK {
+		auto client = IpcFastClient(path);
+		qs::io::ipc::comm::callFunctionQuiet(&client, "target", "function", {"arg"});
+	}
+}
+
+QTEST_MAIN(TestIpcFastClient);
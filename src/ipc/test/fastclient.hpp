@@ -0,0 +1,28 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtemporarydir.h>
+#include <qthread.h>
+#include <qtmetamacros.h>
+
+namespace qs::ipc {
+class IpcServer;
+}
+
+class TestIpcFastClient: public QObject {
+	Q_OBJECT;
+
+private slots:
+	void initTestCase();
+	void cleanupTestCase();
+
+	void noServer();
+	void roundTrip();
+	void benchRoundTrip();
+
+private:
+	QTemporaryDir dir;
+	QThread serverThread;
+	QObject* serverContext = nullptr;
+	qs::ipc::IpcServer* server = nullptr;
+};
@@ -0,0 +1,11 @@
+import Quickshell
+import Quickshell.Io
+
+// Configuration launched by the bench-ipc-call target.
+Scope {
+	IpcHandler {
+		target: "bench"
+
+		function noop(): void {}
+	}
+}
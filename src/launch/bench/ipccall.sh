@@ -0,0 +1,91 @@
+#!/bin/sh
+# Launches a config on the offscreen platform and reports percentiles of the wall time
+# of `qs ipc call` processes against it, with and without the fast IPC path.
+#
+# The full path is forced by passing an option the fast path does not handle, which
+# makes the call go through the normal command line parser and instance lookup.
+# Each sample includes starting `date` once, which is the same for both paths.
+#
+# usage: ipccall.sh <quickshell binary> <config path> [calls]
+#
+# Requires jq.
+
+set -eu
+
+if [ $# -lt 2 ]; then
+	echo "usage: $0 <quickshell binary> <config path> [calls]" >&2
+	exit 2
+fi
+
+qs="$1"
+config="$2"
+calls="${3:-100}"
+
+# Seconds to wait for the instance to start accepting calls.
+timeout=30
+
+tmp="$(mktemp -d)"
+pid=
+trap '[ -n "$pid" ] && kill "$pid" 2>/dev/null; rm -rf "$tmp"' EXIT
+
+export QT_QPA_PLATFORM=offscreen
+export QT_QUICK_BACKEND=software
+unset WAYLAND_DISPLAY DISPLAY
+
+mkdir -p "$tmp/runtime" "$tmp/cache" "$tmp/state" "$tmp/data"
+chmod 700 "$tmp/runtime"
+
+export XDG_RUNTIME_DIR="$tmp/runtime"
+export XDG_CACHE_HOME="$tmp/cache"
+export XDG_STATE_HOME="$tmp/state"
+export XDG_DATA_HOME="$tmp/data"
+
+"$qs" -p "$config" >"$tmp/log" 2>&1 &
+pid=$!
+
+deadline=$(($(date +%s) + timeout))
+
+until "$qs" ipc --pid "$pid" call bench noop >/dev/null 2>&1; do
+	if ! kill -0 "$pid" 2>/dev/null; then
+		echo "quickshell exited before accepting calls:" >&2
+		cat "$tmp/log" >&2
+		exit 1
+	fi
+
+	if [ "$(date +%s)" -ge "$deadline" ]; then
+		echo "quickshell did not accept calls within ${timeout}s:" >&2
+		cat "$tmp/log" >&2
+		exit 1
+	fi
+
+	sleep 0.05
+done
+
+# The fast path only resolves full instance ids.
+id="$("$qs" list --all --json | jq -r --argjson pid "$pid" '.[] | select(.pid == $pid) | .id')"
+
+if [ -z "$id" ]; then
+	echo "Could not find the id of instance $pid." >&2
+	exit 1
+fi
+
+i=0
+while [ "$i" -lt "$calls" ]; do
+	i=$((i + 1))
+
+	for mode in fast full; do
+		if [ "$mode" = fast ]; then
+			set -- ipc --id "$id" call bench noop
+		else
+			set -- ipc --id "$id" --no-color call bench noop
+		fi
+
+		start=$(date +%s%N)
+		"$qs" "$@" >/dev/null
+		end=$(date +%s%N)
+
+		printf '%s\t%s\n' "$mode" "$(((end - start) / 1000))" >>"$tmp/samples"
+	done
+done
+
+sh "$(dirname "$0")/percentiles.sh" "$tmp/samples" "path (us)"
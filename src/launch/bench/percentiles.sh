@@ -0,0 +1,29 @@
+#!/bin/sh
+# Prints min/p50/p90/p99/max of each key in a file of "key<TAB>value" samples,
+# in the order keys first appear.
+#
+# usage: percentiles.sh <samples file> <key header>
+
+set -eu
+
+samples="$1"
+
+printf '%-16s %10s %10s %10s %10s %10s\n' "$2" min p50 p90 p99 max
+
+cut -f1 "$samples" | awk '!seen[$0]++' | while IFS= read -r key; do
+	awk -F '\t' -v key="$key" '$1 == key { print $2 }' "$samples" | sort -n | awk -v key="$key" '
+		function percentile(p,   i) {
+			i = int(p / 100 * NR)
+			if (i < p / 100 * NR) i++
+			if (i < 1) i = 1
+			return v[i]
+		}
+
+		{ v[NR] = $1 }
+
+		END {
+			printf "%-16s %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+				key, v[1], percentile(50), percentile(90), percentile(99), v[NR]
+		}
+	'
+done
@@ -0,0 +1,55 @@
+import QtQuick
+import QtQuick.Layouts
+import Quickshell
+
+// Configuration launched by the bench-startup target.
+// A small bar on each screen, using only windows that work on any platform.
+Scope {
+	SystemClock {
+		id: clock
+		precision: SystemClock.Seconds
+	}
+
+	Variants {
+		model: Quickshell.screens
+
+		FloatingWindow {
+			required property var modelData
+			screen: modelData
+			implicitWidth: 1280
+			implicitHeight: 32
+			color: "#202020"
+
+			RowLayout {
+				anchors.fill: parent
+				anchors.margins: 4
+				spacing: 4
+
+				Repeater {
+					model: 10
+
+					Rectangle {
+						required property int index
+						Layout.preferredWidth: 24
+						Layout.fillHeight: true
+						radius: 4
+						color: index == 0 ? "#5080c0" : "#404040"
+
+						Text {
+							anchors.centerIn: parent
+							text: parent.index + 1
+							color: "white"
+						}
+					}
+				}
+
+				Item { Layout.fillWidth: true }
+
+				Text {
+					text: Qt.formatDateTime(clock.date, "hh:mm:ss")
+					color: "white"
+				}
+			}
+		}
+	}
+}
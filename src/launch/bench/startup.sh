@@ -0,0 +1,94 @@
+#!/bin/sh
+# Launches a config on the offscreen platform several times and reports percentiles
+# of each startup phase, as recorded in the instance's startup trace.
+#
+# Each launch gets empty runtime, cache, state and data directories, so every run is
+# a cold start of quickshell itself. System level caches such as the page cache and
+# fontconfig's cache are not cleared.
+#
+# usage: startup.sh <quickshell binary> <config path> [runs]
+#
+# Requires jq.
+
+set -eu
+
+if [ $# -lt 2 ]; then
+	echo "usage: $0 <quickshell binary> <config path> [runs]" >&2
+	exit 2
+fi
+
+qs="$1"
+config="$2"
+runs="${3:-20}"
+
+# Seconds to wait for each launch to load its configuration.
+timeout=30
+
+tmp="$(mktemp -d)"
+trap 'rm -rf "$tmp"' EXIT
+
+export QT_QPA_PLATFORM=offscreen
+export QT_QUICK_BACKEND=software
+unset WAYLAND_DISPLAY DISPLAY
+
+i=0
+while [ "$i" -lt "$runs" ]; do
+	i=$((i + 1))
+	run="$tmp/run-$i"
+	mkdir -p "$run/runtime" "$run/cache" "$run/state" "$run/data"
+	chmod 700 "$run/runtime"
+
+	export XDG_RUNTIME_DIR="$run/runtime"
+	export XDG_CACHE_HOME="$run/cache"
+	export XDG_STATE_HOME="$run/state"
+	export XDG_DATA_HOME="$run/data"
+
+	"$qs" -p "$config" >"$run/log" 2>&1 &
+	pid=$!
+
+	deadline=$(($(date +%s) + timeout))
+
+	# The trace can be read once the instance has started its IPC server and
+	# loaded its configuration.
+	until "$qs" startup --pid "$pid" --json >/dev/null 2>&1; do
+		if ! kill -0 "$pid" 2>/dev/null; then
+			echo "Run $i: quickshell exited before loading its configuration:" >&2
+			cat "$run/log" >&2
+			exit 1
+		fi
+
+		if [ "$(date +%s)" -ge "$deadline" ]; then
+			echo "Run $i: quickshell did not load its configuration within ${timeout}s:" >&2
+			kill "$pid"
+			cat "$run/log" >&2
+			exit 1
+		fi
+
+		sleep 0.05
+	done
+
+	# Bounded by qs startup itself, which fails if the trace does not complete in time.
+	if ! "$qs" startup --pid "$pid" --wait --json >"$run/trace" 2>"$run/trace-errors"; then
+		echo "Run $i: startup did not complete:" >&2
+		cat "$run/trace-errors" "$run/log" >&2
+		kill "$pid"
+		exit 1
+	fi
+
+	kill "$pid"
+	wait "$pid" || true
+
+	# Phase durations and the total, as "name<TAB>ms".
+	jq -r '
+		.phases as $phases
+		| (range(0; $phases | length) as $i
+			| $phases[$i]
+			| "\(.name)\t\(.time - (if $i == 0 then 0 else $phases[$i - 1].time end))"),
+		"total\t\(.total)"
+	' "$run/trace" >>"$tmp/samples"
+
+	echo "Run $i: $(jq -r .total "$run/trace") ms"
+done
+
+echo
+sh "$(dirname "$0")/percentiles.sh" "$tmp/samples" "phase (ms)"
@@ -10,8 +10,10 @@
 #include <qcoreapplication.h>
 #include <qcryptographichash.h>
 #include <qdatetime.h>
+#include <qdeadlinetimer.h>
 #include <qdebug.h>
 #include <qdir.h>
+#include <qfile.h>
 #include <qfileinfo.h>
 #include <qguiapplication.h>
 #include <qjsonarray.h>
@@ -23,14 +25,18 @@
 #include <qnamespace.h>
 #include <qstandardpaths.h>
 #include <qtenvironmentvariables.h>
+#include <qtextstream.h>
+#include <qthread.h>
 #include <qtversion.h>
 #include <unistd.h>
 
 #include "../core/instanceinfo.hpp"
 #include "../core/logging.hpp"
 #include "../core/paths.hpp"
+#include "../core/startuptrace.hpp"
 #include "../io/ipccomm.hpp"
 #include "../ipc/ipc.hpp"
+#include "../ipc/ipccommand.hpp"
 #include "build.hpp"
 #include "launch_p.hpp"
 
@@ -407,6 +413,8 @@ int ipcCommand(CommandState& cmd) {
 	auto r = selectInstance(cmd, &instance);
 	if (r != 0) return r;
 
+	cacheDefaultInstance(cmd, instance.instance.instanceId);
+
 	return IpcClient::connect(instance.instance.instanceId, [&](IpcClient& client) {
 		if (*cmd.ipc.show || cmd.ipc.showOld) {
 			return qs::io::ipc::comm::queryMetadata(&client, *cmd.ipc.target, *cmd.ipc.name);
@@ -425,6 +433,110 @@ int ipcCommand(CommandState& cmd) {
 	});
 }
 
+int profileInstance(CommandState& cmd) {
+	InstanceLockInfo instance;
+	auto r = selectInstance(cmd, &instance);
+	if (r != 0) return r;
+
+	auto ret = 0;
+
+	r = IpcClient::connect(instance.instance.instanceId, [&](IpcClient& client) {
+		auto start = static_cast<bool>(*cmd.profile.start);
+		client.sendMessage(qs::ipc::IpcCommand(qs::ipc::IpcProfileCommand {.start = start}));
+
+		auto response = qs::ipc::IpcProfileResponse();
+		if (!client.waitForResponse(response)) {
+			ret = -1;
+		} else if (!response.success) {
+			qCCritical(logBare).noquote() << response.message;
+			ret = -1;
+		} else if (start) {
+			qCInfo(logBare).noquote() << "Started profiling" << instance.instance.instanceId;
+		} else {
+			qCInfo(logBare).noquote() << "Saved profile to" << response.message;
+		}
+	});
+
+	return r != 0 ? r : ret;
+}
+
+int printStartupTrace(CommandState& cmd) {
+	InstanceLockInfo instance;
+	auto r = selectInstance(cmd, &instance, true);
+	if (r != 0) return r;
+
+	const auto& id = instance.instance.instanceId;
+	auto path = QDir(QsPaths::basePath(id)).filePath("startup.json");
+	auto deadline = QDeadlineTimer(30000);
+	auto trace = QJsonObject();
+
+	while (true) {
+		auto file = QFile(path);
+		if (file.open(QFile::ReadOnly)) trace = QJsonDocument::fromJson(file.readAll()).object();
+
+		if (!cmd.startup.wait || trace.value("complete").toBool()) break;
+
+		if (deadline.hasExpired()) {
+			qCCritical(logBare).noquote() << "Timed out waiting for" << id << "to finish starting.";
+			return -1;
+		}
+
+		QThread::msleep(50);
+	}
+
+	if (trace.isEmpty()) {
+		qCCritical(logBare).noquote() << "No startup trace found for" << id;
+		qCInfo(logBare) << "The trace is written once the configuration has loaded.";
+		return -1;
+	}
+
+	if (cmd.output.json) {
+		QTextStream(stdout) << QJsonDocument(trace).toJson(QJsonDocument::Indented);
+		return 0;
+	}
+
+	auto formatMs = [](double ms, bool sign = false) {
+		return QString("%1").arg((sign ? "+" : "") + QString::number(ms, 'f', 3), 10);
+	};
+
+	qCInfo(logBare).noquote().nospace()
+	    << "Startup trace for instance " << id
+	    << (trace.value("complete").toBool() ? ":" : " (incomplete):");
+
+	qCInfo(logBare).noquote() << "      time       delta  phase";
+
+	auto last = 0.0;
+	for (const auto& value: trace.value("phases").toArray()) {
+		auto phase = value.toObject();
+		auto time = phase.value("time").toDouble();
+
+		qCInfo(logBare).noquote() << formatMs(time) << formatMs(time - last, true) << ""
+		                          << phase.value("name").toString();
+
+		last = time;
+	}
+
+	auto windows = trace.value("windows").toArray();
+
+	if (!windows.isEmpty()) {
+		qCInfo(logBare).noquote() << "\nFirst frames:";
+
+		for (const auto& value: windows) {
+			auto window = value.toObject();
+			auto firstFrame = window.value("firstFrame");
+
+			qCInfo(logBare).noquote() << (firstFrame.isNull() ? QString("%1").arg("not drawn", 10)
+			                                                  : formatMs(firstFrame.toDouble()))
+			                          << "" << window.value("name").toString();
+		}
+	}
+
+	qCInfo(logBare).noquote() << "\nTotal:" << QString::number(trace.value("total").toDouble(), 'f', 3)
+	                          << "ms";
+
+	return 0;
+}
+
 int launchFromCommand(CommandState& cmd, QCoreApplication* coreApplication) {
 	QString configPath;
 
@@ -513,6 +625,8 @@ int runCommand(int argc, char** argv, QCoreApplication* coreApplication) {
 		    *state.log.rules,
 		    *state.subcommand.log ? "READER" : ""
 		);
+
+		StartupTrace::mark("logging");
 	}
 
 	if (state.misc.printVersion) {
@@ -539,6 +653,10 @@ int runCommand(int argc, char** argv, QCoreApplication* coreApplication) {
 		return killInstances(state);
 	} else if (*state.subcommand.msg || *state.ipc.ipc) {
 		return ipcCommand(state);
+	} else if (*state.subcommand.profile) {
+		return profileInstance(state);
+	} else if (*state.subcommand.startup) {
+		return printStartupTrace(state);
 	} else {
 		if (strcmp(qVersion(), QT_VERSION_STR) != 0) {
 			qWarning() << "\033[31mQuickshell was built against Qt" << QT_VERSION_STR
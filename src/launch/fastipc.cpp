@@ -0,0 +1,163 @@
+#include <cstdio>
+#include <optional>
+#include <string_view>
+
+#include <qcontainerfwd.h>
+#include <qcryptographichash.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qlist.h>
+#include <qstring.h>
+#include <qtenvironmentvariables.h>
+#include <qtextstream.h>
+#include <unistd.h>
+
+#include "../core/paths.hpp"
+#include "../io/ipccomm.hpp"
+#include "../ipc/ipc.hpp"
+#include "launch_p.hpp"
+
+// The fast path runs before the application or logging are set up, so nothing
+// in this file may log through Qt. Anything unexpected falls back to the full
+// command path, which will report errors properly.
+
+namespace qs::launch {
+
+using qs::io::ipc::comm::QuietCallResult;
+using qs::ipc::IpcFastClient;
+
+namespace {
+
+QString baseRunPath() {
+	// QsPaths is not used as it logs and creates directories.
+	auto runtimeDir = qEnvironmentVariable("XDG_RUNTIME_DIR");
+	if (runtimeDir.isEmpty()) return QString();
+	return QDir(runtimeDir).filePath("quickshell");
+}
+
+// Instance selection without an explicit instance depends on the display connection
+// and the config selected by the environment, so the cached pointer is keyed by them.
+QString defaultInstanceLinkPath(const QString& basePath) {
+	if (basePath.isEmpty()) return QString();
+
+	auto display = getDisplayConnection();
+	if (display.startsWith("unk,")) return QString();
+
+	auto configPath = qEnvironmentVariable("QS_CONFIG_PATH");
+
+	auto key = QStringList {
+	    display,
+	    configPath,
+	    qEnvironmentVariable("QS_CONFIG_NAME"),
+	    qEnvironmentVariable("QS_MANIFEST"),
+	    qEnvironmentVariable("XDG_CONFIG_HOME"),
+	    qEnvironmentVariable("XDG_CONFIG_DIRS"),
+	};
+
+	if (!configPath.isEmpty() && QDir::isRelativePath(configPath)) {
+		key.append(QDir::currentPath());
+	}
+
+	auto keyHash = QCryptographicHash::hash(key.join('\n').toUtf8(), QCryptographicHash::Md5).toHex();
+	return QDir(QDir(basePath).filePath("ipc-default")).filePath(keyHash);
+}
+
+} // namespace
+
+std::optional<int> runFastIpcCommand(int argc, char** argv) {
+	if (argc < 4) return std::nullopt;
+
+	auto subcommand = std::string_view(argv[1]); // NOLINT
+	auto isIpc = subcommand == "ipc";
+	if (!isIpc && subcommand != "msg") return std::nullopt;
+
+	QString id;
+	auto i = 2;
+
+	for (; i < argc; i++) {
+		auto arg = std::string_view(argv[i]); // NOLINT
+
+		if ((arg == "-i" || arg == "--id") && i + 1 < argc) {
+			id = QString::fromUtf8(argv[++i]); // NOLINT
+		} else if (arg.starts_with("--id=")) {
+			id = QString::fromUtf8(argv[i] + 5); // NOLINT
+		} else {
+			break;
+		}
+	}
+
+	if (isIpc) {
+		if (i >= argc || std::string_view(argv[i]) != "call") return std::nullopt; // NOLINT
+		i++;
+	}
+
+	QVector<QString> positionals;
+	for (; i < argc; i++) {
+		// Options are left to the full command parser.
+		if (argv[i][0] == '-') return std::nullopt; // NOLINT
+		positionals.append(QString::fromUtf8(argv[i])); // NOLINT
+	}
+
+	if (positionals.length() < 2) return std::nullopt;
+
+	auto basePath = baseRunPath();
+	if (basePath.isEmpty()) return std::nullopt;
+
+	QString socketPath;
+	if (!id.isEmpty()) {
+		// Only a full instance id can be resolved without enumerating instances.
+		if (id.contains('/')) return std::nullopt;
+		socketPath = QDir(QDir(QDir(basePath).filePath("by-id")).filePath(id)).filePath("ipc.sock");
+	} else {
+		socketPath = defaultInstanceLinkPath(basePath);
+		if (socketPath.isEmpty()) return std::nullopt;
+	}
+
+	// Stale pointers and dead instances fail to connect here.
+	auto client = IpcFastClient(socketPath);
+	if (!client.isConnected()) return std::nullopt;
+
+	auto target = positionals.takeFirst();
+	auto function = positionals.takeFirst();
+
+	switch (qs::io::ipc::comm::callFunctionQuiet(&client, target, function, positionals)) {
+	case QuietCallResult::Completed: return 0;
+	case QuietCallResult::Rejected: return std::nullopt;
+	case QuietCallResult::Failed:
+		QTextStream(stderr) << "Error occurred while waiting for response.\n";
+		return -1;
+	}
+
+	return std::nullopt;
+}
+
+void cacheDefaultInstance(CommandState& cmd, const QString& instanceId) {
+	if (!cmd.instance.id->isEmpty() || cmd.instance.pid != -1) return;
+	if (cmd.config.newest || cmd.config.anyDisplay) return;
+
+	// Config selection from the command line is not part of the key.
+	if (*cmd.config.path != qEnvironmentVariable("QS_CONFIG_PATH")) return;
+	if (*cmd.config.name != qEnvironmentVariable("QS_CONFIG_NAME")) return;
+	if (*cmd.config.manifest != qEnvironmentVariable("QS_MANIFEST")) return;
+
+	auto linkPath = defaultInstanceLinkPath(baseRunPath());
+	if (linkPath.isEmpty()) return;
+
+	auto target = QsPaths::ipcPath(instanceId);
+	if (QFileInfo(linkPath).symLinkTarget() == target) return;
+
+	if (!QDir(QFileInfo(linkPath).path()).mkpath(".")) return;
+
+	// Replaced atomically as fast path clients may be reading it concurrently.
+	auto tmpPath = linkPath + ".tmp" + QString::number(getpid());
+	QFile::remove(tmpPath);
+
+	if (symlink(target.toLocal8Bit().constData(), tmpPath.toLocal8Bit().constData()) != 0) return;
+
+	if (rename(tmpPath.toLocal8Bit().constData(), linkPath.toLocal8Bit().constData()) != 0) {
+		QFile::remove(tmpPath);
+	}
+}
+
+} // namespace qs::launch
@@ -23,6 +23,7 @@
 #include "../core/paths.hpp"
 #include "../core/plugin.hpp"
 #include "../core/rootwrapper.hpp"
+#include "../core/startuptrace.hpp"
 #include "../ipc/ipc.hpp"
 #include "build.hpp"
 #include "launch_p.hpp"
@@ -120,6 +121,7 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 	}
 
 	file.close();
+	StartupTrace::mark("pragmas");
 
 	if (!pragmas.iconTheme.isEmpty()) {
 		QIcon::setThemeName(pragmas.iconTheme);
@@ -158,6 +160,7 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 	QsPaths::instance()->linkRunDir();
 	QsPaths::instance()->linkPathDir();
 	LogManager::initFs();
+	StartupTrace::mark("paths");
 
 	Common::INITIAL_ENVIRONMENT = QProcessEnvironment::systemEnvironment();
 
@@ -231,6 +234,7 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 	}
 
 	QGuiApplication::setDesktopFileName("org.quickshell");
+	StartupTrace::mark("application");
 
 	if (args.debugPort != -1) {
 		QQmlDebuggingEnabler::enableDebugging(true);
@@ -240,6 +244,7 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 	}
 
 	QsEnginePlugin::initPlugins();
+	StartupTrace::mark("plugins");
 
 	// Base window transparency appears to be additive.
 	// Use a fully transparent window with a colored rect.
@@ -251,6 +256,7 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 
 	qs::ipc::IpcServer::start();
 	QsPaths::instance()->createLock();
+	StartupTrace::mark("ipc");
 
 	auto root = RootWrapper(args.configPath, shellId);
 	QGuiApplication::setQuitOnLastWindowClosed(false);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include <CLI/App.hpp>
@@ -80,11 +81,22 @@ struct CommandState {
 		std::vector<QStringOption> arguments;
 	} ipc;
 
+	struct {
+		CLI::App* start = nullptr;
+		CLI::App* stop = nullptr;
+	} profile;
+
+	struct {
+		bool wait = false;
+	} startup;
+
 	struct {
 		CLI::App* log = nullptr;
 		CLI::App* list = nullptr;
 		CLI::App* kill = nullptr;
 		CLI::App* msg = nullptr;
+		CLI::App* profile = nullptr;
+		CLI::App* startup = nullptr;
 	} subcommand;
 
 	struct {
@@ -107,6 +119,12 @@ void exitDaemon(int code);
 int parseCommand(int argc, char** argv, CommandState& state);
 int runCommand(int argc, char** argv, QCoreApplication* coreApplication);
 
+// Runs `ipc call` and `msg` without constructing an application if the target instance
+// can be found without enumerating instances. Returns nullopt if not handled, in which
+// case the command should be run normally.
+std::optional<int> runFastIpcCommand(int argc, char** argv);
+void cacheDefaultInstance(CommandState& cmd, const QString& instanceId);
+
 QString getDisplayConnection();
 
 int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplication);
@@ -13,6 +13,7 @@
 #include "../core/instanceinfo.hpp"
 #include "../core/logging.hpp"
 #include "../core/paths.hpp"
+#include "../core/startuptrace.hpp"
 #include "build.hpp"
 #include "launch_p.hpp"
 
@@ -102,12 +103,16 @@ void exitDaemon(int code) {
 }
 
 int main(int argc, char** argv) {
+	StartupTrace::mark("main");
 	QCoreApplication::setApplicationName("quickshell");
 
 #if CRASH_REPORTER
 	qsCheckCrash(argc, argv);
 #endif
 
+	// Application construction dominates the runtime of a single ipc call.
+	if (auto code = runFastIpcCommand(argc, argv)) return *code;
+
 	auto qArgC = 1;
 	auto* coreApplication = new QCoreApplication(qArgC, argv);
 
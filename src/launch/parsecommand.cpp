@@ -239,6 +239,43 @@ int parseCommand(int argc, char** argv, CommandState& state) {
 		}
 	}
 
+	{
+		auto* sub = cli->add_subcommand("profile", "Profile a running quickshell instance.")
+		                ->require_subcommand();
+
+		auto* instance = addInstanceSelection(sub);
+		addConfigSelection(sub, true)->excludes(instance);
+		addLoggingOptions(sub, false, true);
+
+		state.profile.start = sub->add_subcommand("start", "Start recording a profile.");
+
+		state.profile.stop = sub->add_subcommand("stop")->description(
+		    "Stop recording and save the profile to the instance's runtime directory.\n"
+		    "A flamegraph compatible `profile.folded` and a `profile.txt` summary are written."
+		);
+
+		state.subcommand.profile = sub;
+	}
+
+	{
+		auto* sub = cli->add_subcommand("startup")->description(
+		    "Print how long an instance took to start.\n"
+		    "Shows the time each startup phase completed at, and when each window "
+		    "shown during startup drew its first frame."
+		);
+
+		sub->add_flag("-j,--json", state.output.json, "Print the trace as json.");
+
+		sub->add_flag("-w,--wait", state.startup.wait)
+		    ->description("Wait until every window shown during startup has drawn.");
+
+		auto* instance = addInstanceSelection(sub);
+		addConfigSelection(sub, true)->excludes(instance);
+		addLoggingOptions(sub, false, true);
+
+		state.subcommand.startup = sub;
+	}
+
 	{
 		auto* sub = cli->add_subcommand("msg", "[DEPRECATED] Moved to `ipc call`.")->require_option();
 
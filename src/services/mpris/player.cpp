@@ -1,13 +1,13 @@
 #include "player.hpp"
 
 #include <qcontainerfwd.h>
-#include <qdatetime.h>
 #include <qdbusconnection.h>
 #include <qdbuserror.h>
 #include <qdbusextratypes.h>
 #include <qlist.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
+#include <qmetaobject.h>
 #include <qobject.h>
 #include <qproperty.h>
 #include <qstring.h>
@@ -28,6 +28,68 @@ namespace {
 QS_LOGGING_CATEGORY(logMprisPlayer, "quickshell.service.mp.player", QtWarningMsg);
 }
 
+MprisPositionClock::MprisPositionClock() {
+	this->clock.start();
+	QObject::connect(&this->timer, &QTimer::timeout, this, &MprisPositionClock::onTick);
+}
+
+MprisPositionClock* MprisPositionClock::instance() {
+	static auto* instance = new MprisPositionClock(); // NOLINT
+	return instance;
+}
+
+void MprisPositionClock::setActive(MprisPlayer* player, bool active) {
+	if (active) {
+		if (this->players.contains(player)) return;
+		this->players.insert(player);
+
+		QObject::connect(
+		    player,
+		    &QObject::destroyed,
+		    this,
+		    &MprisPositionClock::onPlayerDestroyed,
+		    Qt::UniqueConnection
+		);
+	} else {
+		if (!this->players.remove(player)) return;
+		QObject::disconnect(player, nullptr, this, nullptr);
+	}
+
+	this->updateTimer();
+}
+
+void MprisPositionClock::setInterval(qint32 interval) {
+	if (interval < 0) interval = 0;
+	if (interval == this->mInterval) return;
+
+	this->mInterval = interval;
+	this->updateTimer();
+	emit this->intervalChanged();
+}
+
+void MprisPositionClock::updateTimer() {
+	if (this->players.isEmpty() || this->mInterval == 0) {
+		this->timer.stop();
+	} else if (!this->timer.isActive() || this->timer.interval() != this->mInterval) {
+		this->timer.start(this->mInterval);
+	}
+}
+
+void MprisPositionClock::onTick() {
+	// players may deactivate in response to the signal
+	auto players = this->players;
+
+	for (auto* player: players) {
+		emit player->positionChanged();
+	}
+}
+
+void MprisPositionClock::onPlayerDestroyed(QObject* object) {
+	// NOLINTNEXTLINE (the player is only used as a key)
+	this->players.remove(static_cast<MprisPlayer*>(object));
+	this->updateTimer();
+}
+
 QString MprisPlaybackState::toString(MprisPlaybackState::Enum status) {
 	switch (status) {
 	case MprisPlaybackState::Stopped: return "Stopped";
@@ -114,6 +176,9 @@ MprisPlayer::MprisPlayer(const QString& address, QObject* parent): QObject(paren
 	QObject::connect(this, &MprisPlayer::positionChanged, this, &MprisPlayer::onExportedPositionChanged);
 	// clang-format on
 
+	// The internal connection above should not count as the position being in use.
+	this->positionReceivers = 0;
+
 	this->appProperties.setInterface(this->app);
 	this->playerProperties.setInterface(this->player);
 	this->appProperties.updateAllViaGetAll();
@@ -176,12 +241,12 @@ qlonglong MprisPlayer::positionMs() const {
 	if (this->bPlaybackState == MprisPlaybackState::Stopped) return 0;
 
 	auto paused = this->bPlaybackState == MprisPlaybackState::Paused;
-	auto time = paused ? this->pausedTime : QDateTime::currentDateTime();
+	auto time = paused ? this->pausedTime : MprisPositionClock::instance()->now();
 	auto offset = time - this->lastPositionTimestamp;
-	auto rateMul = static_cast<qlonglong>(this->bRate.value() * 1000);
+	auto rateMul = static_cast<qlonglong>(this->positionRate * 1000);
 	offset = (offset * rateMul) / 1000;
 
-	return (this->bpPosition.value() / 1000) + offset.count();
+	return (this->bpPosition.value() / 1000) + offset;
 }
 
 qreal MprisPlayer::position() const {
@@ -217,11 +282,48 @@ void MprisPlayer::setPosition(qreal position) {
 }
 
 void MprisPlayer::onPositionUpdated() {
-	const bool firstChange = !this->lastPositionTimestamp.isValid();
-	this->lastPositionTimestamp = QDateTime::currentDateTimeUtc();
+	const bool firstChange = this->lastPositionTimestamp == -1;
+	this->lastPositionTimestamp = MprisPositionClock::instance()->now();
 	this->pausedTime = this->lastPositionTimestamp;
+	this->positionRate = this->bRate.value();
 	emit this->positionChanged();
-	if (firstChange) emit this->positionSupportedChanged();
+
+	if (firstChange) {
+		emit this->positionSupportedChanged();
+		this->updatePositionClock();
+	}
+}
+
+void MprisPlayer::onRateChanged() {
+	if (this->lastPositionTimestamp == -1) return;
+
+	// Rebase the interpolated position onto the new rate, then resync with the player.
+	auto position = this->positionMs();
+	this->lastPositionTimestamp = MprisPositionClock::instance()->now();
+	this->pausedTime = this->lastPositionTimestamp;
+	this->positionRate = this->bRate.value();
+	this->bpPosition = position * 1000;
+
+	this->pPosition.requestUpdate();
+}
+
+void MprisPlayer::connectNotify(const QMetaMethod& signal) {
+	if (signal == QMetaMethod::fromSignal(&MprisPlayer::positionChanged)) {
+		this->positionReceivers++;
+		this->updatePositionClock();
+	}
+}
+
+void MprisPlayer::disconnectNotify(const QMetaMethod& signal) {
+	if (signal == QMetaMethod::fromSignal(&MprisPlayer::positionChanged)) {
+		if (this->positionReceivers > 0) this->positionReceivers--;
+		this->updatePositionClock();
+	}
+}
+
+void MprisPlayer::updatePositionClock() {
+	auto active = this->positionReceivers > 0 && this->bIsPlaying && this->positionSupported();
+	MprisPositionClock::instance()->setActive(this, active);
 }
 
 void MprisPlayer::setPosition(qlonglong position) {
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <qcontainerfwd.h>
+#include <qelapsedtimer.h>
 #include <qobject.h>
 #include <qproperty.h>
 #include <qqmlintegration.h>
+#include <qset.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
@@ -15,6 +18,42 @@
 
 namespace qs::service::mpris {
 
+class MprisPlayer;
+
+// Shared monotonic clock which drives reactive position updates for every player
+// that is playing and has its position bound.
+class MprisPositionClock: public QObject {
+	Q_OBJECT;
+
+public:
+	static MprisPositionClock* instance();
+
+	// Monotonic time in milliseconds.
+	[[nodiscard]] qint64 now() const { return this->clock.elapsed(); }
+
+	void setActive(MprisPlayer* player, bool active);
+
+	[[nodiscard]] qint32 interval() const { return this->mInterval; }
+	void setInterval(qint32 interval);
+
+signals:
+	void intervalChanged();
+
+private slots:
+	void onTick();
+	void onPlayerDestroyed(QObject* object);
+
+private:
+	explicit MprisPositionClock();
+
+	void updateTimer();
+
+	QElapsedTimer clock;
+	QTimer timer;
+	QSet<MprisPlayer*> players;
+	qint32 mInterval = 1000;
+};
+
 ///! Playback state of an MprisPlayer
 /// See @@MprisPlayer.playbackState.
 class MprisPlaybackState: public QObject {
@@ -108,13 +147,15 @@ class MprisPlayer: public QObject {
 	///
 	/// May only be written to if @@canSeek and @@positionSupported are true.
 	///
-	/// > [!WARNING] To avoid excessive property updates wasting CPU while `position` is not
-	/// > actively monitored, `position` usually will not update reactively, unless a nonlinear
-	/// > change in position occurs, however reading it will always return the current position.
-	/// >
-	/// > If you want to actively monitor the position, the simplest way it to emit the @@positionChanged(s)
-	/// > signal manually for the duration you are monitoring it, Using a @@QtQuick.FrameAnimation if you need
-	/// > the value to update smoothly, such as on a slider, or a @@QtQuick.Timer if not, as shown below.
+	/// While the player is playing and `position` is in use by a binding or signal handler,
+	/// it updates reactively every @@Mpris.positionUpdateInterval milliseconds. The position
+	/// is interpolated locally and is only resynchronized with the player when it seeks,
+	/// changes rate, changes track or changes playback state.
+	///
+	/// > [!INFO] Reading `position` will always return the current position, even between updates.
+	/// > If you need the value to update smoothly, such as on a slider, either lower
+	/// > @@Mpris.positionUpdateInterval or emit the @@positionChanged(s) signal manually
+	/// > using a @@QtQuick.FrameAnimation, as shown below.
 	/// >
 	/// > ```qml {filename="Using a FrameAnimation"}
 	/// > FrameAnimation {
@@ -124,18 +165,6 @@ class MprisPlayer: public QObject {
 	/// >   onTriggered: player.positionChanged()
 	/// > }
 	/// > ```
-	/// >
-	/// > ```qml {filename="Using a Timer"}
-	/// > Timer {
-	/// >   // only emit the signal when the position is actually changing.
-	/// >   running: player.playbackState == MprisPlaybackState.Playing
-	/// >   // Make sure the position updates at least once per second.
-	/// >   interval: 1000
-	/// >   repeat: true
-	/// >   // emit the positionChanged signal every second.
-	/// >   onTriggered: player.positionChanged()
-	/// > }
-	/// > ```
 	Q_PROPERTY(qreal position READ position WRITE setPosition NOTIFY positionChanged);
 	Q_PROPERTY(bool positionSupported READ positionSupported NOTIFY positionSupportedChanged);
 	/// The length of the playing track, as seconds, with millisecond precision,
@@ -403,6 +432,10 @@ signals:
 	void supportedUriSchemesChanged();
 	void supportedMimeTypesChanged();
 
+protected:
+	void connectNotify(const QMetaMethod& signal) override;
+	void disconnectNotify(const QMetaMethod& signal) override;
+
 private slots:
 	void onGetAllFinished();
 	void onExportedPositionChanged();
@@ -412,6 +445,8 @@ private:
 	void onMetadataChanged();
 	void onPositionUpdated();
 	void onPlaybackStatusUpdated();
+	void onRateChanged();
+	void updatePositionClock();
 	// call instead of setting bpPosition
 	void setPosition(qlonglong position);
 	void requestPositionUpdate() { this->pPosition.requestUpdate(); }
@@ -456,8 +491,10 @@ private:
 	Q_OBJECT_BINDABLE_PROPERTY(MprisPlayer, MprisPlaybackState::Enum, bPlaybackState, &MprisPlayer::playbackStateChanged);
 	Q_OBJECT_BINDABLE_PROPERTY(MprisPlayer, bool, bIsPlaying, &MprisPlayer::isPlayingChanged);
 	QS_BINDING_SUBSCRIBE_METHOD(MprisPlayer, bPlaybackState, requestPositionUpdate, onValueChanged);
+	QS_BINDING_SUBSCRIBE_METHOD(MprisPlayer, bIsPlaying, updatePositionClock, onValueChanged);
 	Q_OBJECT_BINDABLE_PROPERTY(MprisPlayer, MprisLoopState::Enum, bLoopState, &MprisPlayer::loopStateChanged);
 	Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(MprisPlayer, qreal, bRate, 1, &MprisPlayer::rateChanged);
+	QS_BINDING_SUBSCRIBE_METHOD(MprisPlayer, bRate, onRateChanged, onValueChanged);
 	Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(MprisPlayer, qreal, bMinRate, 1, &MprisPlayer::minRateChanged);
 	Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(MprisPlayer, qreal, bMaxRate, 1, &MprisPlayer::maxRateChanged);
 
@@ -490,8 +527,12 @@ private:
 	QS_DBUS_PROPERTY_BINDING(MprisPlayer, pShuffle, bShuffle, playerProperties, "Shuffle", false);
 	// clang-format on
 
-	QDateTime lastPositionTimestamp;
-	QDateTime pausedTime;
+	// monotonic timestamps from MprisPositionClock, -1 if position has never been received
+	qint64 lastPositionTimestamp = -1;
+	qint64 pausedTime = -1;
+	// rate the position is interpolated with since lastPositionTimestamp
+	qreal positionRate = 1;
+	qsizetype positionReceivers = 0;
 
 	DBusMprisPlayerApp* app = nullptr;
 	DBusMprisPlayer* player = nullptr;
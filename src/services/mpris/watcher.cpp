@@ -110,8 +110,25 @@ MprisWatcher* MprisWatcher::instance() {
 	return instance;
 }
 
+MprisQml::MprisQml(QObject* parent): QObject(parent) {
+	QObject::connect(
+	    MprisPositionClock::instance(),
+	    &MprisPositionClock::intervalChanged,
+	    this,
+	    &MprisQml::positionUpdateIntervalChanged
+	);
+}
+
 ObjectModel<MprisPlayer>* MprisQml::players() { // NOLINT
 	return MprisWatcher::instance()->players();
 }
 
+qint32 MprisQml::positionUpdateInterval() const { // NOLINT
+	return MprisPositionClock::instance()->interval();
+}
+
+void MprisQml::setPositionUpdateInterval(qint32 interval) { // NOLINT
+	MprisPositionClock::instance()->setInterval(interval);
+}
+
 } // namespace qs::service::mpris
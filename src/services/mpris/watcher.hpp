@@ -49,11 +49,22 @@ class MprisQml: public QObject {
 	/// All connected MPRIS players.
 	QSDOC_TYPE_OVERRIDE(ObjectModel<qs::service::mpris::MprisPlayer>*);
 	Q_PROPERTY(UntypedObjectModel* players READ players CONSTANT);
+	/// Interval in milliseconds at which @@MprisPlayer.position updates reactively while
+	/// a player is playing and its position is in use. Shared by all players.
+	///
+	/// Defaults to 1000. Setting it to 0 disables reactive position updates.
+	Q_PROPERTY(qint32 positionUpdateInterval READ positionUpdateInterval WRITE setPositionUpdateInterval NOTIFY positionUpdateIntervalChanged);
 
 public:
-	explicit MprisQml(QObject* parent = nullptr): QObject(parent) {}
+	explicit MprisQml(QObject* parent = nullptr);
 
 	[[nodiscard]] ObjectModel<MprisPlayer>* players();
+
+	[[nodiscard]] qint32 positionUpdateInterval() const;
+	void setPositionUpdateInterval(qint32 interval);
+
+signals:
+	void positionUpdateIntervalChanged();
 };
 
 } // namespace qs::service::mpris
@@ -1,12 +1,14 @@
 #include "dbusimage.hpp"
 
 #include <qdbusargument.h>
+#include <qhashfunctions.h>
 #include <qimage.h>
 #include <qloggingcategory.h>
 #include <qsize.h>
 #include <qsysinfo.h>
 #include <qtypes.h>
 
+#include "../../core/imagecache.hpp"
 #include "../../core/logcat.hpp"
 
 namespace qs::service::notifications {
@@ -16,15 +18,34 @@ QS_DECLARE_LOGGING_CATEGORY(logNotifications); // server.cpp
 
 QImage DBusNotificationImage::createImage() const {
 	auto format = this->hasAlpha ? QImage::Format_RGBA8888 : QImage::Format_RGB888;
+	auto bytesPerLine = this->width * (this->hasAlpha ? 4 : 3);
+
+	if (this->width <= 0 || this->height <= 0
+	    || this->data.size() < static_cast<qsizetype>(bytesPerLine) * this->height)
+	{
+		return QImage();
+	}
 
 	return QImage(
 	    reinterpret_cast<const uchar*>(this->data.data()),
 	    this->width,
 	    this->height,
+	    bytesPerLine,
 	    format
 	);
 }
 
+QImage DBusNotificationImage::toImage() const {
+	auto params = qHashMulti(0, this->width, this->height, this->hasAlpha);
+
+	return SharedImageCache::instance()->image(this->data, params, [this]() {
+		// Converting copies the image out of the dbus buffer.
+		return this->createImage().convertToFormat(
+		    this->hasAlpha ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32
+		);
+	});
+}
+
 const QDBusArgument& operator>>(const QDBusArgument& argument, DBusNotificationImage& pixmap) {
 	argument.beginStructure();
 	argument >> pixmap.width;
@@ -63,12 +84,18 @@ const QDBusArgument& operator<<(QDBusArgument& argument, const DBusNotificationI
 	return argument;
 }
 
+void NotificationImage::setImage(const QImage& image) {
+	// Identical images resent by the same sender keep the same url.
+	if (this->image.cacheKey() == image.cacheKey()) return;
+
+	this->image = image;
+	this->imageChanged();
+}
+
 QImage
 NotificationImage::requestImage(const QString& /*unused*/, QSize* size, const QSize& /*unused*/) {
-	auto image = this->image.createImage();
-
-	if (size != nullptr) *size = image.size();
-	return image;
+	if (size != nullptr) *size = this->image.size();
+	return this->image;
 }
 
 } // namespace qs::service::notifications
@@ -16,6 +16,10 @@ struct DBusNotificationImage {
 
 	// valid only for the lifetime of the pixmap
 	[[nodiscard]] QImage createImage() const;
+
+	// Returns a converted image with its own data, shared with identical images
+	// received by other notifications.
+	[[nodiscard]] QImage toImage() const;
 };
 
 const QDBusArgument& operator>>(const QDBusArgument& argument, DBusNotificationImage& pixmap);
@@ -25,18 +29,14 @@ class NotificationImage: public QsIndexedImageHandle {
 public:
 	explicit NotificationImage(): QsIndexedImageHandle(QQuickAsyncImageProvider::Image) {}
 
-	[[nodiscard]] bool hasData() const { return !this->image.data.isEmpty(); }
-	void clear() { this->image.data.clear(); }
-
-	[[nodiscard]] DBusNotificationImage& writeImage() {
-		this->imageChanged();
-		return this->image;
-	}
+	[[nodiscard]] bool hasData() const { return !this->image.isNull(); }
+	void clear() { this->image = QImage(); }
+	void setImage(const QImage& image);
 
 	QImage requestImage(const QString& id, QSize* size, const QSize& requestedSize) override;
 
 private:
-	DBusNotificationImage image;
+	QImage image;
 };
 
 } // namespace qs::service::notifications
@@ -144,8 +144,10 @@ void Notification::updateProperties(
 		this->mImagePixmap.clear();
 	} else {
 		auto value = hints.value(imageDataName).value<QDBusArgument>();
-		value >> this->mImagePixmap.writeImage();
-		imagePath = this->mImagePixmap.url();
+		auto image = DBusNotificationImage();
+		value >> image;
+		this->mImagePixmap.setImage(image.toImage());
+		if (this->mImagePixmap.hasData()) imagePath = this->mImagePixmap.url();
 	}
 
 	// don't store giant byte arrays longer than necessary
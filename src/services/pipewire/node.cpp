@@ -8,15 +8,18 @@
 #include <pipewire/keys.h>
 #include <pipewire/node.h>
 #include <qcontainerfwd.h>
+#include <qlatin1stringview.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
 #include <qstringliteral.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
+#include <spa/debug/types.h>
 #include <spa/node/keys.h>
 #include <spa/param/param.h>
 #include <spa/param/props.h>
+#include <spa/param/type-info.h>
 #include <spa/pod/builder.h>
 #include <spa/pod/iter.h>
 #include <spa/pod/pod.h>
@@ -27,6 +30,7 @@
 #include <spa/utils/type.h>
 
 #include "../../core/logcat.hpp"
+#include "../../core/profiler.hpp"
 #include "connection.hpp"
 #include "core.hpp"
 #include "device.hpp"
@@ -262,6 +266,15 @@ void PwNode::onParam(
     const spa_pod* param
 ) {
 	auto* self = static_cast<PwNode*>(data);
+
+	if (QsProfiler::instance()->isRunning()) {
+		auto* name = spa_debug_type_find_short_name(spa_type_param, id);
+		QsProfiler::countEvent(
+		    QLatin1StringView("pipewire"),
+		    QLatin1StringView(name ? name : "Unknown")
+		);
+	}
+
 	if (self->boundData != nullptr) {
 		self->boundData->onSpaParam(id, index, param);
 	}
@@ -1,11 +1,14 @@
 #include "item.hpp"
 
+#include <qcoreapplication.h>
 #include <qdbuserror.h>
 #include <qdbusextratypes.h>
 #include <qdbusmetatype.h>
 #include <qdbuspendingcall.h>
 #include <qdbuspendingreply.h>
+#include <qhashfunctions.h>
 #include <qicon.h>
+#include <qimage.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qnamespace.h>
@@ -17,10 +20,12 @@
 #include <qsize.h>
 #include <qstring.h>
 #include <qstringliteral.h>
+#include <qthreadpool.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
 #include "../../core/iconimageprovider.hpp"
+#include "../../core/imagecache.hpp"
 #include "../../core/imageprovider.hpp"
 #include "../../core/logcat.hpp"
 #include "../../core/platformmenu.hpp"
@@ -131,89 +136,222 @@ StatusNotifierItem::StatusNotifierItem(const QString& address, QObject* parent)
 bool StatusNotifierItem::isValid() const { return this->item->isValid(); }
 bool StatusNotifierItem::isReady() const { return this->mReady; }
 
-QPixmap StatusNotifierItem::createPixmap(const QSize& size) const {
-	auto needsAttention = this->bStatus.value() == Status::NeedsAttention;
+namespace {
 
-	auto closestPixmap = [](const QSize& size, const DBusSniIconPixmapList& pixmaps) {
-		const DBusSniIconPixmap* ret = nullptr;
+const DBusSniIconPixmap* closestPixmap(const QSize& size, const DBusSniIconPixmapList& pixmaps) {
+	const DBusSniIconPixmap* ret = nullptr;
 
-		for (const auto& pixmap: pixmaps) {
-			if (ret == nullptr) {
-				ret = &pixmap;
-				continue;
-			}
+	for (const auto& pixmap: pixmaps) {
+		if (ret == nullptr) {
+			ret = &pixmap;
+			continue;
+		}
 
-			auto existingAdequate = ret->width >= size.width() && ret->height >= size.height();
-			auto newAdequite = pixmap.width >= size.width() && pixmap.height >= size.height();
-			auto newSmaller = pixmap.width < ret->width || pixmap.height < ret->height;
+		auto existingAdequate = ret->width >= size.width() && ret->height >= size.height();
+		auto newAdequite = pixmap.width >= size.width() && pixmap.height >= size.height();
+		auto newSmaller = pixmap.width < ret->width || pixmap.height < ret->height;
 
-			if ((existingAdequate && newAdequite && newSmaller) || (!existingAdequate && !newSmaller)) {
-				ret = &pixmap;
-			}
+		if ((existingAdequate && newAdequite && newSmaller) || (!existingAdequate && !newSmaller)) {
+			ret = &pixmap;
 		}
+	}
 
-		return ret;
-	};
+	return ret;
+}
 
-	QPixmap pixmap;
+QImage scaledPixmapImage(const DBusSniIconPixmapList& pixmaps, const QSize& size) {
+	const auto* icon = closestPixmap(size, pixmaps);
+	if (icon == nullptr) return QImage();
+
+	// The decoded icon is shared by every size it is rendered at, and by other
+	// items sending the same icon.
+	auto image = SharedImageCache::instance()->image(
+	    icon->data,
+	    qHashMulti(0, icon->width, icon->height),
+	    [icon]() { return icon->createImage().convertToFormat(QImage::Format_ARGB32_Premultiplied); }
+	);
+
+	return image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
+
+qsizetype pixmapListBytes(const DBusSniIconPixmapList& pixmaps) {
+	qsizetype bytes = 0;
+	for (const auto& pixmap: pixmaps) {
+		bytes += pixmap.data.size();
+	}
+
+	return bytes;
+}
+
+} // namespace
+
+size_t qHash(const TrayPixmapKey& key, size_t seed) {
+	return qHashMulti(seed, key.status, key.size.width(), key.size.height(), key.iconHash);
+}
+
+// Safe to call from any thread.
+QImage StatusNotifierItem::renderRawIcon(
+    bool needsAttention,
+    const DBusSniIconPixmapList& iconPixmaps,
+    const DBusSniIconPixmapList& overlayIconPixmaps,
+    const DBusSniIconPixmapList& attentionIconPixmaps,
+    const QSize& size
+) {
 	if (needsAttention) {
-		if (!this->bAttentionIconName.value().isEmpty()) {
-			auto icon = QIcon::fromTheme(this->bAttentionIconName.value());
-			pixmap = icon.pixmap(size.width(), size.height());
-		} else {
-			const auto* icon = closestPixmap(size, this->bAttentionIconPixmaps.value());
+		auto image = scaledPixmapImage(attentionIconPixmaps, size);
+		if (image.isNull()) image = scaledPixmapImage(iconPixmaps, size);
+		return image;
+	}
 
-			if (icon == nullptr) {
-				icon = closestPixmap(size, this->bIconPixmaps.value());
-			}
+	auto image = scaledPixmapImage(iconPixmaps, size);
+	if (image.isNull()) return image;
 
-			if (icon != nullptr) {
-				const auto image =
-				    icon->createImage().scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+	auto overlay = scaledPixmapImage(overlayIconPixmaps, image.size());
 
-				pixmap = QPixmap::fromImage(image);
-			}
-		}
+	if (!overlay.isNull()) {
+		auto painter = QPainter(&image);
+		painter.drawImage(QRect(0, 0, image.width(), image.height()), overlay);
+		painter.end();
+	}
+
+	return image;
+}
+
+bool StatusNotifierItem::usesThemeIcon() const {
+	if (this->bStatus.value() == Status::NeedsAttention) {
+		return !this->bAttentionIconName.value().isEmpty();
 	} else {
-		if (!this->bIconName.value().isEmpty()) {
-			auto icon = QIcon::fromTheme(this->bIconName.value());
-			pixmap = icon.pixmap(size.width(), size.height());
-		} else {
-			const auto* icon = closestPixmap(size, this->bIconPixmaps.value());
+		return !this->bIconName.value().isEmpty() || !this->bOverlayIconName.value().isEmpty();
+	}
+}
 
-			if (icon != nullptr) {
-				const auto image =
-				    icon->createImage().scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+QPixmap StatusNotifierItem::createPixmap(const QSize& size) {
+	this->lastRequestedSize = size;
 
-				pixmap = QPixmap::fromImage(image);
-			}
-		}
+	auto key = TrayPixmapKey {
+	    .status = this->bStatus.value(),
+	    .size = size,
+	    .iconHash = this->iconHash,
+	};
 
-		QPixmap overlay;
-		if (!this->bOverlayIconName.value().isEmpty()) {
-			auto icon = QIcon::fromTheme(this->bOverlayIconName.value());
-			overlay = icon.pixmap(pixmap.width(), pixmap.height());
-		} else {
-			const auto* icon = closestPixmap(pixmap.size(), this->bOverlayIconPixmaps.value());
+	if (auto* pixmap = this->pixmapCache.object(key)) return *pixmap;
 
-			if (icon != nullptr) {
-				const auto image =
-				    icon->createImage().scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+	auto pixmap = this->renderPixmap(size);
+	if (!pixmap.isNull()) this->pixmapCache.insert(key, new QPixmap(pixmap));
 
-				overlay = QPixmap::fromImage(image);
-			}
-		}
+	return pixmap;
+}
 
-		if (!overlay.isNull()) {
-			auto painter = QPainter(&pixmap);
-			painter.drawPixmap(QRect(0, 0, pixmap.width(), pixmap.height()), overlay);
-			painter.end();
-		}
+QPixmap StatusNotifierItem::renderPixmap(const QSize& size) const {
+	auto needsAttention = this->bStatus.value() == Status::NeedsAttention;
+
+	if (!this->usesThemeIcon()) {
+		return QPixmap::fromImage(StatusNotifierItem::renderRawIcon(
+		    needsAttention,
+		    this->bIconPixmaps.value(),
+		    this->bOverlayIconPixmaps.value(),
+		    this->bAttentionIconPixmaps.value(),
+		    size
+		));
+	}
+
+	if (needsAttention) {
+		auto icon = QIcon::fromTheme(this->bAttentionIconName.value());
+		return icon.pixmap(size.width(), size.height());
+	}
+
+	QPixmap pixmap;
+	if (!this->bIconName.value().isEmpty()) {
+		auto icon = QIcon::fromTheme(this->bIconName.value());
+		pixmap = icon.pixmap(size.width(), size.height());
+	} else {
+		pixmap = QPixmap::fromImage(scaledPixmapImage(this->bIconPixmaps.value(), size));
+	}
+
+	QPixmap overlay;
+	if (!this->bOverlayIconName.value().isEmpty()) {
+		auto icon = QIcon::fromTheme(this->bOverlayIconName.value());
+		overlay = icon.pixmap(pixmap.width(), pixmap.height());
+	} else {
+		overlay = QPixmap::fromImage(scaledPixmapImage(this->bOverlayIconPixmaps.value(), pixmap.size()));
+	}
+
+	if (!overlay.isNull()) {
+		auto painter = QPainter(&pixmap);
+		painter.drawPixmap(QRect(0, 0, pixmap.width(), pixmap.height()), overlay);
+		painter.end();
 	}
 
 	return pixmap;
 }
 
+bool StatusNotifierItem::renderAsync() {
+	if (!this->lastRequestedSize.isValid() || this->usesThemeIcon()) return false;
+
+	auto key = TrayPixmapKey {
+	    .status = this->bStatus.value(),
+	    .size = this->lastRequestedSize,
+	    .iconHash = this->iconHash,
+	};
+
+	if (this->pixmapCache.contains(key)) return false;
+
+	auto bytes = pixmapListBytes(this->bIconPixmaps.value())
+	           + pixmapListBytes(this->bOverlayIconPixmaps.value())
+	           + pixmapListBytes(this->bAttentionIconPixmaps.value());
+
+	if (bytes < ASYNC_RENDER_BYTES) return false;
+
+	qCDebug(logStatusNotifierItem) << "Rendering icon for" << this->properties.toString()
+	                               << "asynchronously";
+
+	QThreadPool::globalInstance()->start(new TrayIconRenderer(this, key, ++this->renderSerial));
+	return true;
+}
+
+void StatusNotifierItem::onRenderFinished(
+    const TrayPixmapKey& key,
+    quint32 serial,
+    const QImage& image
+) {
+	// superseded by a newer icon
+	if (serial != this->renderSerial) return;
+
+	if (!image.isNull()) this->pixmapCache.insert(key, new QPixmap(QPixmap::fromImage(image)));
+	this->pixmapIndex = this->pixmapIndex + 1;
+}
+
+TrayIconRenderer::TrayIconRenderer(
+    StatusNotifierItem* item,
+    const TrayPixmapKey& key,
+    quint32 serial
+)
+    : item(item)
+    , key(key)
+    , serial(serial)
+    , iconPixmaps(item->bIconPixmaps.value())
+    , overlayIconPixmaps(item->bOverlayIconPixmaps.value())
+    , attentionIconPixmaps(item->bAttentionIconPixmaps.value()) {}
+
+void TrayIconRenderer::run() {
+	auto image = StatusNotifierItem::renderRawIcon(
+	    this->key.status == Status::NeedsAttention,
+	    this->iconPixmaps,
+	    this->overlayIconPixmaps,
+	    this->attentionIconPixmaps,
+	    this->key.size
+	);
+
+	// The application object outlives any item, and the pointer is only checked on the main thread.
+	QMetaObject::invokeMethod(
+	    QCoreApplication::instance(),
+	    [item = this->item, key = this->key, serial = this->serial, image]() {
+		    if (item) item->onRenderFinished(key, serial, image);
+	    },
+	    Qt::QueuedConnection
+	);
+}
+
 void StatusNotifierItem::activate() {
 	auto pendingCall = this->item->Activate(0, 0);
 	auto* call = new QDBusPendingCallWatcher(pendingCall, this);
@@ -268,7 +406,37 @@ void StatusNotifierItem::scroll(qint32 delta, bool horizontal) const {
 	this->item->Scroll(delta, horizontal ? "horizontal" : "vertical");
 }
 
-void StatusNotifierItem::updatePixmapIndex() { this->pixmapIndex = this->pixmapIndex + 1; }
+void StatusNotifierItem::updatePixmapIndex() {
+	auto hash = qHashMulti(
+	    0,
+	    this->bIconThemePath.value(),
+	    this->bIconName.value(),
+	    this->bOverlayIconName.value(),
+	    this->bAttentionIconName.value()
+	);
+
+	auto hashPixmaps = [&hash](const DBusSniIconPixmapList& pixmaps) {
+		hash = qHash(pixmaps.size(), hash);
+
+		for (const auto& pixmap: pixmaps) {
+			hash = qHashMulti(hash, pixmap.width, pixmap.height, pixmap.data);
+		}
+	};
+
+	hashPixmaps(this->bIconPixmaps.value());
+	hashPixmaps(this->bOverlayIconPixmaps.value());
+	hashPixmaps(this->bAttentionIconPixmaps.value());
+
+	this->iconHash = hash;
+
+	// The previous raster is kept displayed until an async render completes.
+	if (this->renderAsync()) return;
+	this->pixmapIndex = this->pixmapIndex + 1;
+}
+
+void StatusNotifierItem::prefetchMenu() {
+	if (auto* handle = this->menuHandle()) handle->prefetch();
+}
 
 DBusMenuHandle* StatusNotifierItem::menuHandle() {
 	return this->bMenuPath.value().path().isEmpty() ? nullptr : &this->mMenuHandle;
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <qcache.h>
 #include <qdbusextratypes.h>
 #include <qdbuspendingcall.h>
 #include <qicon.h>
 #include <qloggingcategory.h>
+#include <qimage.h>
 #include <qobject.h>
 #include <qpixmap.h>
+#include <qpointer.h>
 #include <qproperty.h>
+#include <qrunnable.h>
+#include <qsize.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
@@ -92,6 +97,32 @@ public:
 	StatusNotifierItem* item;
 };
 
+struct TrayPixmapKey {
+	Status::Enum status = Status::Passive;
+	QSize size;
+	size_t iconHash = 0;
+
+	[[nodiscard]] bool operator==(const TrayPixmapKey& other) const = default;
+};
+
+size_t qHash(const TrayPixmapKey& key, size_t seed = 0);
+
+// Renders raw icon pixmaps off the main thread. Used for items with large pixmap lists.
+class TrayIconRenderer: public QRunnable {
+public:
+	explicit TrayIconRenderer(StatusNotifierItem* item, const TrayPixmapKey& key, quint32 serial);
+
+	void run() override;
+
+private:
+	QPointer<StatusNotifierItem> item;
+	TrayPixmapKey key;
+	quint32 serial;
+	DBusSniIconPixmapList iconPixmaps;
+	DBusSniIconPixmapList overlayIconPixmaps;
+	DBusSniIconPixmapList attentionIconPixmaps;
+};
+
 ///! An item in the system tray.
 /// A system tray item, roughly conforming to the [kde/freedesktop spec]
 /// (there is no real spec, we just implemented whatever seemed to actually be used).
@@ -134,11 +165,18 @@ public:
 	Q_INVOKABLE void scroll(qint32 delta, bool horizontal) const;
 	/// Display a platform menu at the given location relative to the parent window.
 	Q_INVOKABLE void display(QObject* parentWindow, qint32 relativeX, qint32 relativeY);
+	/// Load the item's menu in the background, so it can be shown without waiting for
+	/// the application. Call this when the menu is likely to be opened soon, such as
+	/// when the item is hovered. Does nothing if the item has no menu.
+	///
+	/// Prefetched menus, and menus that have been closed, are kept loaded and up to
+	/// date for 30 seconds, or for as long as @@SystemTray.prefetchMenus is set.
+	Q_INVOKABLE void prefetchMenu();
 
 	[[nodiscard]] bool isValid() const;
 	[[nodiscard]] bool isReady() const;
 	[[nodiscard]] QBindable<QString> bindableIcon() const { return &this->bIcon; }
-	[[nodiscard]] QPixmap createPixmap(const QSize& size) const;
+	[[nodiscard]] QPixmap createPixmap(const QSize& size);
 
 	[[nodiscard]] dbus::dbusmenu::DBusMenuHandle* menuHandle();
 
@@ -169,14 +207,35 @@ private slots:
 	void onGetAllFailed() const;
 
 private:
+	// Raw pixmap lists larger than this are rendered off the main thread.
+	static constexpr qsizetype ASYNC_RENDER_BYTES = 128 * 128 * 4;
+
+	static QImage renderRawIcon(
+	    bool needsAttention,
+	    const DBusSniIconPixmapList& iconPixmaps,
+	    const DBusSniIconPixmapList& overlayIconPixmaps,
+	    const DBusSniIconPixmapList& attentionIconPixmaps,
+	    const QSize& size
+	);
+
 	void updateMenuState();
 	void updatePixmapIndex();
 	void onMenuPathChanged();
+	[[nodiscard]] bool usesThemeIcon() const;
+	[[nodiscard]] QPixmap renderPixmap(const QSize& size) const;
+	bool renderAsync();
+	void onRenderFinished(const TrayPixmapKey& key, quint32 serial, const QImage& image);
 
 	DBusStatusNotifierItem* item = nullptr;
 	TrayImageHandle imageHandle {this};
 	bool mReady = false;
 
+	// Keyed by icon content so unchanged or cycling icons are not converted and scaled again.
+	QCache<TrayPixmapKey, QPixmap> pixmapCache {8};
+	size_t iconHash = 0;
+	QSize lastRequestedSize;
+	quint32 renderSerial = 0;
+
 	dbus::dbusmenu::DBusMenuHandle mMenuHandle {this};
 
 	QString watcherId;
@@ -227,6 +286,8 @@ private:
 	QS_DBUS_PROPERTY_BINDING(StatusNotifierItem, pIsMenu, bIsMenu, properties, "ItemIsMenu", false);
 	QS_DBUS_PROPERTY_BINDING(StatusNotifierItem, pMenuPath, bMenuPath, properties, "Menu", false);
 	// clang-format on
+
+	friend class TrayIconRenderer;
 };
 
 } // namespace qs::service::sni
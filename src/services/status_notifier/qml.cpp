@@ -4,10 +4,12 @@
 #include <qobject.h>
 
 #include "../../core/model.hpp"
+#include "../../dbus/dbusmenu/dbusmenu.hpp"
 #include "host.hpp"
 #include "item.hpp"
 
 using namespace qs::service::sni;
+using namespace qs::dbus::dbusmenu;
 
 SystemTray::SystemTray(QObject* parent): QObject(parent) {
 	auto* host = StatusNotifierHost::instance();
@@ -15,6 +17,7 @@ SystemTray::SystemTray(QObject* parent): QObject(parent) {
 	// clang-format off
 	QObject::connect(host, &StatusNotifierHost::itemReady, this, &SystemTray::onItemRegistered);
 	QObject::connect(host, &StatusNotifierHost::itemUnregistered, this, &SystemTray::onItemUnregistered);
+	QObject::connect(DBusMenuPrefetcher::instance(), &DBusMenuPrefetcher::enabledChanged, this, &SystemTray::prefetchMenusChanged);
 	// clang-format on
 
 	for (auto* item: host->items()) {
@@ -29,6 +32,14 @@ void SystemTray::onItemRegistered(StatusNotifierItem* item) {
 void SystemTray::onItemUnregistered(StatusNotifierItem* item) { this->mItems.removeObject(item); }
 ObjectModel<StatusNotifierItem>* SystemTray::items() { return &this->mItems; }
 
+bool SystemTray::prefetchMenus() const { // NOLINT
+	return DBusMenuPrefetcher::instance()->isEnabled();
+}
+
+void SystemTray::setPrefetchMenus(bool prefetchMenus) { // NOLINT
+	DBusMenuPrefetcher::instance()->setEnabled(prefetchMenus);
+}
+
 bool SystemTray::compareItems(StatusNotifierItem* a, StatusNotifierItem* b) {
 	return a->bindableCategory().value() < b->bindableCategory().value()
 	    || a->bindableId().value().compare(b->bindableId().value(), Qt::CaseInsensitive) >= 0;
@@ -18,6 +18,13 @@ class SystemTray: public QObject {
 	/// List of all system tray icons.
 	QSDOC_TYPE_OVERRIDE(ObjectModel<qs::service::sni::StatusNotifierItem>*);
 	Q_PROPERTY(UntypedObjectModel* items READ items CONSTANT);
+	/// If true (default false), the menus of all tray items are loaded in the background
+	/// one at a time while no menu is open, and are kept loaded and up to date so they open
+	/// without waiting for their application. See also @@SystemTrayItem.prefetchMenu().
+	///
+	/// This keeps a connection to every item's menu, which costs some memory and D-Bus
+	/// traffic for applications that update their menus often.
+	Q_PROPERTY(bool prefetchMenus READ prefetchMenus WRITE setPrefetchMenus NOTIFY prefetchMenusChanged);
 	QML_ELEMENT;
 	QML_SINGLETON;
 
@@ -26,6 +33,12 @@ public:
 
 	[[nodiscard]] ObjectModel<qs::service::sni::StatusNotifierItem>* items();
 
+	[[nodiscard]] bool prefetchMenus() const;
+	void setPrefetchMenus(bool prefetchMenus);
+
+signals:
+	void prefetchMenusChanged();
+
 private slots:
 	void onItemRegistered(qs::service::sni::StatusNotifierItem* item);
 	void onItemUnregistered(qs::service::sni::StatusNotifierItem* item);
@@ -17,9 +17,11 @@
 #include <libdrm/drm_fourcc.h>
 #include <qcontainerfwd.h>
 #include <qdebug.h>
+#include <qimage.h>
 #include <qlist.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
+#include <qmutex.h>
 #include <qopenglcontext.h>
 #include <qopenglcontext_platform.h>
 #include <qpair.h>
@@ -49,6 +51,21 @@ QS_LOGGING_CATEGORY(logDmabuf, "quickshell.wayland.buffer.dmabuf", QtWarningMsg)
 
 LinuxDmabufManager* MANAGER = nullptr; // NOLINT
 
+// Drm formats are little endian, matching QImage's 32 bit formats on little endian hosts.
+QImage::Format imageFormat(uint32_t format) {
+	switch (format) {
+	case DRM_FORMAT_ARGB8888: return QImage::Format_ARGB32_Premultiplied;
+	case DRM_FORMAT_XRGB8888: return QImage::Format_RGB32;
+	case DRM_FORMAT_ABGR8888: return QImage::Format_RGBA8888_Premultiplied;
+	case DRM_FORMAT_XBGR8888: return QImage::Format_RGBX8888;
+	case DRM_FORMAT_ARGB2101010: return QImage::Format_A2RGB30_Premultiplied;
+	case DRM_FORMAT_XRGB2101010: return QImage::Format_RGB30;
+	case DRM_FORMAT_ABGR2101010: return QImage::Format_A2BGR30_Premultiplied;
+	case DRM_FORMAT_XBGR2101010: return QImage::Format_BGR30;
+	default: return QImage::Format_Invalid;
+	}
+}
+
 } // namespace
 
 QDebug& operator<<(QDebug& debug, const FourCCStr& fourcc) {
@@ -532,6 +549,52 @@ bool WlDmaBuffer::isCompatible(const WlBufferRequest& request) const {
 	return matchingFormat != request.dmabuf.formats.end();
 }
 
+QImage WlDmaBuffer::toImage() const {
+	auto format = imageFormat(this->format);
+
+	if (format == QImage::Format_Invalid) {
+		qCWarning(logDmabuf) << "Cannot read" << this << "as its format is not supported by QImage.";
+		return QImage();
+	}
+
+	// Frames may be saved from several threads at once.
+	static auto mapMutex = QMutex();
+	auto locker = QMutexLocker(&mapMutex);
+
+	uint32_t stride = 0;
+	void* mapData = nullptr;
+
+	// The driver takes care of detiling if the buffer is not linear.
+	auto* data = gbm_bo_map(
+	    this->bo,
+	    0,
+	    0,
+	    this->width,
+	    this->height,
+	    GBM_BO_TRANSFER_READ,
+	    &stride,
+	    &mapData
+	);
+
+	if (!data) {
+		qCWarning(logDmabuf) << "Failed to map" << this << "for reading.";
+		return QImage();
+	}
+
+	auto mapped = QImage(
+	    static_cast<const uchar*>(data),
+	    static_cast<int>(this->width),
+	    static_cast<int>(this->height),
+	    static_cast<qsizetype>(stride),
+	    format
+	);
+
+	auto image = mapped.copy();
+
+	gbm_bo_unmap(this->bo, mapData);
+	return image;
+}
+
 WlBufferQSGTexture* WlDmaBuffer::createQsgTexture(QQuickWindow* window) const {
 	static auto* glEGLImageTargetTexture2DOES = []() {
 		auto* fn = reinterpret_cast<PFNGLEGLIMAGETARGETTEXTURE2DOESPROC>(
@@ -6,6 +6,7 @@
 #include <gbm.h>
 #include <qcontainerfwd.h>
 #include <qhash.h>
+#include <qimage.h>
 #include <qlist.h>
 #include <qquickwindow.h>
 #include <qsgtexture.h>
@@ -129,6 +130,7 @@ public:
 
 	[[nodiscard]] bool isCompatible(const WlBufferRequest& request) const override;
 	[[nodiscard]] WlBufferQSGTexture* createQsgTexture(QQuickWindow* window) const override;
+	[[nodiscard]] QImage toImage() const override;
 
 private:
 	WlDmaBuffer() noexcept = default;
@@ -1,13 +1,18 @@
 #include "manager.hpp"
+#include <optional>
 
 #include <qdebug.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qmatrix4x4.h>
 #include <qnamespace.h>
+#include <qpoint.h>
 #include <qquickwindow.h>
+#include <qrect.h>
+#include <qregion.h>
 #include <qtenvironmentvariables.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 #include <qvectornd.h>
 
 #include "../../core/logcat.hpp"
@@ -27,7 +32,8 @@ void WlBufferRequest::reset() { *this = WlBufferRequest(); }
 WlBuffer* WlBufferSwapchain::createBackbuffer(const WlBufferRequest& request, bool* newBuffer) {
 	auto& buffer = this->presentSecondBuffer ? this->buffer1 : this->buffer2;
 
-	if (!buffer || !buffer->isCompatible(request)) {
+	// A retained buffer may still be read by its holder.
+	if (!buffer || buffer.use_count() > 1 || !buffer->isCompatible(request)) {
 		buffer.reset(WlBufferManager::instance()->createBuffer(request));
 		if (newBuffer) *newBuffer = true;
 	}
@@ -35,6 +41,40 @@ WlBuffer* WlBufferSwapchain::createBackbuffer(const WlBufferRequest& request, bo
 	return buffer.get();
 }
 
+void WlBufferSwapchain::swapBuffers(std::optional<QRegion> damage) {
+	this->presentSecondBuffer = !this->presentSecondBuffer;
+	this->mSerial++;
+
+	if (!damage) {
+		auto* frontbuffer = this->frontbuffer();
+		damage = frontbuffer ? QRegion(QRect(QPoint(), frontbuffer->size())) : QRegion();
+	}
+
+	this->damageHistory.append(*damage);
+	if (this->damageHistory.length() > WlBufferSwapchain::DAMAGE_HISTORY) {
+		this->damageHistory.removeFirst();
+	}
+}
+
+QRegion WlBufferSwapchain::damageSince(quint64 serial) const {
+	auto frames = this->mSerial - serial;
+
+	if (serial == 0 || frames > static_cast<quint64>(this->damageHistory.length())) {
+		auto* frontbuffer = this->frontbuffer();
+		return frontbuffer ? QRegion(QRect(QPoint(), frontbuffer->size())) : QRegion();
+	}
+
+	auto damage = QRegion();
+	for (auto i = this->damageHistory.length() - static_cast<qsizetype>(frames);
+	     i != this->damageHistory.length();
+	     i++)
+	{
+		damage += this->damageHistory.at(i);
+	}
+
+	return damage;
+}
+
 WlBufferManager::WlBufferManager(): p(new WlBufferManagerPrivate(this)) {}
 
 WlBufferManager::~WlBufferManager() { delete this->p; }
@@ -98,7 +138,7 @@ WlBufferQSGDisplayNode::WlBufferQSGDisplayNode(QQuickWindow* window)
 }
 
 void WlBufferQSGDisplayNode::setRect(const QRectF& rect) {
-	const auto* buffer = (this->presentSecondBuffer ? this->buffer2 : this->buffer1).first;
+	const auto* buffer = (this->presentSecondBuffer ? this->buffer2 : this->buffer1).buffer;
 	if (!buffer) return;
 
 	auto matrix = QMatrix4x4();
@@ -127,20 +167,31 @@ void WlBufferQSGDisplayNode::syncSwapchain(const WlBufferSwapchain& swapchain) {
 	auto* buffer = swapchain.frontbuffer();
 	auto& texture = swapchain.presentSecondBuffer ? this->buffer2 : this->buffer1;
 
-	if (swapchain.presentSecondBuffer == this->presentSecondBuffer && texture.first == buffer) {
+	if (swapchain.presentSecondBuffer == this->presentSecondBuffer && texture.buffer == buffer
+	    && texture.serial == swapchain.serial())
+	{
 		return;
 	}
 
 	this->presentSecondBuffer = swapchain.presentSecondBuffer;
 
-	if (texture.first == buffer) {
-		texture.second->sync(texture.first, this->window);
+	if (texture.buffer == buffer) {
+		// The texture was last synced to an older frame in the same buffer, and only
+		// needs the parts that changed since then.
+		auto damage = swapchain.damageSince(texture.serial);
+		texture.serial = swapchain.serial();
+
+		if (!damage.isEmpty()) {
+			texture.texture->sync(texture.buffer, this->window, damage);
+			this->imageNode->markDirty(QSGNode::DirtyMaterial);
+		}
 	} else {
-		texture.first = buffer;
-		texture.second.reset(buffer->createQsgTexture(this->window));
+		texture.buffer = buffer;
+		texture.texture.reset(buffer->createQsgTexture(this->window));
+		texture.serial = swapchain.serial();
 	}
 
-	this->imageNode->setTexture(texture.second->texture());
+	this->imageNode->setTexture(texture.texture->texture());
 }
 
 } // namespace qs::wayland::buffer
@@ -2,13 +2,17 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 
 #include <qhash.h>
+#include <qimage.h>
 #include <qlist.h>
 #include <qmatrix4x4.h>
 #include <qobject.h>
+#include <qregion.h>
 #include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 #include <qvariant.h>
 #include <sys/types.h>
 #include <wayland-client-protocol.h>
@@ -85,6 +89,11 @@ public:
 	// Must be called from render thread.
 	[[nodiscard]] virtual WlBufferQSGTexture* createQsgTexture(QQuickWindow* window) const = 0;
 
+	// Copies the buffer's content into an image, without applying the transform.
+	// Returns a null image if the buffer cannot be read. May be called from any thread
+	// while nothing is captured into the buffer, see WlBufferSwapchain::retainFrontbuffer.
+	[[nodiscard]] virtual QImage toImage() const = 0;
+
 	WlBufferTransform transform;
 
 protected:
@@ -96,7 +105,16 @@ public:
 	[[nodiscard]] WlBuffer*
 	createBackbuffer(const WlBufferRequest& request, bool* newBuffer = nullptr);
 
-	void swapBuffers() { this->presentSecondBuffer = !this->presentSecondBuffer; }
+	// Presents the backbuffer. The damage is the region of the new frame that changed
+	// since the previous one, in buffer coordinates. If not known, the whole frame is damaged.
+	void swapBuffers(std::optional<QRegion> damage = std::nullopt);
+
+	// Incremented on every swap.
+	[[nodiscard]] quint64 serial() const { return this->mSerial; }
+
+	// Returns the region of the frontbuffer that changed since the frame presented at
+	// the given serial. Returns the whole frame if the serial is too old to be known.
+	[[nodiscard]] QRegion damageSince(quint64 serial) const;
 
 	[[nodiscard]] WlBuffer* backbuffer() const {
 		return this->presentSecondBuffer ? this->buffer1.get() : this->buffer2.get();
@@ -106,10 +124,23 @@ public:
 		return this->presentSecondBuffer ? this->buffer2.get() : this->buffer1.get();
 	}
 
+	// Keeps the frontbuffer alive and unchanged for as long as the returned pointer is held,
+	// as createBackbuffer allocates a new buffer instead of reusing a retained one.
+	// The pointer must be released on the main thread, which destroys the buffer if it was
+	// replaced in the meantime.
+	[[nodiscard]] std::shared_ptr<WlBuffer> retainFrontbuffer() const {
+		return this->presentSecondBuffer ? this->buffer2 : this->buffer1;
+	}
+
 private:
-	std::unique_ptr<WlBuffer> buffer1;
-	std::unique_ptr<WlBuffer> buffer2;
+	static constexpr qsizetype DAMAGE_HISTORY = 4;
+
+	std::shared_ptr<WlBuffer> buffer1;
+	std::shared_ptr<WlBuffer> buffer2;
 	bool presentSecondBuffer = false;
+	quint64 mSerial = 0;
+	// Damage of the most recent frames, oldest first.
+	QList<QRegion> damageHistory;
 
 	friend class WlBufferQSGDisplayNode;
 };
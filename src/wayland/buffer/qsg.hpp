@@ -4,9 +4,11 @@
 
 #include <qcontainerfwd.h>
 #include <qquickwindow.h>
+#include <qregion.h>
 #include <qsgimagenode.h>
 #include <qsgnode.h>
 #include <qsgtexture.h>
+#include <qtypes.h>
 #include <qvectornd.h>
 
 #include "manager.hpp"
@@ -20,7 +22,11 @@ public:
 	Q_DISABLE_COPY_MOVE(WlBufferQSGTexture);
 
 	[[nodiscard]] virtual QSGTexture* texture() const = 0;
-	virtual void sync(const WlBuffer* /*buffer*/, QQuickWindow* /*window*/) {}
+
+	// Updates the texture after the buffer's content changed. The damage is the changed
+	// region of the buffer in buffer coordinates, and is never empty.
+	virtual void
+	sync(const WlBuffer* /*buffer*/, QQuickWindow* /*window*/, const QRegion& /*damage*/) {}
 
 protected:
 	WlBufferQSGTexture() = default;
@@ -35,10 +41,17 @@ public:
 	void setRect(const QRectF& rect);
 
 private:
+	struct BufferTexture {
+		WlBuffer* buffer = nullptr;
+		std::unique_ptr<WlBufferQSGTexture> texture;
+		// Swapchain serial the texture was last synced at.
+		quint64 serial = 0;
+	};
+
 	QQuickWindow* window;
 	QSGImageNode* imageNode;
-	QPair<WlBuffer*, std::unique_ptr<WlBufferQSGTexture>> buffer1;
-	QPair<WlBuffer*, std::unique_ptr<WlBufferQSGTexture>> buffer2;
+	BufferTexture buffer1;
+	BufferTexture buffer2;
 	bool presentSecondBuffer = false;
 };
 
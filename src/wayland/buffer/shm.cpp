@@ -1,16 +1,24 @@
 #include "shm.hpp"
 #include <algorithm>
 #include <memory>
+#include <utility>
 
 #include <private/qwaylanddisplay_p.h>
 #include <private/qwaylandintegration_p.h>
 #include <private/qwaylandshm_p.h>
 #include <private/qwaylandshmbackingstore_p.h>
 #include <qdebug.h>
+#include <qimage.h>
+#include <qlist.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
+#include <qpoint.h>
 #include <qquickwindow.h>
+#include <qrect.h>
+#include <qregion.h>
 #include <qsize.h>
+#include <qtypes.h>
+#include <rhi/qrhi.h>
 #include <wayland-client-protocol.h>
 
 #include "../../core/logcat.hpp"
@@ -51,23 +59,95 @@ QDebug& operator<<(QDebug& debug, const WlShmBuffer* buffer) {
 
 WlShmBuffer::~WlShmBuffer() { qCDebug(logShm) << "Destroyed" << this; }
 
-WlBufferQSGTexture* WlShmBuffer::createQsgTexture(QQuickWindow* window) const {
+WlBufferQSGTexture* WlShmBuffer::createQsgTexture(QQuickWindow* /*window*/) const {
 	auto* texture = new WlShmBufferQSGTexture();
+	texture->qsgTexture = std::make_unique<WlShmQSGTexture>(this->shmBuffer);
+	return texture;
+}
+
+void WlShmBufferQSGTexture::sync(
+    const WlBuffer* /*unused*/,
+    QQuickWindow* /*unused*/,
+    const QRegion& damage
+) {
+	// Uploaded the next time the texture is used for rendering.
+	this->qsgTexture->addDamage(damage);
+}
 
-	// If the QWaylandShmBuffer is destroyed before the QSGTexture, we'll hit a UAF
-	// in the render thread.
-	texture->shmBuffer = this->shmBuffer;
+WlShmQSGTexture::WlShmQSGTexture(std::shared_ptr<QtWaylandClient::QWaylandShmBuffer> shmBuffer)
+    : shmBuffer(std::move(shmBuffer)) {}
 
-	texture->qsgTexture.reset(window->createTextureFromImage(*this->shmBuffer->image()));
-	texture->sync(this, window);
-	return texture;
+WlShmQSGTexture::~WlShmQSGTexture() {
+	if (this->mTexture) this->mTexture->deleteLater();
+}
+
+qint64 WlShmQSGTexture::comparisonKey() const {
+	return static_cast<qint64>(reinterpret_cast<quintptr>(this)); // NOLINT
+}
+
+QSize WlShmQSGTexture::textureSize() const { return this->shmBuffer->image()->size(); }
+
+bool WlShmQSGTexture::hasAlphaChannel() const {
+	return this->shmBuffer->image()->hasAlphaChannel();
 }
 
-void WlShmBufferQSGTexture::sync(const WlBuffer* /*unused*/, QQuickWindow* window) {
-	// This is both dumb and expensive. We should use an RHI texture and render images into
-	// it more intelligently, but shm buffers are already a horribly slow fallback path,
-	// to the point where it barely matters.
-	this->qsgTexture.reset(window->createTextureFromImage(*this->shmBuffer->image()));
+void WlShmQSGTexture::commitTextureOperations(
+    QRhi* rhi,
+    QRhiResourceUpdateBatch* resourceUpdates
+) {
+	const auto* image = this->shmBuffer->image();
+
+	if (!this->mTexture) {
+		auto format = image->format();
+
+		// Wayland's little endian ARGB formats match BGRA8, which avoids converting on upload.
+		this->bgra = rhi->isTextureFormatSupported(QRhiTexture::BGRA8)
+		          && (format == QImage::Format_ARGB32_Premultiplied || format == QImage::Format_RGB32);
+
+		this->mTexture =
+		    rhi->newTexture(this->bgra ? QRhiTexture::BGRA8 : QRhiTexture::RGBA8, image->size());
+
+		if (!this->mTexture->create()) {
+			qCWarning(logShm) << "Failed to create texture for" << this->shmBuffer.get();
+			delete this->mTexture;
+			this->mTexture = nullptr;
+			return;
+		}
+
+		this->pendingDamage = QRect(QPoint(), image->size());
+	}
+
+	if (this->pendingDamage.isEmpty()) return;
+
+	auto damage = this->pendingDamage.intersected(QRect(QPoint(), image->size()));
+	this->pendingDamage = QRegion();
+
+	if (damage.rectCount() > WlShmQSGTexture::MAX_UPLOAD_RECTS) {
+		damage = damage.boundingRect();
+	}
+
+	auto entries = QList<QRhiTextureUploadEntry>();
+
+	for (const auto& rect: damage) {
+		if (this->bgra) {
+			auto desc = QRhiTextureSubresourceUploadDescription(*image);
+			desc.setSourceTopLeft(rect.topLeft());
+			desc.setSourceSize(rect.size());
+			desc.setDestinationTopLeft(rect.topLeft());
+			entries.append(QRhiTextureUploadEntry(0, 0, desc));
+		} else {
+			auto converted =
+			    image->copy(rect).convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+
+			auto desc = QRhiTextureSubresourceUploadDescription(converted);
+			desc.setDestinationTopLeft(rect.topLeft());
+			entries.append(QRhiTextureUploadEntry(0, 0, desc));
+		}
+	}
+
+	auto upload = QRhiTextureUploadDescription();
+	upload.setEntries(entries.cbegin(), entries.cend());
+	resourceUpdates->uploadTexture(this->mTexture, upload);
 }
 
 WlBuffer* ShmbufManager::createShmbuf(const WlBufferRequest& request) {
@@ -3,10 +3,14 @@
 #include <memory>
 
 #include <private/qwaylandshmbackingstore_p.h>
+#include <qimage.h>
 #include <qquickwindow.h>
+#include <qregion.h>
 #include <qsgtexture.h>
 #include <qsize.h>
 #include <qtclasshelpermacros.h>
+#include <qtypes.h>
+#include <rhi/qrhi.h>
 #include <wayland-client-protocol.h>
 
 #include "manager.hpp"
@@ -23,6 +27,7 @@ public:
 	[[nodiscard]] QSize size() const override { return this->shmBuffer->size(); }
 	[[nodiscard]] bool isCompatible(const WlBufferRequest& request) const override;
 	[[nodiscard]] WlBufferQSGTexture* createQsgTexture(QQuickWindow* window) const override;
+	[[nodiscard]] QImage toImage() const override { return this->shmBuffer->image()->copy(); }
 
 private:
 	WlShmBuffer(QtWaylandClient::QWaylandShmBuffer* shmBuffer, uint32_t format)
@@ -39,16 +44,43 @@ private:
 
 QDebug& operator<<(QDebug& debug, const WlShmBuffer* buffer);
 
+// Uploads only the damaged parts of a shm buffer's image into an RHI texture.
+class WlShmQSGTexture: public QSGTexture {
+public:
+	explicit WlShmQSGTexture(std::shared_ptr<QtWaylandClient::QWaylandShmBuffer> shmBuffer);
+	~WlShmQSGTexture() override;
+	Q_DISABLE_COPY_MOVE(WlShmQSGTexture);
+
+	[[nodiscard]] qint64 comparisonKey() const override;
+	[[nodiscard]] QRhiTexture* rhiTexture() const override { return this->mTexture; }
+	[[nodiscard]] QSize textureSize() const override;
+	[[nodiscard]] bool hasAlphaChannel() const override;
+	[[nodiscard]] bool hasMipmaps() const override { return false; }
+	void commitTextureOperations(QRhi* rhi, QRhiResourceUpdateBatch* resourceUpdates) override;
+
+	void addDamage(const QRegion& damage) { this->pendingDamage += damage; }
+
+private:
+	// Above this many rects, the bounding rect of the damage is uploaded instead.
+	static constexpr int MAX_UPLOAD_RECTS = 16;
+
+	// If the QWaylandShmBuffer is destroyed before the QSGTexture, we'll hit a UAF
+	// in the render thread.
+	std::shared_ptr<QtWaylandClient::QWaylandShmBuffer> shmBuffer;
+	QRhiTexture* mTexture = nullptr;
+	bool bgra = false;
+	QRegion pendingDamage;
+};
+
 class WlShmBufferQSGTexture: public WlBufferQSGTexture {
 public:
 	[[nodiscard]] QSGTexture* texture() const override { return this->qsgTexture.get(); }
-	void sync(const WlBuffer* buffer, QQuickWindow* window) override;
+	void sync(const WlBuffer* buffer, QQuickWindow* window, const QRegion& damage) override;
 
 private:
 	WlShmBufferQSGTexture() = default;
 
-	std::shared_ptr<QtWaylandClient::QWaylandShmBuffer> shmBuffer;
-	std::unique_ptr<QSGTexture> qsgTexture;
+	std::unique_ptr<WlShmQSGTexture> qsgTexture;
 
 	friend class WlShmBuffer;
 };
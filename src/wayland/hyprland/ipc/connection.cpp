@@ -10,6 +10,7 @@
 #include <qjsonarray.h>
 #include <qjsondocument.h>
 #include <qjsonobject.h>
+#include <qlatin1stringview.h>
 #include <qlocalsocket.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
@@ -23,6 +24,7 @@
 
 #include "../../../core/logcat.hpp"
 #include "../../../core/model.hpp"
+#include "../../../core/profiler.hpp"
 #include "../../../core/qmlscreen.hpp"
 #include "../../toplevel_management/handle.hpp"
 #include "hyprland_toplevel.hpp"
@@ -117,6 +119,8 @@ void HyprlandIpc::eventSocketReady() {
 		);
 		qCDebug(logHyprlandIpcEvents) << "Received event:" << rawEvent << "parsed as" << event << data;
 
+		QsProfiler::countEvent(QLatin1StringView("hyprland"), QLatin1StringView(event));
+
 		this->event.name = event;
 		this->event.data = data;
 		this->onEvent(&this->event);
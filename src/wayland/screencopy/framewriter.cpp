@@ -0,0 +1,228 @@
+#include "framewriter.hpp"
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include <qbytearray.h>
+#include <qcoreapplication.h>
+#include <qfileinfo.h>
+#include <qimage.h>
+#include <qimagewriter.h>
+#include <qiodevice.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qrect.h>
+#include <qsavefile.h>
+#include <qstring.h>
+#include <qtransform.h>
+#include <qtypes.h>
+
+#include "../buffer/manager.hpp"
+#include "view.hpp"
+
+namespace qs::wayland::screencopy {
+
+namespace {
+
+struct QoiPixel {
+	quint8 r = 0;
+	quint8 g = 0;
+	quint8 b = 0;
+	quint8 a = 0;
+
+	[[nodiscard]] bool operator==(const QoiPixel& other) const = default;
+
+	[[nodiscard]] size_t hash() const {
+		return (this->r * 3 + this->g * 5 + this->b * 7 + this->a * 11) % 64;
+	}
+};
+
+void appendBigEndian(QByteArray& data, quint32 value) {
+	data.append(static_cast<char>(value >> 24 & 0xff));
+	data.append(static_cast<char>(value >> 16 & 0xff));
+	data.append(static_cast<char>(value >> 8 & 0xff));
+	data.append(static_cast<char>(value & 0xff));
+}
+
+// Pixels are written row by row as straight alpha RGBA, without padding.
+QByteArray encodeRaw(const QImage& source) {
+	auto image = source.convertToFormat(QImage::Format_RGBA8888);
+	auto lineSize = static_cast<qsizetype>(image.width()) * 4;
+
+	auto data = QByteArray();
+	data.reserve(lineSize * image.height());
+
+	for (auto y = 0; y != image.height(); y++) {
+		data.append(reinterpret_cast<const char*>(image.constScanLine(y)), lineSize); // NOLINT
+	}
+
+	return data;
+}
+
+} // namespace
+
+ScreencopyFrameWriter::ScreencopyFrameWriter(
+    ScreencopyView* view,
+    quint32 id,
+    std::shared_ptr<buffer::WlBuffer> buffer,
+    QRect region,
+    QString path
+)
+    : view(view)
+    , id(id)
+    , buffer(std::move(buffer))
+    , region(region)
+    , path(std::move(path)) {}
+
+void ScreencopyFrameWriter::run() {
+	auto error = this->write();
+
+	// The application object outlives any view, and the pointer is only checked on the main thread.
+	// The buffer is released there as well, as it may be destroyed with it.
+	QMetaObject::invokeMethod(
+	    QCoreApplication::instance(),
+	    [view = this->view, id = this->id, error, buffer = std::move(this->buffer)]() mutable {
+		    buffer.reset();
+		    if (view) view->onFrameSaved(id, error);
+	    },
+	    Qt::QueuedConnection
+	);
+}
+
+QString ScreencopyFrameWriter::write() {
+	// Reading a dmabuf may make the driver copy and detile it, which is kept off the main thread.
+	auto image = this->buffer->toImage();
+	if (image.isNull()) return QStringLiteral("The captured frame could not be read.");
+
+	image = ScreencopyFrameWriter::transformed(image, this->buffer->transform);
+
+	if (this->region.isValid()) {
+		auto region = this->region.intersected(image.rect());
+		if (region.isEmpty()) return QStringLiteral("The region does not overlap the frame.");
+		image = image.copy(region);
+	}
+
+	auto suffix = QFileInfo(this->path).suffix().toLower();
+
+	if (suffix == QStringLiteral("qoi") || suffix == QStringLiteral("raw")) {
+		auto data = suffix == QStringLiteral("qoi") ? ScreencopyFrameWriter::encodeQoi(image)
+		                                            : encodeRaw(image);
+
+		auto file = QSaveFile(this->path);
+		if (!file.open(QIODevice::WriteOnly)) return file.errorString();
+
+		file.write(data);
+		if (!file.commit()) return file.errorString();
+
+		return QString();
+	}
+
+	auto writer = QImageWriter(this->path);
+	if (!writer.write(image)) return writer.errorString();
+
+	return QString();
+}
+
+QImage
+ScreencopyFrameWriter::transformed(const QImage& image, buffer::WlBufferTransform transform) {
+	// Matches WlBufferTransform::apply, which rotates before flipping.
+	auto result = image;
+
+	if (transform.degrees() != 0) {
+		result = result.transformed(QTransform().rotate(transform.degrees()));
+	}
+
+	if (transform.flip()) {
+		result = result.transformed(QTransform::fromScale(-1, 1));
+	}
+
+	return result;
+}
+
+QByteArray ScreencopyFrameWriter::encodeQoi(const QImage& source) {
+	auto image = source.convertToFormat(QImage::Format_RGBA8888);
+	auto width = image.width();
+	auto height = image.height();
+
+	auto data = QByteArray();
+	// Screenshots usually compress to well under one byte per pixel.
+	data.reserve(14 + static_cast<qsizetype>(width) * height + 8);
+
+	data.append("qoif", 4);
+	appendBigEndian(data, static_cast<quint32>(width));
+	appendBigEndian(data, static_cast<quint32>(height));
+	data.append(static_cast<char>(4)); // channels
+	data.append(static_cast<char>(0)); // sRGB with linear alpha
+
+	auto index = std::array<QoiPixel, 64>();
+	auto previous = QoiPixel {.r = 0, .g = 0, .b = 0, .a = 255};
+	auto run = 0;
+
+	auto flushRun = [&]() {
+		if (run == 0) return;
+		data.append(static_cast<char>(0xc0 | (run - 1)));
+		run = 0;
+	};
+
+	for (auto y = 0; y != height; y++) {
+		const auto* line = image.constScanLine(y);
+
+		for (auto x = 0; x != width; x++) {
+			const auto* p = line + static_cast<ptrdiff_t>(x) * 4; // NOLINT
+			auto pixel = QoiPixel {.r = p[0], .g = p[1], .b = p[2], .a = p[3]}; // NOLINT
+
+			if (pixel == previous) {
+				run++;
+				if (run == 62) flushRun();
+				continue;
+			}
+
+			flushRun();
+
+			auto hash = pixel.hash();
+
+			if (index.at(hash) == pixel) {
+				data.append(static_cast<char>(hash));
+			} else {
+				index.at(hash) = pixel;
+
+				if (pixel.a == previous.a) {
+					auto dr = static_cast<qint8>(pixel.r - previous.r);
+					auto dg = static_cast<qint8>(pixel.g - previous.g);
+					auto db = static_cast<qint8>(pixel.b - previous.b);
+					auto drg = dr - dg;
+					auto dbg = db - dg;
+
+					if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+						data.append(static_cast<char>(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+					} else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7) {
+						data.append(static_cast<char>(0x80 | (dg + 32)));
+						data.append(static_cast<char>((drg + 8) << 4 | (dbg + 8)));
+					} else {
+						data.append(static_cast<char>(0xfe));
+						data.append(static_cast<char>(pixel.r));
+						data.append(static_cast<char>(pixel.g));
+						data.append(static_cast<char>(pixel.b));
+					}
+				} else {
+					data.append(static_cast<char>(0xff));
+					data.append(static_cast<char>(pixel.r));
+					data.append(static_cast<char>(pixel.g));
+					data.append(static_cast<char>(pixel.b));
+					data.append(static_cast<char>(pixel.a));
+				}
+			}
+
+			previous = pixel;
+		}
+	}
+
+	flushRun();
+
+	// End marker
+	data.append("\0\0\0\0\0\0\0\x01", 8);
+	return data;
+}
+
+} // namespace qs::wayland::screencopy
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+
+#include <qbytearray.h>
+#include <qimage.h>
+#include <qpointer.h>
+#include <qrect.h>
+#include <qrunnable.h>
+#include <qstring.h>
+#include <qtypes.h>
+
+#include "../buffer/manager.hpp"
+
+namespace qs::wayland::screencopy {
+
+class ScreencopyView;
+
+// Reads back, transforms, crops, encodes and writes a captured frame off the main thread.
+//
+// The buffer is retained from the swapchain, which keeps it from being captured into
+// until the writer releases it on the main thread.
+class ScreencopyFrameWriter: public QRunnable {
+public:
+	explicit ScreencopyFrameWriter(
+	    ScreencopyView* view,
+	    quint32 id,
+	    std::shared_ptr<buffer::WlBuffer> buffer,
+	    QRect region,
+	    QString path
+	);
+
+	void run() override;
+
+	// Applies a buffer transform, producing the image as it is displayed.
+	static QImage transformed(const QImage& image, buffer::WlBufferTransform transform);
+
+	// Encodes straight alpha RGBA pixels in the QOI format. See https://qoiformat.org.
+	static QByteArray encodeQoi(const QImage& image);
+
+private:
+	QString write();
+
+	QPointer<ScreencopyView> view;
+	quint32 id;
+	std::shared_ptr<buffer::WlBuffer> buffer;
+	QRect region;
+	QString path;
+};
+
+} // namespace qs::wayland::screencopy
@@ -4,6 +4,8 @@
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
+#include <qrect.h>
+#include <qregion.h>
 #include <qtmetamacros.h>
 #include <qwaylandclientextension.h>
 #include <wayland-hyprland-toplevel-export-v1-client-protocol.h>
@@ -65,6 +67,7 @@ void HyprlandScreencopyContext::captureFrame() {
 	if (this->object()) return;
 
 	this->request.reset();
+	this->damage = QRegion();
 
 	this->init(this->manager->capture_toplevel_with_wlr_toplevel_handle(
 	    this->paintCursors ? 1 : 0,
@@ -113,9 +116,24 @@ void HyprlandScreencopyContext::hyprland_toplevel_export_frame_v1_buffer_done()
 		return;
 	}
 
+	this->copiedWithDamage = this->copiedFirstFrame;
 	this->copy(backbuffer->buffer(), this->copiedFirstFrame ? 0 : 1);
 }
 
+void HyprlandScreencopyContext::hyprland_toplevel_export_frame_v1_damage(
+    uint32_t x,
+    uint32_t y,
+    uint32_t width,
+    uint32_t height
+) {
+	this->damage += QRect(
+	    static_cast<int>(x),
+	    static_cast<int>(y),
+	    static_cast<int>(width),
+	    static_cast<int>(height)
+	);
+}
+
 void HyprlandScreencopyContext::hyprland_toplevel_export_frame_v1_ready(
     uint32_t /*tvSecHi*/,
     uint32_t /*tvSecLo*/,
@@ -123,7 +141,10 @@ void HyprlandScreencopyContext::hyprland_toplevel_export_frame_v1_ready(
 ) {
 	this->destroy();
 	this->copiedFirstFrame = true;
-	this->mSwapchain.swapBuffers();
+
+	if (this->copiedWithDamage) this->mSwapchain.swapBuffers(this->damage);
+	else this->mSwapchain.swapBuffers();
+
 	emit this->frameCaptured();
 }
 
@@ -5,6 +5,7 @@
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qrect.h>
+#include <qregion.h>
 #include <qscreen.h>
 #include <qtmetamacros.h>
 #include <qwayland-ext-image-copy-capture-v1.h>
@@ -137,19 +138,16 @@ void IccScreencopyContext::doCapture() {
 		);
 
 		// We don't care about partial damage if the whole buffer was replaced.
-		this->lastDamage = QRect();
+		this->lastDamage = QRegion();
 	} else if (!this->lastDamage.isEmpty()) {
 		// If buffers were swapped between the last frame and the current one, request a repaint
 		// of the backbuffer in the same places that changes to the frontbuffer were recorded.
-		this->IccCaptureFrame::damage_buffer(
-		    this->lastDamage.x(),
-		    this->lastDamage.y(),
-		    this->lastDamage.width(),
-		    this->lastDamage.height()
-		);
+		for (const auto& rect: this->lastDamage) {
+			this->IccCaptureFrame::damage_buffer(rect.x(), rect.y(), rect.width(), rect.height());
+		}
 
 		// We don't need to do this more than once per buffer swap.
-		this->lastDamage = QRect();
+		this->lastDamage = QRegion();
 	}
 
 	this->IccCaptureFrame::capture();
@@ -165,15 +163,15 @@ void IccScreencopyContext::ext_image_copy_capture_frame_v1_damage(
     int32_t width,
     int32_t height
 ) {
-	this->damage = this->damage.united(QRect(x, y, width, height));
+	this->damage += QRect(x, y, width, height);
 }
 
 void IccScreencopyContext::ext_image_copy_capture_frame_v1_ready() {
 	this->IccCaptureFrame::destroy();
 
-	this->mSwapchain.swapBuffers();
+	this->mSwapchain.swapBuffers(this->damage);
 	this->lastDamage = this->damage;
-	this->damage = QRect();
+	this->damage = QRegion();
 
 	emit this->frameCaptured();
 }
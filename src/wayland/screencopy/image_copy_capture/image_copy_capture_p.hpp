@@ -2,7 +2,7 @@
 
 #include <cstdint>
 
-#include <qrect.h>
+#include <qregion.h>
 #include <qtclasshelpermacros.h>
 #include <qwayland-ext-image-copy-capture-v1.h>
 
@@ -44,8 +44,8 @@ private:
 	buffer::WlBufferRequest request;
 	bool statePending = true;
 	bool capturePending = false;
-	QRect damage;
-	QRect lastDamage;
+	QRegion damage;
+	QRegion lastDamage;
 };
 
 } // namespace qs::wayland::screencopy::icc
@@ -1,5 +1,6 @@
 #include "manager.hpp"
 
+#include <qhash.h>
 #include <qobject.h>
 
 #include "build.hpp"
@@ -23,6 +24,64 @@
 
 namespace qs::wayland::screencopy {
 
+ScreencopyContext::ScreencopyContext() {
+	QObject::connect(this, &ScreencopyContext::frameCaptured, this, [this]() {
+		this->mHasFrame = true;
+	});
+}
+
+QHash<ScreencopyManager::ContextKey, ScreencopyContext*>& ScreencopyManager::contexts() {
+	static auto contexts = QHash<ContextKey, ScreencopyContext*>();
+	return contexts;
+}
+
+ScreencopyContext*
+ScreencopyManager::acquireContext(QObject* object, bool paintCursors, bool shared) {
+	auto key = ContextKey {.source = object, .paintCursors = paintCursors};
+	auto* context = shared ? ScreencopyManager::contexts().value(key) : nullptr;
+
+	if (!context) {
+		context = ScreencopyManager::createContext(object, paintCursors);
+		if (!context) return nullptr;
+
+		if (shared) {
+			ScreencopyManager::contexts().insert(key, context);
+
+			auto forget = [key, context]() {
+				auto& contexts = ScreencopyManager::contexts();
+				if (contexts.value(key) == context) contexts.remove(key);
+			};
+
+			// A stopped context cannot be restarted, so new users get a new one while
+			// current users keep the stopped context until they release it.
+			QObject::connect(context, &ScreencopyContext::stopped, context, forget);
+
+			// Sources are keyed by address, which a new object may reuse once the source is destroyed.
+			QObject::connect(object, &QObject::destroyed, context, forget);
+		}
+	}
+
+	context->refcount++;
+	return context;
+}
+
+void ScreencopyManager::releaseContext(ScreencopyContext* context) {
+	if (!context) return;
+
+	context->refcount--;
+	if (context->refcount > 0) return;
+
+	auto& contexts = ScreencopyManager::contexts();
+	for (auto it = contexts.begin(); it != contexts.end(); ++it) {
+		if (it.value() == context) {
+			contexts.erase(it);
+			break;
+		}
+	}
+
+	delete context;
+}
+
 ScreencopyContext* ScreencopyManager::createContext(QObject* object, bool paintCursors) {
 	if (auto* screen = qobject_cast<QuickshellScreenInfo*>(object)) {
 #if SCREENCOPY_ICC
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <qhash.h>
 #include <qobject.h>
 #include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "../buffer/manager.hpp"
 
@@ -15,19 +17,50 @@ public:
 	[[nodiscard]] buffer::WlBufferSwapchain& swapchain() { return this->mSwapchain; }
 	virtual void captureFrame() = 0;
 
+	// True once a frame has been captured into the swapchain's frontbuffer.
+	[[nodiscard]] bool hasFrame() const { return this->mHasFrame; }
+
 signals:
 	void frameCaptured();
 	void stopped();
 
 protected:
-	ScreencopyContext() = default;
+	ScreencopyContext();
 
 	buffer::WlBufferSwapchain mSwapchain;
+
+private:
+	bool mHasFrame = false;
+	qsizetype refcount = 0;
+
+	friend class ScreencopyManager;
 };
 
+// Each user holds a reference to a context from acquireContext until releaseContext,
+// and the context is destroyed when the last reference is released.
+//
+// Shared contexts are reused by all users capturing the same source with the same options,
+// along with their capture stream and swapchain. As any user may capture new frames into
+// the swapchain, only users that always display the latest frame should share a context.
 class ScreencopyManager {
 public:
+	static ScreencopyContext* acquireContext(QObject* object, bool paintCursors, bool shared);
+	static void releaseContext(ScreencopyContext* context);
+
+private:
+	struct ContextKey {
+		QObject* source = nullptr;
+		bool paintCursors = false;
+
+		[[nodiscard]] bool operator==(const ContextKey& other) const = default;
+
+		friend size_t qHash(const ContextKey& key, size_t seed) noexcept {
+			return qHashMulti(seed, key.source, key.paintCursors);
+		}
+	};
+
 	static ScreencopyContext* createContext(QObject* object, bool paintCursors);
+	static QHash<ContextKey, ScreencopyContext*>& contexts();
 };
 
 } // namespace qs::wayland::screencopy
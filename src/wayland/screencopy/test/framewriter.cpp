@@ -0,0 +1,177 @@
+#include "framewriter.hpp"
+#include <array>
+#include <cstddef>
+
+#include <qbytearray.h>
+#include <qcolor.h>
+#include <qimage.h>
+#include <qrandom.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtypes.h>
+
+#include "../framewriter.hpp"
+
+using qs::wayland::screencopy::ScreencopyFrameWriter;
+
+namespace {
+
+using Pixel = std::array<quint8, 4>;
+
+quint32 readBigEndian(const QByteArray& data, qsizetype i) {
+	auto byte = [&](qsizetype j) { return static_cast<quint32>(static_cast<quint8>(data.at(j))); };
+	return byte(i) << 24 | byte(i + 1) << 16 | byte(i + 2) << 8 | byte(i + 3);
+}
+
+// Straightforward decoder written from the specification at https://qoiformat.org,
+// returning a null image if the data is malformed.
+QImage decodeQoi(const QByteArray& data) {
+	if (data.size() < 22 || !data.startsWith("qoif")) return QImage();
+	if (!data.endsWith(QByteArray("\0\0\0\0\0\0\0\x01", 8))) return QImage();
+
+	auto width = static_cast<int>(readBigEndian(data, 4));
+	auto height = static_cast<int>(readBigEndian(data, 8));
+	if (data.at(12) != 4) return QImage();
+
+	auto image = QImage(width, height, QImage::Format_RGBA8888);
+	auto index = std::array<Pixel, 64>();
+	auto pixel = Pixel {0, 0, 0, 255};
+	auto end = data.size() - 8;
+	qsizetype i = 14;
+	auto run = 0;
+
+	auto next = [&]() { return i < end ? static_cast<quint8>(data.at(i++)) : quint8(0); };
+	auto add = [](quint8 value, int delta) { return static_cast<quint8>(value + delta); };
+
+	for (auto y = 0; y != height; y++) {
+		auto* line = image.scanLine(y);
+
+		for (auto x = 0; x != width; x++) {
+			if (run > 0) {
+				run--;
+			} else {
+				if (i >= end) return QImage();
+				auto op = next();
+
+				if (op == 0xfe) {
+					pixel[0] = next();
+					pixel[1] = next();
+					pixel[2] = next();
+				} else if (op == 0xff) {
+					pixel[0] = next();
+					pixel[1] = next();
+					pixel[2] = next();
+					pixel[3] = next();
+				} else if ((op >> 6) == 0) {
+					pixel = index.at(op);
+				} else if ((op >> 6) == 1) {
+					pixel[0] = add(pixel[0], ((op >> 4) & 3) - 2);
+					pixel[1] = add(pixel[1], ((op >> 2) & 3) - 2);
+					pixel[2] = add(pixel[2], (op & 3) - 2);
+				} else if ((op >> 6) == 2) {
+					auto second = next();
+					auto dg = (op & 0x3f) - 32;
+					pixel[0] = add(pixel[0], dg - 8 + ((second >> 4) & 0xf));
+					pixel[1] = add(pixel[1], dg);
+					pixel[2] = add(pixel[2], dg - 8 + (second & 0xf));
+				} else {
+					run = op & 0x3f;
+				}
+
+				index.at((pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11) % 64) = pixel;
+			}
+
+			auto* p = line + static_cast<ptrdiff_t>(x) * 4; // NOLINT
+			p[0] = pixel[0];                                // NOLINT
+			p[1] = pixel[1];                                // NOLINT
+			p[2] = pixel[2];                                // NOLINT
+			p[3] = pixel[3];                                // NOLINT
+		}
+	}
+
+	// All data must be consumed.
+	if (i != end || run != 0) return QImage();
+	return image;
+}
+
+} // namespace
+
+void TestFrameWriter::qoiReference() {
+	// Encoded by hand from the specification, using each kind of chunk once.
+	auto image = QImage(7, 1, QImage::Format_RGBA8888);
+	image.setPixelColor(0, 0, QColor(0, 0, 0, 255));
+	image.setPixelColor(1, 0, QColor(0, 0, 0, 255));
+	image.setPixelColor(2, 0, QColor(1, 0, 255, 255));
+	image.setPixelColor(3, 0, QColor(11, 10, 8, 255));
+	image.setPixelColor(4, 0, QColor(200, 100, 50, 255));
+	image.setPixelColor(5, 0, QColor(200, 100, 50, 128));
+	image.setPixelColor(6, 0, QColor(1, 0, 255, 255));
+
+	auto expected = QByteArray("qoif\0\0\0\x07\0\0\0\x01\x04\0", 14);
+	expected += '\xc1';                                // run of the initial pixel, 2 long
+	expected += '\x79';                                // diff +1 +0 -1
+	expected += QByteArray("\xaa\x87", 2);             // luma +10, red +0, blue -1
+	expected += QByteArray("\xfe\xc8\x64\x32", 4);     // rgb
+	expected += QByteArray("\xff\xc8\x64\x32\x80", 5); // rgba
+	expected += '\x31';                                // index of the third pixel
+	expected += QByteArray("\0\0\0\0\0\0\0\x01", 8);
+
+	QCOMPARE(ScreencopyFrameWriter::encodeQoi(image), expected);
+}
+
+void TestFrameWriter::qoiRoundTrip_data() {
+	QTest::addColumn<QImage>("image");
+
+	auto solid = QImage(200, 3, QImage::Format_RGBA8888);
+	solid.fill(QColor(10, 20, 30, 255));
+	QTest::addRow("long runs") << solid;
+
+	auto gradient = QImage(97, 13, QImage::Format_RGBA8888);
+	for (auto y = 0; y != gradient.height(); y++) {
+		for (auto x = 0; x != gradient.width(); x++) {
+			gradient.setPixelColor(x, y, QColor(x * 2, (x + y) % 256, y * 19, 255));
+		}
+	}
+	QTest::addRow("gradient") << gradient;
+
+	auto random = QImage(61, 17, QImage::Format_RGBA8888);
+	auto rng = QRandomGenerator(1234); // NOLINT
+	auto palette = std::array<QColor, 4> {
+	    QColor(255, 0, 0, 255),
+	    QColor(0, 255, 0, 128),
+	    QColor(0, 0, 255, 0),
+	    QColor(20, 40, 60, 255),
+	};
+
+	for (auto y = 0; y != random.height(); y++) {
+		for (auto x = 0; x != random.width(); x++) {
+			auto value = rng.generate();
+
+			if (value % 3 == 0) {
+				random.setPixelColor(x, y, palette.at(value % palette.size()));
+			} else {
+				random.setPixel(x, y, rng.generate());
+			}
+		}
+	}
+	QTest::addRow("random") << random;
+
+	auto premultiplied = QImage(32, 32, QImage::Format_ARGB32_Premultiplied);
+	premultiplied.fill(QColor(255, 128, 0, 100));
+	QTest::addRow("premultiplied") << premultiplied;
+
+	QTest::addRow("empty") << QImage(0, 0, QImage::Format_RGBA8888);
+}
+
+void TestFrameWriter::qoiRoundTrip() {
+	QFETCH(QImage, image);
+
+	auto data = ScreencopyFrameWriter::encodeQoi(image);
+	auto decoded = decodeQoi(data);
+
+	QVERIFY(!decoded.isNull() || image.isNull());
+	QCOMPARE(decoded.size(), image.size());
+	QCOMPARE(decoded, image.convertToFormat(QImage::Format_RGBA8888));
+}
+
+QTEST_MAIN(TestFrameWriter);
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestFrameWriter: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void qoiReference();
+	static void qoiRoundTrip_data();
+	static void qoiRoundTrip();
+};
@@ -0,0 +1,102 @@
+// Frame time benchmark for live screencopy.
+//
+// Run under a headless compositor with a static source, for example:
+//   WLR_BACKENDS=headless WLR_LIBINPUT_NO_DEVICES=1 sway
+//   WAYLAND_DISPLAY=wayland-1 QS_DISABLE_DMABUF=1 quickshell -p frametime.qml
+//
+// QS_DISABLE_DMABUF forces the shm path, where texture uploads are limited to damage.
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import Quickshell
+import Quickshell.Wayland
+
+FloatingWindow {
+	color: contentItem.palette.window
+
+	property int frames: 0
+	property real totalTime: 0
+	property real maxTime: 0
+
+	function reset() {
+		frames = 0;
+		totalTime = 0;
+		maxTime = 0;
+	}
+
+	FrameAnimation {
+		running: true
+
+		onTriggered: {
+			frames += 1;
+			totalTime += frameTime;
+			maxTime = Math.max(maxTime, frameTime);
+		}
+	}
+
+	Timer {
+		running: true
+		repeat: true
+		interval: 5000
+
+		onTriggered: {
+			if (frames == 0) return;
+			console.log(`frames: ${frames}, avg: ${(totalTime / frames * 1000).toFixed(3)}ms, max: ${(maxTime * 1000).toFixed(3)}ms`);
+			reset();
+		}
+	}
+
+	ColumnLayout {
+		anchors.fill: parent
+
+		RowLayout {
+			Label { text: "Views" }
+
+			SpinBox {
+				id: viewsSb
+				from: 1
+				to: 16
+				value: 4
+			}
+
+			CheckBox {
+				id: liveCb
+				text: "Live"
+				checked: true
+			}
+
+			CheckBox {
+				id: animateCb
+				text: "Animate source"
+			}
+
+			Label {
+				text: frames == 0 ? "" : `avg ${(totalTime / frames * 1000).toFixed(3)}ms`
+			}
+		}
+
+		// Damages a small part of the screen each frame when enabled.
+		Rectangle {
+			width: 16
+			height: 16
+			color: animateCb.checked ? Qt.hsla((frames % 60) / 60, 1, 0.5, 1) : "black"
+		}
+
+		GridLayout {
+			Layout.fillWidth: true
+			Layout.fillHeight: true
+			columns: 4
+
+			Repeater {
+				model: viewsSb.value
+
+				ScreencopyView {
+					Layout.fillWidth: true
+					Layout.fillHeight: true
+					captureSource: Quickshell.screens[0]
+					live: liveCb.checked
+				}
+			}
+		}
+	}
+}
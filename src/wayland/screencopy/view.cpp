@@ -1,14 +1,21 @@
 #include "view.hpp"
+#include <utility>
 
+#include <qjsvalue.h>
 #include <qnamespace.h>
 #include <qobject.h>
 #include <qqmlinfo.h>
 #include <qquickitem.h>
+#include <qrect.h>
 #include <qsize.h>
+#include <qstring.h>
+#include <qthreadpool.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "../buffer/manager.hpp"
 #include "../buffer/qsg.hpp"
+#include "framewriter.hpp"
 #include "manager.hpp"
 
 namespace qs::wayland::screencopy {
@@ -30,6 +37,11 @@ ScreencopyView::ScreencopyView(QQuickItem* parent): QQuickItem(parent) {
 	});
 }
 
+ScreencopyView::~ScreencopyView() {
+	if (this->context) ScreencopyManager::releaseContext(this->context);
+	if (this->previousContext) ScreencopyManager::releaseContext(this->previousContext);
+}
+
 void ScreencopyView::setCaptureSource(QObject* captureSource) {
 	if (captureSource == this->mCaptureSource) return;
 	auto hadContext = this->context != nullptr;
@@ -66,26 +78,33 @@ void ScreencopyView::setPaintCursors(bool paintCursors) {
 
 void ScreencopyView::setLive(bool live) {
 	if (live == this->mLive) return;
+	this->mLive = live;
 
-	if (live && !this->mLive && this->context) {
-		this->context->captureFrame();
-	}
+	// Live views share their context, which still views cannot do without their frame
+	// being replaced by captures from other views.
+	if (this->completed && this->context) this->createContext(true);
 
-	this->mLive = live;
 	emit this->liveChanged();
 }
 
-void ScreencopyView::createContext() {
-	this->destroyContext(false);
-	this->context = ScreencopyManager::createContext(this->mCaptureSource, this->mPaintCursors);
+void ScreencopyView::createContext(bool keepFrame) {
+	if (keepFrame && this->context && this->bHasContent) {
+		this->releasePreviousContext();
+		QObject::disconnect(this->context, nullptr, this, nullptr);
+		this->previousContext = std::exchange(this->context, nullptr);
+	} else {
+		this->destroyContext(false);
+	}
+
+	this->context =
+	    ScreencopyManager::acquireContext(this->mCaptureSource, this->mPaintCursors, this->mLive);
 
 	if (!this->context) {
 		qmlWarning(this) << "Capture source set to non captureable object.";
+		this->destroyContext();
 		return;
 	}
 
-	this->context->setParent(this);
-
 	QObject::connect(
 	    this->context,
 	    &ScreencopyContext::stopped,
@@ -100,24 +119,91 @@ void ScreencopyView::createContext() {
 	    &ScreencopyView::onFrameCaptured
 	);
 
+	// A shared context may already have a frame to display.
+	if (this->context->hasFrame()) this->onFrameCaptured();
+
 	this->context->captureFrame();
 }
 
 void ScreencopyView::destroyContext(bool update) {
-	auto hadContext = this->context != nullptr;
-	delete this->context;
-	this->context = nullptr;
+	auto hadContext = this->context != nullptr || this->previousContext != nullptr;
+
+	if (this->context) {
+		QObject::disconnect(this->context, nullptr, this, nullptr);
+		ScreencopyManager::releaseContext(this->context);
+		this->context = nullptr;
+	}
+
+	this->releasePreviousContext();
+
 	this->bHasContent = false;
 	this->bSourceSize = QSize();
 	if (hadContext && update) this->update();
 }
 
+void ScreencopyView::releasePreviousContext() {
+	if (!this->previousContext) return;
+	ScreencopyManager::releaseContext(this->previousContext);
+	this->previousContext = nullptr;
+}
+
+ScreencopyContext* ScreencopyView::displayedContext() const {
+	if (this->previousContext && !(this->context && this->context->hasFrame())) {
+		return this->previousContext;
+	}
+
+	return this->context;
+}
+
 void ScreencopyView::captureFrame() {
 	if (this->context) this->context->captureFrame();
 	else qmlWarning(this) << "Cannot capture frame, as no recording context is ready.";
 }
 
+void ScreencopyView::saveFrame(const QString& path, const QJSValue& callback, QRectF region) {
+	// Retaining the buffer keeps the next capture from reusing it while it is read back.
+	auto* displayed = this->displayedContext();
+	auto frontbuffer =
+	    displayed && this->bHasContent ? displayed->swapchain().retainFrontbuffer() : nullptr;
+
+	auto fail = [&](const QString& error) {
+		qmlWarning(this) << "Could not save frame to " << path << ": " << error;
+		if (callback.isCallable()) callback.call({QJSValue(error)});
+	};
+
+	if (!frontbuffer) {
+		fail(QStringLiteral("No frame has been captured."));
+		return;
+	}
+
+	auto id = ++this->saveSerial;
+	if (callback.isCallable()) this->pendingSaves.insert(id, callback);
+
+	QThreadPool::globalInstance()->start(new ScreencopyFrameWriter(
+	    this,
+	    id,
+	    std::move(frontbuffer),
+	    region.toAlignedRect(),
+	    path
+	));
+}
+
+void ScreencopyView::onFrameSaved(quint32 id, const QString& error) {
+	auto callback = this->pendingSaves.take(id);
+
+	if (!error.isEmpty()) {
+		qmlWarning(this) << "Could not save frame: " << error;
+	}
+
+	if (callback.isCallable()) {
+		callback.call({error.isEmpty() ? QJSValue(QJSValue::NullValue) : QJSValue(error)});
+	}
+}
+
 void ScreencopyView::onFrameCaptured() {
+	// The new context's frame replaces the one kept from the previous context.
+	this->releasePreviousContext();
+
 	this->setFlag(QQuickItem::ItemHasContents);
 	this->update();
 
@@ -152,23 +238,33 @@ void ScreencopyView::onBuffersReady() {
 }
 
 QSGNode* ScreencopyView::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* /*unused*/) {
-	if (!this->context || !this->bHasContent) {
+	auto* displayed = this->displayedContext();
+
+	if (!displayed || !this->bHasContent) {
 		delete oldNode;
+		this->nodeSwapchain = nullptr;
 		this->setFlag(QQuickItem::ItemHasContents, false);
 		return nullptr;
 	}
 
 	auto* node = static_cast<buffer::WlBufferQSGDisplayNode*>(oldNode); // NOLINT
+	auto& swapchain = displayed->swapchain();
+
+	// Textures are tracked by buffer and serial, which are only meaningful within one swapchain.
+	if (node && this->nodeSwapchain != &swapchain) {
+		delete node;
+		node = nullptr;
+	}
 
 	if (!node) {
 		node = new buffer::WlBufferQSGDisplayNode(this->window());
+		this->nodeSwapchain = &swapchain;
 	}
 
-	auto& swapchain = this->context->swapchain();
 	node->syncSwapchain(swapchain);
 	node->setRect(this->boundingRect());
 
-	if (this->mLive) this->context->captureFrame();
+	if (this->mLive && this->context) this->context->captureFrame();
 	return node;
 }
 
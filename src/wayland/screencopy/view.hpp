@@ -1,11 +1,16 @@
 #pragma once
 
+#include <qhash.h>
+#include <qjsvalue.h>
 #include <qobject.h>
 #include <qproperty.h>
 #include <qqmlintegration.h>
 #include <qquickitem.h>
+#include <qrect.h>
 #include <qsgnode.h>
+#include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "manager.hpp"
 
@@ -30,6 +35,10 @@ class ScreencopyView: public QQuickItem {
 	Q_PROPERTY(bool paintCursor READ paintCursors WRITE setPaintCursors NOTIFY paintCursorsChanged);
 	/// If true, a live video feed from the capture source will be displayed instead of a still image.
 	/// Defaults to false.
+	///
+	/// Live views of the same capture source with the same @@paintCursor setting share
+	/// a single capture stream and its buffers. Changing this property keeps the current frame
+	/// displayed until a frame has been captured with the new setting.
 	Q_PROPERTY(bool live READ live WRITE setLive NOTIFY liveChanged);
 	/// If true, the view has content ready to display. Content is not always immediately available,
 	/// and this property can be used to avoid displaying it until ready.
@@ -43,12 +52,36 @@ class ScreencopyView: public QQuickItem {
 
 public:
 	explicit ScreencopyView(QQuickItem* parent = nullptr);
+	~ScreencopyView() override;
+	Q_DISABLE_COPY_MOVE(ScreencopyView);
 
 	void componentComplete() override;
 
 	/// Capture a single frame. Has no effect if @@live is true.
 	Q_INVOKABLE void captureFrame();
 
+	/// Saves the displayed frame to a file without blocking the UI, which is much faster
+	/// than `grabToImage` as the frame is read directly from the capture buffer.
+	///
+	/// The file format is chosen by the extension of `path`:
+	/// - `.qoi` - [QOI](https://qoiformat.org), which encodes much faster than PNG.
+	/// - `.raw` - Uncompressed 8 bit RGBA pixels, row by row, with no header.
+	/// - Any other image format supported by Qt, such as `.png` or `.jpg`.
+	///
+	/// If `region` is given, only that part of the frame is saved. It is in the
+	/// coordinates of @@sourceSize.
+	///
+	/// Once the file is written, `callback` is called with `null`, or with an error message
+	/// if the frame could not be saved.
+	///
+	/// ```qml
+	/// view.saveFrame("/tmp/screenshot.png", error => {
+	///   if (error) console.log(`Screenshot failed: ${error}`);
+	/// });
+	/// ```
+	Q_INVOKABLE void
+	saveFrame(const QString& path, const QJSValue& callback = QJSValue(), QRectF region = QRectF());
+
 	[[nodiscard]] QObject* captureSource() const { return this->mCaptureSource; }
 	void setCaptureSource(QObject* captureSource);
 
@@ -83,8 +116,13 @@ private slots:
 	void onBuffersReady();
 
 private:
+	void onFrameSaved(quint32 id, const QString& error);
 	void destroyContext(bool update = true);
-	void createContext();
+	// If keepFrame is set, the current frame stays displayed until the new context has one.
+	void createContext(bool keepFrame = false);
+	void releasePreviousContext();
+	// The context whose frame is displayed, which may be the previous one.
+	[[nodiscard]] ScreencopyContext* displayedContext() const;
 	void updateImplicitSize();
 
 	// clang-format off
@@ -98,7 +136,15 @@ private:
 	bool mPaintCursors = false;
 	bool mLive = false;
 	ScreencopyContext* context = nullptr;
+	// Replaced context, held while its frame is displayed.
+	ScreencopyContext* previousContext = nullptr;
+	// Swapchain the paint node was created for.
+	const buffer::WlBufferSwapchain* nodeSwapchain = nullptr;
 	bool completed = false;
+	quint32 saveSerial = 0;
+	QHash<quint32, QJSValue> pendingSaves;
+
+	friend class ScreencopyFrameWriter;
 };
 
 } // namespace qs::wayland::screencopy
@@ -6,6 +6,8 @@
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
+#include <qrect.h>
+#include <qregion.h>
 #include <qscreen.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
@@ -66,6 +68,7 @@ void WlrScreencopyContext::captureFrame() {
 	if (this->object()) return;
 
 	this->request.reset();
+	this->damage = QRegion();
 
 	if (this->region.isEmpty()) {
 		this->init(this->manager->capture_output(this->paintCursors ? 1 : 0, this->screen->output()));
@@ -120,6 +123,8 @@ void WlrScreencopyContext::zwlr_screencopy_frame_v1_buffer_done() {
 		return;
 	}
 
+	this->copiedWithDamage = this->copiedFirstFrame;
+
 	if (this->copiedFirstFrame) {
 		this->copy_with_damage(backbuffer->buffer());
 	} else {
@@ -127,6 +132,20 @@ void WlrScreencopyContext::zwlr_screencopy_frame_v1_buffer_done() {
 	}
 }
 
+void WlrScreencopyContext::zwlr_screencopy_frame_v1_damage(
+    uint32_t x,
+    uint32_t y,
+    uint32_t width,
+    uint32_t height
+) {
+	this->damage += QRect(
+	    static_cast<int>(x),
+	    static_cast<int>(y),
+	    static_cast<int>(width),
+	    static_cast<int>(height)
+	);
+}
+
 void WlrScreencopyContext::zwlr_screencopy_frame_v1_ready(
     uint32_t /*tvSecHi*/,
     uint32_t /*tvSecLo*/,
@@ -154,7 +173,12 @@ void WlrScreencopyContext::submitFrame() {
 	this->mSwapchain.backbuffer()->transform = this->transform.transform ^ flipTransform;
 
 	this->destroy();
-	this->mSwapchain.swapBuffers();
+
+	// The whole frame is copied either way, but damage is only reported relative to
+	// a previous copy_with_damage.
+	if (this->copiedWithDamage) this->mSwapchain.swapBuffers(this->damage);
+	else this->mSwapchain.swapBuffers();
+
 	emit this->frameCaptured();
 }
 
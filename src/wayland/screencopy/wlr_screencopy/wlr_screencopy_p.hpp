@@ -3,6 +3,7 @@
 #include <private/qwayland-wayland.h>
 #include <private/qwaylandscreen_p.h>
 #include <qcontainerfwd.h>
+#include <qregion.h>
 #include <qtclasshelpermacros.h>
 #include <qtypes.h>
 #include <qwayland-wlr-screencopy-unstable-v1.h>
@@ -35,6 +36,7 @@ protected:
 	void zwlr_screencopy_frame_v1_linux_dmabuf(uint32_t format, uint32_t width, uint32_t height) override;
 	void zwlr_screencopy_frame_v1_flags(uint32_t flags) override;
 	void zwlr_screencopy_frame_v1_buffer_done() override;
+	void zwlr_screencopy_frame_v1_damage(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
 	void zwlr_screencopy_frame_v1_ready(uint32_t tvSecHi, uint32_t tvSecLo, uint32_t tvNsec) override;
 	void zwlr_screencopy_frame_v1_failed() override;
 	// clang-format on
@@ -73,6 +75,8 @@ private:
 	WlrScreencopyManager* manager;
 	buffer::WlBufferRequest request;
 	bool copiedFirstFrame = false;
+	bool copiedWithDamage = false;
+	QRegion damage;
 	OutputTransformQuery transform {this};
 	bool yInvert = false;
 
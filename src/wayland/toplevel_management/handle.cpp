@@ -12,6 +12,7 @@
 #include <qloggingcategory.h>
 #include <qobject.h>
 #include <qscreen.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 #include <wayland-util.h>
 
@@ -21,6 +22,11 @@
 
 namespace qs::wayland::toplevel_management::impl {
 
+ToplevelHandle::ToplevelHandle() {
+	this->titleTimer.setSingleShot(true);
+	QObject::connect(&this->titleTimer, &QTimer::timeout, this, &ToplevelHandle::onTitleTimeout);
+}
+
 QString ToplevelHandle::appId() const { return this->mAppId; }
 QString ToplevelHandle::title() const { return this->mTitle; }
 ToplevelHandle* ToplevelHandle::parent() const { return this->mParent; }
@@ -111,11 +117,67 @@ void ToplevelHandle::zwlr_foreign_toplevel_handle_v1_done() {
 	auto wasReady = this->isReady;
 	this->isReady = true;
 
+	this->applyPending();
+
 	if (!wasReady) {
 		emit this->ready();
 	}
 }
 
+void ToplevelHandle::applyPending() {
+	const auto& pending = this->pending;
+
+	auto appIdChanged = pending.appId != this->mAppId;
+	auto activatedChanged = pending.activated != this->mActivated;
+	auto maximizedChanged = pending.maximized != this->mMaximized;
+	auto minimizedChanged = pending.minimized != this->mMinimized;
+	auto fullscreenChanged = pending.fullscreen != this->mFullscreen;
+	auto titleChanged = false;
+
+	this->mAppId = pending.appId;
+	this->mActivated = pending.activated;
+	this->mMaximized = pending.maximized;
+	this->mMinimized = pending.minimized;
+	this->mFullscreen = pending.fullscreen;
+
+	if (this->titleTimer.isActive()) {
+		this->throttledTitle = pending.title;
+		this->titleThrottled = true;
+	} else if (pending.title != this->mTitle) {
+		this->mTitle = pending.title;
+		titleChanged = true;
+
+		auto interval = ToplevelManager::instance()->titleUpdateInterval();
+		if (interval > 0) this->titleTimer.start(interval);
+	}
+
+	// Applied after all state so handlers see the complete update.
+	if (this->parentPending) {
+		this->parentPending = false;
+		this->applyParent(this->pendingParent);
+	}
+
+	if (appIdChanged) emit this->appIdChanged();
+	if (titleChanged) emit this->titleChanged();
+	if (activatedChanged) emit this->activatedChanged();
+	if (maximizedChanged) emit this->maximizedChanged();
+	if (minimizedChanged) emit this->minimizedChanged();
+	if (fullscreenChanged) emit this->fullscreenChanged();
+}
+
+void ToplevelHandle::onTitleTimeout() {
+	if (!this->titleThrottled) return;
+	this->titleThrottled = false;
+
+	if (this->throttledTitle == this->mTitle) return;
+	this->mTitle = this->throttledTitle;
+
+	auto interval = ToplevelManager::instance()->titleUpdateInterval();
+	if (interval > 0) this->titleTimer.start(interval);
+
+	emit this->titleChanged();
+}
+
 void ToplevelHandle::zwlr_foreign_toplevel_handle_v1_closed() {
 	qCDebug(logToplevelManagement) << this << "closed";
 	this->destroy();
@@ -125,14 +187,12 @@ void ToplevelHandle::zwlr_foreign_toplevel_handle_v1_closed() {
 
 void ToplevelHandle::zwlr_foreign_toplevel_handle_v1_app_id(const QString& appId) {
 	qCDebug(logToplevelManagement) << this << "got appid" << appId;
-	this->mAppId = appId;
-	emit this->appIdChanged();
+	this->pending.appId = appId;
 }
 
 void ToplevelHandle::zwlr_foreign_toplevel_handle_v1_title(const QString& title) {
 	qCDebug(logToplevelManagement) << this << "got toplevel" << title;
-	this->mTitle = title;
-	emit this->titleChanged();
+	this->pending.title = title;
 }
 
 void ToplevelHandle::zwlr_foreign_toplevel_handle_v1_state(wl_array* stateArray) {
@@ -158,25 +218,10 @@ void ToplevelHandle::zwlr_foreign_toplevel_handle_v1_state(wl_array* stateArray)
 	                               << "maximized:" << maximized << "minimized:" << minimized
 	                               << "fullscreen:" << fullscreen;
 
-	if (activated != this->mActivated) {
-		this->mActivated = activated;
-		emit this->activatedChanged();
-	}
-
-	if (maximized != this->mMaximized) {
-		this->mMaximized = maximized;
-		emit this->maximizedChanged();
-	}
-
-	if (minimized != this->mMinimized) {
-		this->mMinimized = minimized;
-		emit this->minimizedChanged();
-	}
-
-	if (fullscreen != this->mFullscreen) {
-		this->mFullscreen = fullscreen;
-		emit this->fullscreenChanged();
-	}
+	this->pending.activated = activated;
+	this->pending.maximized = maximized;
+	this->pending.minimized = minimized;
+	this->pending.fullscreen = fullscreen;
 }
 
 void ToplevelHandle::zwlr_foreign_toplevel_handle_v1_output_enter(wl_output* output) {
@@ -195,6 +240,12 @@ void ToplevelHandle::zwlr_foreign_toplevel_handle_v1_parent(
 	auto* handle = ToplevelManager::instance()->handleFor(parent);
 	qCDebug(logToplevelManagement) << this << "got parent" << handle;
 
+	// Tracked weakly as the parent may close before done.
+	this->pendingParent = handle;
+	this->parentPending = true;
+}
+
+void ToplevelHandle::applyParent(ToplevelHandle* handle) {
 	if (handle != this->mParent) {
 		if (this->mParent != nullptr) {
 			QObject::disconnect(this->mParent, nullptr, this, nullptr);
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <qobject.h>
+#include <qpointer.h>
 #include <qscreen.h>
+#include <qstring.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 #include <qwayland-wlr-foreign-toplevel-management-unstable-v1.h>
 #include <qwindow.h>
@@ -11,12 +14,16 @@
 
 namespace qs::wayland::toplevel_management::impl {
 
+// Protocol events are double-buffered and applied together on done, only emitting
+// signals for properties that changed. Output enter and leave are applied immediately.
 class ToplevelHandle
     : public QObject
     , public QtWayland::zwlr_foreign_toplevel_handle_v1 {
 	Q_OBJECT;
 
 public:
+	explicit ToplevelHandle();
+
 	[[nodiscard]] QString appId() const;
 	[[nodiscard]] QString title() const;
 	[[nodiscard]] ToplevelHandle* parent() const;
@@ -51,8 +58,21 @@ signals:
 private slots:
 	void onParentClosed();
 	void onRectWindowDestroyed();
+	void onTitleTimeout();
 
 private:
+	struct State {
+		QString appId;
+		QString title;
+		bool activated = false;
+		bool maximized = false;
+		bool minimized = false;
+		bool fullscreen = false;
+	};
+
+	void applyPending();
+	void applyParent(ToplevelHandle* parent);
+
 	void zwlr_foreign_toplevel_handle_v1_done() override;
 	void zwlr_foreign_toplevel_handle_v1_closed() override;
 	void zwlr_foreign_toplevel_handle_v1_app_id(const QString& appId) override;
@@ -63,6 +83,14 @@ private:
 	void zwlr_foreign_toplevel_handle_v1_parent(::zwlr_foreign_toplevel_handle_v1* parent) override;
 
 	bool isReady = false;
+	State pending;
+	QPointer<ToplevelHandle> pendingParent;
+	bool parentPending = false;
+	// Committed title held back by ToplevelManager::titleUpdateInterval.
+	QString throttledTitle;
+	bool titleThrottled = false;
+	QTimer titleTimer;
+
 	QString mAppId;
 	QString mTitle;
 	ToplevelHandle* mParent = nullptr;
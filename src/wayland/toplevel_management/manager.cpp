@@ -5,6 +5,7 @@
 #include <qloggingcategory.h>
 #include <qobject.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 #include <qwaylandclientextension.h>
 
 #include "../../core/logcat.hpp"
@@ -33,6 +34,12 @@ ToplevelHandle* ToplevelManager::handleFor(::zwlr_foreign_toplevel_handle_v1* to
 	return nullptr;
 }
 
+void ToplevelManager::setTitleUpdateInterval(qint32 interval) {
+	if (interval == this->mTitleUpdateInterval) return;
+	this->mTitleUpdateInterval = interval;
+	emit this->titleUpdateIntervalChanged();
+}
+
 ToplevelManager* ToplevelManager::instance() {
 	static auto* instance = new ToplevelManager(); // NOLINT
 	return instance;
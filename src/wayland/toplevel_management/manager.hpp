@@ -3,6 +3,7 @@
 #include <qcontainerfwd.h>
 #include <qloggingcategory.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 #include <qwayland-wlr-foreign-toplevel-management-unstable-v1.h>
 #include <qwaylandclientextension.h>
 
@@ -25,10 +26,15 @@ public:
 	[[nodiscard]] const QVector<ToplevelHandle*>& readyToplevels() const;
 	[[nodiscard]] ToplevelHandle* handleFor(::zwlr_foreign_toplevel_handle_v1* toplevel);
 
+	// Minimum time between title changes of each toplevel in ms, or 0 to apply every change.
+	[[nodiscard]] qint32 titleUpdateInterval() const { return this->mTitleUpdateInterval; }
+	void setTitleUpdateInterval(qint32 interval);
+
 	static ToplevelManager* instance();
 
 signals:
 	void toplevelReady(ToplevelHandle* toplevel);
+	void titleUpdateIntervalChanged();
 
 protected:
 	explicit ToplevelManager();
@@ -43,6 +49,7 @@ private slots:
 private:
 	QVector<ToplevelHandle*> mToplevels;
 	QVector<ToplevelHandle*> mReadyToplevels;
+	qint32 mTitleUpdateInterval = 0;
 };
 
 } // namespace qs::wayland::toplevel_management::impl
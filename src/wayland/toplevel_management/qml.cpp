@@ -3,6 +3,7 @@
 #include <qlist.h>
 #include <qobject.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "../../core/model.hpp"
 #include "../../core/qmlglobal.hpp"
@@ -184,6 +185,13 @@ ToplevelManagerQml::ToplevelManagerQml(QObject* parent): QObject(parent) {
 	    this,
 	    &ToplevelManagerQml::activeToplevelChanged
 	);
+
+	QObject::connect(
+	    impl::ToplevelManager::instance(),
+	    &impl::ToplevelManager::titleUpdateIntervalChanged,
+	    this,
+	    &ToplevelManagerQml::titleUpdateIntervalChanged
+	);
 }
 
 ObjectModel<Toplevel>* ToplevelManagerQml::toplevels() {
@@ -194,4 +202,12 @@ Toplevel* ToplevelManagerQml::activeToplevel() {
 	return ToplevelManager::instance()->activeToplevel();
 }
 
+qint32 ToplevelManagerQml::titleUpdateInterval() {
+	return impl::ToplevelManager::instance()->titleUpdateInterval();
+}
+
+void ToplevelManagerQml::setTitleUpdateInterval(qint32 interval) {
+	impl::ToplevelManager::instance()->setTitleUpdateInterval(interval);
+}
+
 } // namespace qs::wayland::toplevel_management
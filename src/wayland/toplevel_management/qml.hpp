@@ -4,6 +4,7 @@
 #include <qobject.h>
 #include <qqmlintegration.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "../../core/doc.hpp"
 #include "../../core/model.hpp"
@@ -165,6 +166,14 @@ class ToplevelManagerQml: public QObject {
 	/// > [!INFO] If multiple are active, this will be the most recently activated one.
 	/// > Usually compositors will not report more than one toplevel as active at a time.
 	Q_PROPERTY(qs::wayland::toplevel_management::Toplevel* activeToplevel READ activeToplevel NOTIFY activeToplevelChanged);
+	/// Minimum time in milliseconds between changes to the @@Toplevel.title of each toplevel.
+	/// Defaults to 0, which applies every change.
+	///
+	/// Some applications, such as terminals showing the running command or browsers
+	/// with animated tab titles, change their title many times per second. A taskbar
+	/// showing many windows may set this to avoid reevaluating bindings for every change.
+	/// The latest title is always applied once the interval passes.
+	Q_PROPERTY(qint32 titleUpdateInterval READ titleUpdateInterval WRITE setTitleUpdateInterval NOTIFY titleUpdateIntervalChanged);
 	// clang-format on
 	QML_NAMED_ELEMENT(ToplevelManager);
 	QML_SINGLETON;
@@ -175,8 +184,12 @@ public:
 	[[nodiscard]] static ObjectModel<Toplevel>* toplevels();
 	[[nodiscard]] static Toplevel* activeToplevel();
 
+	[[nodiscard]] static qint32 titleUpdateInterval();
+	static void setTitleUpdateInterval(qint32 interval);
+
 signals:
 	void activeToplevelChanged();
+	void titleUpdateIntervalChanged();
 };
 
 } // namespace qs::wayland::toplevel_management
@@ -5,6 +5,7 @@
 #include <qcoreevent.h>
 #include <qevent.h>
 #include <qguiapplication.h>
+#include <qlatin1stringview.h>
 #include <qlogging.h>
 #include <qnamespace.h>
 #include <qobject.h>
@@ -16,6 +17,8 @@
 #include <qquickitem.h>
 #include <qquickwindow.h>
 #include <qregion.h>
+#include <qscreen.h>
+#include <qstring.h>
 #include <qsurfaceformat.h>
 #include <qtenvironmentvariables.h>
 #include <qtmetamacros.h>
@@ -28,9 +31,27 @@
 #include "../core/qmlscreen.hpp"
 #include "../core/region.hpp"
 #include "../core/reload.hpp"
+#include "../core/startuptrace.hpp"
 #include "../debug/lint.hpp"
 #include "windowinterface.hpp"
 
+namespace {
+
+QString startupTraceName(ProxyWindowBase* proxy, QQuickWindow* window) {
+	auto* context = QQmlEngine::contextForObject(proxy);
+	auto file = context ? context->baseUrl().fileName() : QString();
+	auto* screen = window->screen();
+
+	return QString("%1 (%2) on %3")
+	    .arg(
+	        QLatin1StringView(proxy->metaObject()->className()),
+	        file,
+	        screen ? screen->name() : QStringLiteral("no screen")
+	    );
+}
+
+} // namespace
+
 ProxyWindowBase::ProxyWindowBase(QObject* parent)
     : Reloadable(parent)
     , mContentItem(new ProxyWindowContentItem()) {
@@ -291,6 +312,10 @@ void ProxyWindowBase::setVisibleDirect(bool visible) {
 		this->window->setVisible(visible);
 		emit this->backerVisibilityChanged();
 	}
+
+	if (visible && this->window != nullptr && StartupTrace::isTracing()) {
+		StartupTrace::trackWindow(this->window, startupTraceName(this, this->window));
+	}
 }
 
 void ProxyWindowBase::schedulePolish() {